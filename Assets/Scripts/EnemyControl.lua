@@ -69,17 +69,17 @@ function FireWeapon(self)
 			return entity:GetPosition().y > G.screenHeight + entity:GetHeight()
 		end
 		
-		local missileLeft = Toolset2D:CreateSprite(default, kMissileTexture)
+		local missileLeft = Toolset2D:AcquireSprite(default, kMissileTexture)
 		missileLeft:SetScaling(kMissileScale)
 		missileLeft:SetCenterPosition(offset1)
 		missileLeft:SetCollision(false)
-		G.AddSprite(missileLeft, kMissileVelocity, removeFunc)
+		G.AddSprite(missileLeft, kMissileVelocity, removeFunc, true)
 		
-		local missileRight = Toolset2D:CreateSprite(default, kMissileTexture)
+		local missileRight = Toolset2D:AcquireSprite(default, kMissileTexture)
 		missileRight:SetScaling(kMissileScale)
 		missileRight:SetCenterPosition(offset2)	
 		missileRight:SetCollision(false)
-		G.AddSprite(missileRight, kMissileVelocity, removeFunc)
+		G.AddSprite(missileRight, kMissileVelocity, removeFunc, true)
 		
 		self.missileFireTimer = kMissileFireTimer
 	else
@@ -130,10 +130,16 @@ function OnThink(self)
 
 	self.roll = math.clamp(self.roll, -1, 1)
 
+	-- Look the states up once, they only exist once the sprite sheet has been loaded
+	if (self.rollLeftState or -1) == -1 then
+		self.rollLeftState = self:GetStateId("rollLeft")
+		self.rollRightState = self:GetStateId("rollRight")
+	end
+
 	if self.roll < 0 then
-		self:SetState("rollLeft")
+		self:SetStateById(self.rollLeftState)
 	else
-		self:SetState("rollRight")
+		self:SetStateById(self.rollRightState)
 	end
 		
 	self:SetFramePercent(math.abs(self.roll))
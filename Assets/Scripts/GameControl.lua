@@ -7,6 +7,11 @@ kEnemyScale = 0.6
 kEnemySpawnTimeRangeStart = 0.7
 kEnemySpawnTimeRangeEnd = 1.2
 
+-- Collision layers, sprites only collide if each one's layer is in the other one's mask
+kCollisionLayerDefault = 1
+kCollisionLayerPlayerMissile = 2
+kCollisionLayerEnemy = 4
+
 --== Event handlers
 
 function UpdateSpawnTimer(self)
@@ -29,6 +34,19 @@ function OnAfterSceneLoaded(self)
 		G.GetNumSprites = GetNumSprites
 		G.RemoveAllSprites = RemoveAllSprites
 
+		G.kCollisionLayerDefault = kCollisionLayerDefault
+		G.kCollisionLayerPlayerMissile = kCollisionLayerPlayerMissile
+		G.kCollisionLayerEnemy = kCollisionLayerEnemy
+
+		-- Pack the loose missile and crate textures together so they can share draw calls
+		Toolset2D:SetTextureAtlasEnabled(true)
+
+		-- Sheets that are only needed once the game is running are read in the background
+		Toolset2D:SetAsyncLoadingEnabled(true)
+		Toolset2D:PreloadSpriteSheet("Textures/SpriteSheets/EnemyShipV2.png", "Textures/SpriteSheets/EnemyShipV2.xml")
+		Toolset2D:PreloadSpriteSheet("Textures/SpriteSheets/Explosion_v1.png", "Textures/SpriteSheets/Explosion_v1.xml")
+		Toolset2D:PreloadSpriteSheet("Textures/SpriteSheets/Explosion_v2.png", "Textures/SpriteSheets/Explosion_v2.xml")
+
 		math.clamp = function(n, low, high)
 			return math.min(math.max(n, low), high)
 		end
@@ -37,6 +55,12 @@ function OnAfterSceneLoaded(self)
 	end
 end
 
+function OnSpriteSheetLoaded(spriteSheetFilename, xmlDataFilename, success)
+	if not success then
+		Debug:PrintLine("Failed to load " .. spriteSheetFilename)
+	end
+end
+
 function OnBeforeSceneUnloaded()
 	G.RemoveAllSprites()	
 end
@@ -52,6 +76,10 @@ function OnThink(self)
 		
 		enemy:SetScaling(kEnemyScale)
 		enemy:SetOrientation(0, 0, 180)
+
+		-- Enemies only need to know about the player and the player's missiles
+		enemy:SetCollisionLayer(kCollisionLayerEnemy)
+		enemy:SetCollisionMask(kCollisionLayerDefault + kCollisionLayerPlayerMissile)
 		
 		local default = Vision.hkvVec3(
 			enemy:GetWidth() / 2.0 + Util:GetRandInt(G.screenWidth - enemy:GetWidth()),
@@ -80,13 +108,15 @@ end
 
 --== Utility functions for managing sprites
 
-function AddSprite(sprite, velocity, removeFunc)
+-- Pooled sprites came from Toolset2D:AcquireSprite and are released instead of removed
+function AddSprite(sprite, velocity, removeFunc, pooled)
 	local spriteEntry = {}
 
 	spriteEntry.entity = sprite
 	spriteEntry.removeFunc = removeFunc
 	spriteEntry.remove = false
 	spriteEntry.velocity = velocity
+	spriteEntry.pooled = pooled
 	
 	table.insert(G.sprites, spriteEntry)
 end
@@ -144,7 +174,11 @@ function UpdateSprites()
 	for _, spriteToDelete in ipairs(toDelete) do
 		for index, sprite in ipairs(G.sprites) do
 			if sprite == spriteToDelete then
-				sprite.entity:Remove()
+				if sprite.pooled then
+					Toolset2D:ReleaseSprite(sprite.entity)
+				else
+					sprite.entity:Remove()
+				end
 				table.remove(G.sprites, index)
 				break
 			end
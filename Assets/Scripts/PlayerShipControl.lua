@@ -51,6 +51,9 @@ function OnAfterSceneLoaded(self)
 	self.roll = 0
 	self.missileFireTimer = 0
 	self.zoom = 0
+
+	-- Missiles are fired constantly, so keep a few around instead of creating new ones
+	Toolset2D:PrewarmSpritePool(self.MissileTexture, "", 32)
 end
 
 function OnBeforeSceneUnloaded(self)
@@ -111,11 +114,17 @@ function OnThink(self)
 		end
 	end
 	
-	-- Set the current state by which direction we're going
+	-- Set the current state by which direction we're going. The states are looked up once
+	-- the sprite sheet has been loaded.
+	if (self.rollLeftState or -1) == -1 then
+		self.rollLeftState = self:GetStateId("rollLeft")
+		self.rollRightState = self:GetStateId("rollRight")
+	end
+
 	if self.roll < 0 then
-		self:SetState("rollLeft")
+		self:SetStateById(self.rollLeftState)
 	else
-		self:SetState("rollRight")
+		self:SetStateById(self.rollRightState)
 	end
  
 	self:SetFramePercent(math.abs(self.roll))
@@ -156,13 +165,19 @@ function FireWeapon(self)
 			return entity:GetPosition().y < -entity:GetHeight()
 		end
 		
-		local missileLeft = Toolset2D:CreateSprite(offset1, self.MissileTexture)
+		local missileLeft = Toolset2D:AcquireSprite(offset1, self.MissileTexture)
 		missileLeft:SetScaling(self.MissileScale)
-		G.AddSprite(missileLeft, missileVelocity, removeFunc)
+		missileLeft:SetCollisionLayer(G.kCollisionLayerPlayerMissile)
+		missileLeft:SetCollisionMask(G.kCollisionLayerEnemy)
+		missileLeft:SetContinuousCollision(true)
+		G.AddSprite(missileLeft, missileVelocity, removeFunc, true)
 		
-		local missileRight = Toolset2D:CreateSprite(offset2, self.MissileTexture)
+		local missileRight = Toolset2D:AcquireSprite(offset2, self.MissileTexture)
 		missileRight:SetScaling(self.MissileScale)
-		G.AddSprite(missileRight, missileVelocity, removeFunc)
+		missileRight:SetCollisionLayer(G.kCollisionLayerPlayerMissile)
+		missileRight:SetCollisionMask(G.kCollisionLayerEnemy)
+		missileRight:SetContinuousCollision(true)
+		G.AddSprite(missileRight, missileVelocity, removeFunc, true)
 		
 		self.missileFireTimer = self.MissileFireTimer
 	else
@@ -0,0 +1,336 @@
+#! /usr/bin/python
+
+"""
+hullbaker.py - Computes the collision hull of every cell in a sprite sheet from the alpha of
+               the source image, so the runtime never has to read the texture back. The
+               same alpha also gives the masks used for pixel perfect collision. Only uses
+               the standard library, PNG and TGA images are decoded here.
+
+               Hull vertices are in pixels, centered on the cell with y pointing down, which
+               is what SpriteData::GenerateConvexHull expects.
+"""
+
+import os
+import struct
+import zlib
+
+# Pixels with an alpha below this are treated as empty, same as the runtime fallback
+ALPHA_THRESHOLD = 10
+
+# Hull vertices closer than this to the line through their neighbours are dropped
+DEFAULT_TOLERANCE = 1.0
+
+# Upper limit for the number of vertices of one hull, zero means no limit
+DEFAULT_MAX_VERTICES = 16
+
+PNG_SIGNATURE = b'\x89PNG\r\n\x1a\n'
+
+class AlphaImage(object):
+    """Alpha channel of an image, one byte per pixel with row 0 at the top"""
+    def __init__(self, width, height, alpha):
+        self.width = width
+        self.height = height
+        self.alpha = alpha
+
+    def row(self, y):
+        return self.alpha[y * self.width:(y + 1) * self.width]
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa = abs(p - a)
+    pb = abs(p - b)
+    pc = abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    if pb <= pc:
+        return b
+    return c
+
+def _unfilter_png(data, width, height, bytes_per_pixel, row_size):
+    rows = []
+    previous = bytearray(row_size)
+    position = 0
+
+    for _ in range(height):
+        filter_type = data[position]
+        row = bytearray(data[position + 1:position + 1 + row_size])
+        position += row_size + 1
+
+        if filter_type == 1:
+            for i in range(bytes_per_pixel, row_size):
+                row[i] = (row[i] + row[i - bytes_per_pixel]) & 0xff
+        elif filter_type == 2:
+            for i in range(row_size):
+                row[i] = (row[i] + previous[i]) & 0xff
+        elif filter_type == 3:
+            for i in range(row_size):
+                left = row[i - bytes_per_pixel] if i >= bytes_per_pixel else 0
+                row[i] = (row[i] + ((left + previous[i]) >> 1)) & 0xff
+        elif filter_type == 4:
+            for i in range(row_size):
+                if i >= bytes_per_pixel:
+                    predictor = _paeth(row[i - bytes_per_pixel], previous[i], previous[i - bytes_per_pixel])
+                else:
+                    predictor = previous[i]
+                row[i] = (row[i] + predictor) & 0xff
+        elif filter_type != 0:
+            raise ValueError("unknown PNG filter %d" % filter_type)
+
+        rows.append(row)
+        previous = row
+
+    return rows
+
+def read_png(filename):
+    with open(filename, 'rb') as image_file:
+        data = image_file.read()
+
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError("not a PNG file")
+
+    header = None
+    palette_alpha = None
+    compressed = bytearray()
+
+    position = 8
+    while position + 8 <= len(data):
+        length, chunk_type = struct.unpack('>I4s', data[position:position + 8])
+        chunk = data[position + 8:position + 8 + length]
+        position += length + 12
+
+        if chunk_type == b'IHDR':
+            header = struct.unpack('>IIBBBBB', chunk)
+        elif chunk_type == b'tRNS':
+            palette_alpha = bytearray(chunk)
+        elif chunk_type == b'IDAT':
+            compressed += chunk
+        elif chunk_type == b'IEND':
+            break
+
+    if header is None:
+        raise ValueError("PNG file has no header")
+
+    width, height, bit_depth, color_type, _, _, interlace = header
+    if interlace != 0:
+        raise ValueError("interlaced PNG files are not supported")
+    if bit_depth not in (8, 16):
+        raise ValueError("PNG files with %d bits per channel are not supported" % bit_depth)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color_type)
+    if channels is None or (color_type == 3 and bit_depth != 8):
+        raise ValueError("unsupported PNG color type %d" % color_type)
+
+    sample_size = bit_depth // 8
+    bytes_per_pixel = channels * sample_size
+    rows = _unfilter_png(bytearray(zlib.decompress(bytes(compressed))),
+                         width, height, bytes_per_pixel, width * bytes_per_pixel)
+
+    alpha = bytearray(width * height)
+    if color_type in (4, 6):
+        # Alpha is the last channel, take the high byte of 16-bit samples
+        offset = (channels - 1) * sample_size
+        for y, row in enumerate(rows):
+            alpha[y * width:(y + 1) * width] = row[offset::bytes_per_pixel]
+    elif color_type == 3:
+        lookup = bytearray(256)
+        for index in range(256):
+            lookup[index] = palette_alpha[index] if (palette_alpha is not None and index < len(palette_alpha)) else 255
+        for y, row in enumerate(rows):
+            alpha[y * width:(y + 1) * width] = row.translate(bytes(lookup))
+    else:
+        # No alpha, treat anything that isn't black as solid like the runtime does
+        for y, row in enumerate(rows):
+            for x in range(width):
+                pixel = row[x * bytes_per_pixel:(x + 1) * bytes_per_pixel:sample_size]
+                alpha[y * width + x] = min(sum(pixel), 255)
+
+    return AlphaImage(width, height, alpha)
+
+def read_tga(filename):
+    with open(filename, 'rb') as image_file:
+        data = bytearray(image_file.read())
+
+    if len(data) < 18:
+        raise ValueError("not a TGA file")
+
+    id_length = data[0]
+    color_map_type = data[1]
+    image_type = data[2]
+    width, height = struct.unpack('<HH', bytes(data[12:16]))
+    bits_per_pixel = data[16]
+    descriptor = data[17]
+
+    if color_map_type != 0 or image_type not in (2, 3, 10, 11):
+        raise ValueError("unsupported TGA image type %d" % image_type)
+    if bits_per_pixel not in (8, 24, 32):
+        raise ValueError("TGA files with %d bits per pixel are not supported" % bits_per_pixel)
+
+    bytes_per_pixel = bits_per_pixel // 8
+    num_pixels = width * height
+    position = 18 + id_length
+
+    if image_type in (10, 11):
+        pixels = bytearray()
+        while len(pixels) < num_pixels * bytes_per_pixel:
+            packet = data[position]
+            position += 1
+            count = (packet & 0x7f) + 1
+            if packet & 0x80:
+                pixels += data[position:position + bytes_per_pixel] * count
+                position += bytes_per_pixel
+            else:
+                pixels += data[position:position + count * bytes_per_pixel]
+                position += count * bytes_per_pixel
+    else:
+        pixels = data[position:position + num_pixels * bytes_per_pixel]
+
+    if len(pixels) < num_pixels * bytes_per_pixel:
+        raise ValueError("TGA file is truncated")
+
+    if bytes_per_pixel == 4:
+        alpha = pixels[3::4][:num_pixels]
+    else:
+        alpha = bytearray(num_pixels)
+        for index in range(num_pixels):
+            pixel = pixels[index * bytes_per_pixel:(index + 1) * bytes_per_pixel]
+            alpha[index] = min(sum(pixel), 255)
+
+    # Rows are stored bottom up unless bit 5 of the descriptor is set
+    if not descriptor & 0x20:
+        flipped = bytearray()
+        for y in range(height - 1, -1, -1):
+            flipped += alpha[y * width:(y + 1) * width]
+        alpha = flipped
+
+    return AlphaImage(width, height, alpha)
+
+def read_image(filename):
+    extension = os.path.splitext(filename)[1].lower()
+    if extension == '.png':
+        return read_png(filename)
+    if extension == '.tga':
+        return read_tga(filename)
+    raise ValueError("unsupported image %s" % os.path.basename(filename))
+
+def _cross(origin, a, b):
+    return (a[0] - origin[0]) * (b[1] - origin[1]) - (a[1] - origin[1]) * (b[0] - origin[0])
+
+def convex_hull(points):
+    """Monotone chain, returns the hull without collinear points"""
+    points = sorted(set(points))
+    if len(points) < 3:
+        return points
+
+    lower = []
+    for point in points:
+        while len(lower) >= 2 and _cross(lower[-2], lower[-1], point) <= 0:
+            lower.pop()
+        lower.append(point)
+
+    upper = []
+    for point in reversed(points):
+        while len(upper) >= 2 and _cross(upper[-2], upper[-1], point) <= 0:
+            upper.pop()
+        upper.append(point)
+
+    return lower[:-1] + upper[:-1]
+
+def _distance_to_neighbours(hull, index):
+    previous = hull[index - 1]
+    point = hull[index]
+    following = hull[(index + 1) % len(hull)]
+
+    dx = following[0] - previous[0]
+    dy = following[1] - previous[1]
+    length = (dx * dx + dy * dy) ** 0.5
+    if length == 0.0:
+        return 0.0
+    return abs(_cross(previous, following, point)) / length
+
+def simplify_hull(hull, tolerance, max_vertices):
+    """Drops the vertices that contribute least to the shape until every remaining one is
+    further than 'tolerance' from the line through its neighbours and there are at most
+    'max_vertices' left. Removing a vertex of a convex polygon keeps it convex."""
+    hull = list(hull)
+    while len(hull) > 3:
+        distances = [_distance_to_neighbours(hull, index) for index in range(len(hull))]
+        smallest = min(range(len(hull)), key=lambda index: distances[index])
+
+        too_many = (max_vertices > 0 and len(hull) > max_vertices)
+        if distances[smallest] >= tolerance and not too_many:
+            break
+
+        del hull[smallest]
+
+    return hull
+
+def bake_cell(image, x, y, width, height, tolerance=DEFAULT_TOLERANCE,
+              max_vertices=DEFAULT_MAX_VERTICES, threshold=ALPHA_THRESHOLD):
+    """Returns the hull of the cell at (x, y) as a list of (x, y) tuples, empty if the cell
+    has no opaque pixels"""
+    x = max(0, min(int(x), image.width))
+    y = max(0, min(int(y), image.height))
+    end_x = max(x, min(x + int(width), image.width))
+    end_y = max(y, min(y + int(height), image.height))
+
+    half_width = float(int(width)) / 2.0
+    half_height = float(int(height)) / 2.0
+
+    # Every row contributes the outer corners of its opaque span
+    points = []
+    for row_y in range(y, end_y):
+        row = image.row(row_y)[x:end_x]
+        first = -1
+        last = -1
+        for column, alpha in enumerate(row):
+            if alpha >= threshold:
+                if first == -1:
+                    first = column
+                last = column
+
+        if first != -1:
+            top = row_y - y
+            points.append((first, top))
+            points.append((last + 1, top))
+            points.append((first, top + 1))
+            points.append((last + 1, top + 1))
+
+    hull = convex_hull(points)
+    if len(hull) < 3:
+        return []
+
+    hull = simplify_hull(hull, tolerance, max_vertices)
+    return [(float(px) - half_width, float(py) - half_height) for px, py in hull]
+
+def bake_mask(image, x, y, width, height, threshold=ALPHA_THRESHOLD):
+    """Returns the alpha mask of the cell at (x, y) as a list of 32-bit words, one bit per
+    pixel set where the alpha reaches the threshold. Rows are padded to 64 pixels and pixel
+    x of a row is bit (x % 32) of word (x / 32), the layout SpriteSheetBinary2D expects.
+    Pixels outside of the image are empty."""
+    width = int(width)
+    height = int(height)
+    words_per_row = (width + 63) // 64 * 2
+    x = int(x)
+    y = int(y)
+
+    words = []
+    for row_y in range(y, y + height):
+        row_words = [0] * words_per_row
+        if 0 <= row_y < image.height:
+            row = image.row(row_y)
+            for column in range(max(0, -x), min(width, image.width - x)):
+                if row[x + column] >= threshold:
+                    row_words[column // 32] |= 1 << (column % 32)
+        words += row_words
+
+    return words
+
+def bake_sheet(image, cells, tolerance=DEFAULT_TOLERANCE, max_vertices=DEFAULT_MAX_VERTICES,
+               hulls=True, masks=False):
+    """Fills in cell['hull'] and cell['mask'] for cells as read by spritesheetbin.read_xml"""
+    for cell in cells:
+        if hulls:
+            cell['hull'] = bake_cell(image, cell['x'], cell['y'], cell['width'], cell['height'],
+                                     tolerance, max_vertices)
+        if masks:
+            cell['mask'] = bake_mask(image, cell['x'], cell['y'], cell['width'], cell['height'])
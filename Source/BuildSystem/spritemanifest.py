@@ -0,0 +1,175 @@
+#! /usr/bin/python
+
+"""
+spritemanifest.py - Writes the list of sprite sheets used by the sprites in an exported scene
+                    into a manifest next to it, so the runtime can start loading all of them in
+                    the background as soon as the scene starts loading. The manifest of
+                    Scenes/Shooter.*.vscene is Scenes/Shooter.spritesheets.xml and lists the
+                    sheets of all platforms the scene was exported for.
+
+                    Pass in exported scenes or folders. With no arguments every scene in
+                    Assets/Scenes is processed.
+"""
+
+import sys
+import os
+import struct
+import xml.etree.ElementTree as ElementTree
+
+from optparse import OptionParser
+
+# Must match Toolset2dManager::GetSpriteSheetManifestFilename
+MANIFEST_EXTENSION = '.spritesheets.xml'
+
+SCENE_EXTENSION = '.vscene'
+IMAGE_EXTENSIONS = ('.png', '.tga', '.dds', '.bmp', '.jpg')
+DATA_EXTENSION = '.xml'
+
+# Longest path the runtime reads back, see Sprite::Serialize
+MAX_PATH_LENGTH = 260
+
+COMMAND_LINE_OPTIONS = (
+    (('-q', '--quiet',),
+     {'action': 'store_false',
+      'dest': 'verbose',
+      'default': True,
+      'help': "Don't print out status updates"}),)
+
+def read_string(data, position):
+    """Reads a string as written by VArchive::WriteStringBinary, a 32-bit length followed by
+    the characters. Returns the string and the position after it, or None if there is no
+    plausible string at that position."""
+    if position + 4 > len(data):
+        return None, position
+
+    length = struct.unpack('<i', data[position:position + 4])[0]
+    position += 4
+
+    # NULL strings are written with a negative length
+    if length <= 0:
+        return '', position
+    if length > MAX_PATH_LENGTH or position + length > len(data):
+        return None, position
+
+    text = data[position:position + length]
+    if any(character < 32 or character > 126 for character in bytearray(text)):
+        return None, position
+
+    return text.decode('ascii'), position + length
+
+def find_sprite_sheets(scene_filename):
+    """Sprites are serialized with their sheet followed by their XML. The scene is not parsed,
+    instead every image path is checked for an XML path (or nothing) right behind it."""
+    with open(scene_filename, 'rb') as scene_file:
+        data = scene_file.read()
+
+    lowered = data.lower()
+    sheets = []
+    for extension in IMAGE_EXTENSIONS:
+        search = 0
+        while True:
+            end = lowered.find(extension.encode('ascii'), search)
+            if end == -1:
+                break
+            search = end + 1
+            end += len(extension)
+
+            # Walk back to the length in front of the path
+            for length in range(len(extension) + 1, min(end, MAX_PATH_LENGTH) + 1):
+                start = end - length
+                if start < 4:
+                    break
+
+                image, position = read_string(data, start - 4)
+                if image is None or len(image) != length:
+                    continue
+
+                xml_data, _ = read_string(data, position)
+                if xml_data is not None and (xml_data == '' or xml_data.lower().endswith(DATA_EXTENSION)):
+                    # Kept as they are, the runtime compares the names exactly
+                    sheet = (image, xml_data)
+                    if sheet not in sheets:
+                        sheets.append(sheet)
+                break
+
+    return sheets
+
+def get_manifest_filename(scene_filename):
+    """Shooter.pcdx9.vscene and Shooter.android.vscene share Shooter.spritesheets.xml"""
+    directory, filename = os.path.split(scene_filename)
+    return os.path.join(directory, filename.split('.')[0] + MANIFEST_EXTENSION)
+
+def write_manifest(sheets, manifest_filename):
+    root = ElementTree.Element('SpriteSheets')
+    for sprite_sheet, xml_data in sheets:
+        node = ElementTree.SubElement(root, 'SpriteSheet')
+        node.set('spriteSheetFilename', sprite_sheet)
+        node.set('xmlDataFilename', xml_data)
+
+    text = ElementTree.tostring(root)
+    if not isinstance(text, str):
+        text = text.decode('utf-8')
+    text = text.replace('><', '>\n<').replace('\n<SpriteSheet ', '\n\t<SpriteSheet ')
+
+    with open(manifest_filename, 'w') as manifest_file:
+        manifest_file.write(text + '\n')
+
+def update(scene_files, verbose):
+    manifests = {}
+    for scene_file in scene_files:
+        manifests.setdefault(get_manifest_filename(scene_file), []).append(scene_file)
+
+    success = True
+    for manifest_filename in sorted(manifests.keys()):
+        sheets = []
+        try:
+            for scene_file in sorted(manifests[manifest_filename]):
+                for sheet in find_sprite_sheets(scene_file):
+                    if sheet not in sheets:
+                        sheets.append(sheet)
+            write_manifest(sorted(sheets), manifest_filename)
+        except Exception as error:
+            print("Failed to write %s: %s" % (os.path.basename(manifest_filename), error))
+            success = False
+            continue
+
+        if verbose:
+            print("Updated: %s (%d sprite sheets)" % (os.path.basename(manifest_filename), len(sheets)))
+
+    return success
+
+def main():
+    success = False
+    options = tuple()
+    arguments = []
+
+    try:
+        parser = OptionParser('%prog [options] [scene files or folders]')
+        for option in COMMAND_LINE_OPTIONS:
+            parser.add_option(*option[0], **option[1])
+        (options, arguments) = parser.parse_args()
+    except:
+        print("Parser error")
+
+    project_directory = os.path.dirname(os.path.realpath(__file__))
+    project_directory = os.path.abspath(os.path.join(project_directory, '../../'))
+
+    if len(arguments) == 0:
+        arguments = [os.path.join(project_directory, 'Assets', 'Scenes')]
+
+    scene_files = []
+    for arg in arguments:
+        if os.path.isdir(arg):
+            for filename in sorted(os.listdir(arg)):
+                if filename.lower().endswith(SCENE_EXTENSION):
+                    scene_files.append(os.path.join(arg, filename))
+        elif os.path.exists(arg):
+            scene_files.append(arg)
+
+    success = update(scene_files, options.verbose)
+
+    return success
+
+if __name__ == "__main__":
+    SUCCESS = main()
+    sys.exit(0 if SUCCESS else 1)
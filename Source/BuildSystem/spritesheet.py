@@ -20,6 +20,8 @@ import shutil
 import subprocess
 import time
 
+import spritesheetbin
+
 from optparse import OptionParser
 
 COMMAND_LINE_OPTIONS = (
@@ -112,6 +114,9 @@ def process(shoebox, project_directory, spritesheet_output_directory, files):
             except:
                 print("Failed to update: %s" % os.path.basename(output_file))
 
+    # Precompile the new sheet so the runtime doesn't have to parse the XML
+    spritesheetbin.convert_file(os.path.join(spritesheet_output_directory, '%s.xml' % sheetname), True)
+
     return
 
 def convert(options):
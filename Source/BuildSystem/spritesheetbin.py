@@ -0,0 +1,285 @@
+#! /usr/bin/python
+
+"""
+spritesheetbin.py - Converts the XML written by spritesheet.py (ShoeBox) into the precompiled
+                    binary sprite sheet format that the runtime loads without any parsing. The
+                    binary file is written next to the XML with a .sheet extension.
+
+                    Collision hulls are baked from the sheet image with hullbaker.py unless
+                    --no-hulls is passed, so the runtime doesn't have to read the texture.
+                    Alpha masks for pixel perfect collision are only baked with --masks,
+                    they take one bit per pixel of every cell.
+
+                    Pass in XML files or folders. With no arguments every sheet in
+                    Assets/Textures/SpriteSheets is converted.
+"""
+
+import sys
+import os
+import struct
+import xml.etree.ElementTree as ElementTree
+
+import hullbaker
+
+from optparse import OptionParser
+
+# Must match Core/SpriteSheetBinary2d.hpp
+SHEET_MAGIC = 0x42443253
+SHEET_VERSION = 3
+SHEET_EXTENSION = '.sheet'
+
+HEADER_FORMAT = '<IIffIIIIII'
+CELL_FORMAT = '<ffffffffiIIIfIII'
+STATE_FORMAT = '<IfII'
+VERTEX_FORMAT = '<ff'
+
+# Same defaults the runtime uses when it reads the XML
+SINGLE_FRAME_FRAMERATE = 30.0
+ANIMATION_FRAMERATE = 10.0
+
+COMMAND_LINE_OPTIONS = (
+    (('--no-hulls',),
+     {'action': 'store_false',
+      'dest': 'hulls',
+      'default': True,
+      'help': "Don't bake collision hulls from the sheet image"}),
+    (('--masks',),
+     {'action': 'store_true',
+      'dest': 'masks',
+      'default': False,
+      'help': "Bake alpha masks for pixel perfect collision from the sheet image"}),
+    (('-t', '--tolerance',),
+     {'action': 'store',
+      'type': 'float',
+      'dest': 'tolerance',
+      'default': hullbaker.DEFAULT_TOLERANCE,
+      'help': "Hull vertices closer than this many pixels to their neighbours' edge are dropped"}),
+    (('-m', '--max-vertices',),
+     {'action': 'store',
+      'type': 'int',
+      'dest': 'max_vertices',
+      'default': hullbaker.DEFAULT_MAX_VERTICES,
+      'help': "Maximum number of vertices per hull, 0 for no limit"}),
+    (('-q', '--quiet',),
+     {'action': 'store_false',
+      'dest': 'verbose',
+      'default': True,
+      'help': "Don't print out status updates"}),)
+
+class StringTable(object):
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, text):
+        if text not in self.offsets:
+            self.offsets[text] = len(self.data)
+            self.data += text.encode('utf-8') + b'\0'
+        return self.offsets[text]
+
+def parse_cell_name(name):
+    """Splits 'walk_003.png' into ('walk', 3) the same way the runtime does. Names without an
+    underscore are a state of their own with a single frame."""
+    underscore = name.rfind('_')
+    if underscore == -1:
+        dot = name.rfind('.')
+        return (name if dot == -1 else name[:dot]), None
+
+    number = name[underscore + 1:]
+    dot = number.find('.')
+    if dot != -1:
+        number = number[:dot]
+
+    try:
+        index = int(number)
+    except ValueError:
+        index = 0
+
+    return name[:underscore], index
+
+def hull_vertices(cell):
+    """Baked hull of a cell, empty if there is none"""
+    return cell.get('hull', [])
+
+def mask_words(cell):
+    """Baked alpha mask of a cell as 32-bit words, empty if there is none"""
+    return cell.get('mask', [])
+
+def read_xml(xml_filename):
+    root = ElementTree.parse(xml_filename).getroot()
+
+    sheet = {
+        'image_path': root.get('imagePath', ''),
+        'width': float(root.get('width', 0)),
+        'height': float(root.get('height', 0)),
+        'cells': [],
+        'states': []}
+
+    states = {}
+
+    for node in root.findall('SubTexture'):
+        name = node.get('name', '')
+
+        cell = {
+            'name': name,
+            'x': float(node.get('x', 0)),
+            'y': float(node.get('y', 0)),
+            'ox': float(node.get('ox', 0)),
+            'oy': float(node.get('oy', 0)),
+            'width': float(node.get('width', 0)),
+            'height': float(node.get('height', 0)),
+            'original_width': float(node.get('original_width', 0)),
+            'original_height': float(node.get('original_height', 0)),
+            'duration': float(node.get('duration', 0)),
+            'index': 0}
+
+        cell_index = len(sheet['cells'])
+        sheet['cells'].append(cell)
+
+        state_name, frame = parse_cell_name(name)
+        if frame is None:
+            state = {'name': state_name, 'framerate': SINGLE_FRAME_FRAMERATE, 'cells': []}
+            sheet['states'].append(state)
+        else:
+            cell['index'] = frame
+            state = states.get(state_name)
+            if state is None:
+                state = {'name': state_name, 'framerate': ANIMATION_FRAMERATE, 'cells': []}
+                states[state_name] = state
+                sheet['states'].append(state)
+
+        state['cells'].append(cell_index)
+
+    return sheet
+
+def write_binary(sheet, binary_filename):
+    strings = StringTable()
+    cells = bytearray()
+    states = bytearray()
+    state_cells = bytearray()
+    vertices = bytearray()
+    masks = bytearray()
+
+    num_state_cells = 0
+    num_vertices = 0
+    num_mask_words = 0
+
+    for cell in sheet['cells']:
+        hull = hull_vertices(cell)
+        mask = mask_words(cell)
+        mask_width = int(cell['width']) if mask else 0
+        mask_height = int(cell['height']) if mask else 0
+        cells += struct.pack(CELL_FORMAT,
+                             cell['x'], cell['y'], cell['ox'], cell['oy'],
+                             cell['width'], cell['height'],
+                             cell['original_width'], cell['original_height'],
+                             cell['index'], strings.add(cell['name']),
+                             num_vertices, len(hull), cell['duration'],
+                             mask_width, mask_height, num_mask_words)
+        for x, y in hull:
+            vertices += struct.pack(VERTEX_FORMAT, x, y)
+        num_vertices += len(hull)
+        masks += struct.pack('<%dI' % len(mask), *mask)
+        num_mask_words += len(mask)
+
+    for state in sheet['states']:
+        states += struct.pack(STATE_FORMAT,
+                              strings.add(state['name']), state['framerate'],
+                              num_state_cells, len(state['cells']))
+        for cell_index in state['cells']:
+            state_cells += struct.pack('<I', cell_index)
+        num_state_cells += len(state['cells'])
+
+    # Keep the file size a multiple of four
+    while len(strings.data) % 4 != 0:
+        strings.data += b'\0'
+
+    header = struct.pack(HEADER_FORMAT,
+                         SHEET_MAGIC, SHEET_VERSION,
+                         sheet['width'], sheet['height'],
+                         len(sheet['cells']), len(sheet['states']),
+                         num_state_cells, num_vertices, num_mask_words, len(strings.data))
+
+    with open(binary_filename, 'wb') as binary_file:
+        binary_file.write(header)
+        binary_file.write(cells)
+        binary_file.write(states)
+        binary_file.write(state_cells)
+        binary_file.write(vertices)
+        binary_file.write(masks)
+        binary_file.write(strings.data)
+
+def bake_collision(sheet, xml_filename, tolerance, max_vertices, hulls, masks):
+    """Hulls and masks are baked from the image the XML points at, which lives next to the XML"""
+    if not sheet['image_path']:
+        raise ValueError("no imagePath to bake the collision from")
+
+    image_filename = os.path.join(os.path.dirname(xml_filename), sheet['image_path'])
+    image = hullbaker.read_image(image_filename)
+    hullbaker.bake_sheet(image, sheet['cells'], tolerance, max_vertices, hulls, masks)
+
+def convert_file(xml_filename, verbose, hulls=True,
+                 tolerance=hullbaker.DEFAULT_TOLERANCE,
+                 max_vertices=hullbaker.DEFAULT_MAX_VERTICES,
+                 masks=False):
+    binary_filename = os.path.splitext(xml_filename)[0] + SHEET_EXTENSION
+
+    try:
+        sheet = read_xml(xml_filename)
+        if hulls or masks:
+            bake_collision(sheet, xml_filename, tolerance, max_vertices, hulls, masks)
+        write_binary(sheet, binary_filename)
+    except Exception as error:
+        print("Failed to convert %s: %s" % (os.path.basename(xml_filename), error))
+        return False
+
+    if verbose:
+        print("Updated: %s" % os.path.basename(binary_filename))
+
+    return True
+
+def convert(options, arguments):
+    success = True
+
+    project_directory = os.path.dirname(os.path.realpath(__file__))
+    project_directory = os.path.abspath(os.path.join(project_directory, '../../'))
+
+    if len(arguments) == 0:
+        arguments = [os.path.join(project_directory, 'Assets', 'Textures', 'SpriteSheets')]
+
+    xml_files = []
+    for arg in arguments:
+        if os.path.isdir(arg):
+            for filename in sorted(os.listdir(arg)):
+                if filename.lower().endswith('.xml'):
+                    xml_files.append(os.path.join(arg, filename))
+        elif os.path.exists(arg):
+            xml_files.append(arg)
+
+    for xml_file in xml_files:
+        success = convert_file(xml_file, options.verbose, options.hulls,
+                               options.tolerance, options.max_vertices,
+                               options.masks) and success
+
+    return success
+
+def main():
+    success = False
+    options = tuple()
+    arguments = []
+
+    try:
+        parser = OptionParser('%prog [options] [xml files or folders]')
+        for option in COMMAND_LINE_OPTIONS:
+            parser.add_option(*option[0], **option[1])
+        (options, arguments) = parser.parse_args()
+    except:
+        print("Parser error")
+
+    success = convert(options, arguments)
+
+    return success
+
+if __name__ == "__main__":
+    SUCCESS = main()
+    sys.exit(0 if SUCCESS else 1)
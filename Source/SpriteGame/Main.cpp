@@ -22,6 +22,11 @@ VIMPORT IVisPlugin_cl* GetEnginePlugin_vFmodEnginePlugin();
 VIMPORT IVisPlugin_cl* GetEnginePlugin_vHavok();
 VIMPORT IVisPlugin_cl* GetEnginePlugin_Toolset2D_EnginePlugin();
 
+VIMPORT float Toolset2D_GetSpriteSheetLoadProgress();
+VIMPORT int Toolset2D_GetNumPendingSpriteSheets();
+VIMPORT bool Toolset2D_StartStatsCsv(const char *filename);
+VIMPORT void Toolset2D_StopStatsCsv();
+
 class SpriteApp : public VAppImpl
 {
 public:
@@ -97,6 +102,13 @@ void SpriteApp::Init()
 	VisAppLoadSettings settings("Scenes/Shooter.vscene");
 	settings.m_customSearchPaths.Append(":template_root/Assets");
 	LoadScene(settings);
+
+	// Performance runs set this to get the frame stats of the whole session as a CSV file
+	const char *statsCsv = getenv("TOOLSET2D_STATS_CSV");
+	if (statsCsv != NULL && statsCsv[0] != '\0')
+	{
+		Toolset2D_StartStatsCsv(statsCsv);
+	}
 }
 
 //---------------------------------------------------------------------------------------------------------
@@ -122,11 +134,21 @@ void SpriteApp::AfterSceneLoaded(bool bLoadingSuccessful)
 //---------------------------------------------------------------------------------------------------------
 bool SpriteApp::Run()
 {
-  return true;
+	// The loading screen only follows the scene itself, the sprite sheets from the scene's
+	// manifest may still be loading in the background once it is gone
+	if (Toolset2D_GetNumPendingSpriteSheets() > 0)
+	{
+		const int percent = static_cast<int>(Toolset2D_GetSpriteSheetLoadProgress() * 100.0f);
+		Vision::Message.Print(1, 10, 10, "Loading sprite sheets... %d%%", percent);
+	}
+
+	return true;
 }
 
 void SpriteApp::DeInit()
 {
+	Toolset2D_StopStatsCsv();
+
   // De-Initialization
   // [...]
 }
@@ -136,6 +136,8 @@ namespace Toolset2D
                 EngineNode.SetCurrentState(m_state);
                 EngineNode.SetPlayOnce(m_playOnce);
                 EngineNode.SetCollision(m_collision);
+                EngineNode.SetCollisionLayer(m_collisionLayer);
+                EngineNode.SetCollisionMask(m_collisionMask);
 
                 if (m_width != 0.0)
                 {
@@ -155,6 +157,8 @@ namespace Toolset2D
                 Orientation = orientation;
 
                 EngineNode.SetConvexHullCollision(m_convexHullCollision);
+                EngineNode.SetPixelCollision(m_pixelCollision);
+                EngineNode.SetContinuousCollision(m_continuousCollision);
                 EngineNode.SetSimulate(m_simulate, m_fixed);
             }
         }
@@ -215,6 +219,22 @@ namespace Toolset2D
                 m_convexHullCollision = info.GetBoolean("_convexHullCollision");
             }
 
+            if (SerializationHelper.HasElement(info, "_pixelCollision"))
+            {
+                m_pixelCollision = info.GetBoolean("_pixelCollision");
+            }
+
+            if (SerializationHelper.HasElement(info, "_continuousCollision"))
+            {
+                m_continuousCollision = info.GetBoolean("_continuousCollision");
+            }
+
+            if (SerializationHelper.HasElement(info, "_collisionLayer"))
+            {
+                m_collisionLayer = info.GetUInt32("_collisionLayer");
+                m_collisionMask = info.GetUInt32("_collisionMask");
+            }
+
             if (SerializationHelper.HasElement(info, "_simulate"))
             {
                 m_simulate = info.GetBoolean("_simulate");
@@ -241,6 +261,10 @@ namespace Toolset2D
             info.AddValue("_collision", m_collision);
             info.AddValue("_rotation", m_rotation);
             info.AddValue("_convexHullCollision", m_convexHullCollision);
+            info.AddValue("_pixelCollision", m_pixelCollision);
+            info.AddValue("_continuousCollision", m_continuousCollision);
+            info.AddValue("_collisionLayer", m_collisionLayer);
+            info.AddValue("_collisionMask", m_collisionMask);
             info.AddValue("_simulate", m_simulate);
             info.AddValue("_fixed", m_fixed);
         }
@@ -447,6 +471,62 @@ namespace Toolset2D
             }
         }
 
+        bool m_pixelCollision;
+        [SortedCategory(CAT_DYNAMICS, CATORDER_SPRITE),
+        PropertyOrder(9)]
+        [Description("Only collide where opaque pixels overlap. Needs a sprite sheet baked with 'spritesheetbin.py --masks'.")]
+        public bool PixelCollision
+        {
+            get { return EngineNode.IsPixelCollision(); }
+            set
+            {
+                m_pixelCollision = value;
+                SetEngineInstanceBaseProperties();
+            }
+        }
+
+        bool m_continuousCollision;
+        [SortedCategory(CAT_DYNAMICS, CATORDER_SPRITE),
+        PropertyOrder(9)]
+        [Description("Also test the path from the last frame's position so that fast sprites can't pass through others")]
+        public bool ContinuousCollision
+        {
+            get { return EngineNode.IsContinuousCollision(); }
+            set
+            {
+                m_continuousCollision = value;
+                SetEngineInstanceBaseProperties();
+            }
+        }
+
+        uint m_collisionLayer = 1;
+        [SortedCategory(CAT_DYNAMICS, CATORDER_SPRITE),
+        PropertyOrder(9)]
+        [Description("Collision layer bits of this sprite. It only collides with sprites whose mask contains one of these bits.")]
+        public uint CollisionLayer
+        {
+            get { return EngineNode.GetCollisionLayer(); }
+            set
+            {
+                m_collisionLayer = value;
+                SetEngineInstanceBaseProperties();
+            }
+        }
+
+        uint m_collisionMask = 0xFFFFFFFF;
+        [SortedCategory(CAT_DYNAMICS, CATORDER_SPRITE),
+        PropertyOrder(9)]
+        [Description("Collision layers this sprite collides with")]
+        public uint CollisionMask
+        {
+            get { return EngineNode.GetCollisionMask(); }
+            set
+            {
+                m_collisionMask = value;
+                SetEngineInstanceBaseProperties();
+            }
+        }
+
         bool m_simulate;
         [SortedCategory(CAT_DYNAMICS, CATORDER_SPRITE),
         PropertyOrder(9)]
@@ -0,0 +1,360 @@
+//=======
+//
+// Purpose: Pixel masks of sprite cells and the overlap test between two placed masks
+//
+//=======
+
+#include "AlphaMask2d.hpp"
+
+#include <math.h>
+
+namespace
+{
+	const int kBitsPerWord = 64;
+
+	// Placed pixels count as lined up if they are this close to whole pixels
+	const double kAlignmentTolerance = 1e-3;
+
+	// Mask pixel to world space and back, following SpriteQuads2D::ComputeCorners
+	struct MaskTransform
+	{
+		bool Init(const SpriteQuad2D &quad, int maskWidth, int maskHeight)
+		{
+			if (quad.scaleX == 0.f || quad.scaleY == 0.f || maskWidth <= 0 || maskHeight <= 0)
+			{
+				return false;
+			}
+
+			originX = quad.positionX + quad.centerX;
+			originY = quad.positionY + quad.centerY;
+			offsetX = quad.offsetX;
+			offsetY = quad.offsetY;
+			pixelX = quad.width / static_cast<float>(maskWidth);
+			pixelY = quad.height / static_cast<float>(maskHeight);
+			scaleX = quad.scaleX;
+			scaleY = quad.scaleY;
+			c = quad.cosRotation;
+			s = quad.sinRotation;
+
+			return (pixelX != 0.0 && pixelY != 0.0);
+		}
+
+		void ToWorld(double x, double y, double &worldX, double &worldY) const
+		{
+			const double localX = (offsetX + x * pixelX) * scaleX;
+			const double localY = (offsetY + y * pixelY) * scaleY;
+			worldX = c * localX - s * localY + originX;
+			worldY = s * localX + c * localY + originY;
+		}
+
+		void FromWorld(double worldX, double worldY, double &x, double &y) const
+		{
+			const double relativeX = worldX - originX;
+			const double relativeY = worldY - originY;
+			x = ((c * relativeX + s * relativeY) / scaleX - offsetX) / pixelX;
+			y = ((c * relativeY - s * relativeX) / scaleY - offsetY) / pixelY;
+		}
+
+		double originX;
+		double originY;
+		double offsetX;
+		double offsetY;
+		double pixelX;
+		double pixelY;
+		double scaleX;
+		double scaleY;
+		double c;
+		double s;
+	};
+
+	// Maps pixel coordinates of one mask to those of another as 'origin + x * stepX + y * stepY'
+	struct MaskMapping
+	{
+		void Init(const MaskTransform &from, const MaskTransform &to)
+		{
+			Map(from, to, 0.0, 0.0, originX, originY);
+
+			double x;
+			double y;
+			Map(from, to, 1.0, 0.0, x, y);
+			stepXX = x - originX;
+			stepXY = y - originY;
+			Map(from, to, 0.0, 1.0, x, y);
+			stepYX = x - originX;
+			stepYY = y - originY;
+		}
+
+		static void Map(const MaskTransform &from, const MaskTransform &to, double x, double y, double &toX, double &toY)
+		{
+			double worldX;
+			double worldY;
+			from.ToWorld(x, y, worldX, worldY);
+			to.FromWorld(worldX, worldY, toX, toY);
+		}
+
+		double originX;
+		double originY;
+		double stepXX;
+		double stepXY;
+		double stepYX;
+		double stepYY;
+	};
+
+	inline bool IsWhole(double value)
+	{
+		return fabs(value - floor(value + 0.5)) < kAlignmentTolerance;
+	}
+
+	inline int FloorDiv(int value, int divisor)
+	{
+		return (value >= 0) ? (value / divisor) : -((-value + divisor - 1) / divisor);
+	}
+
+	// Pixels [first, first + 64) of a mask row, or of a solid row 'width' pixels long if
+	// there is no mask. Everything outside of the row is clear.
+	unsigned long long GetRowBits(const AlphaMask2D *mask, int width, int y, int first)
+	{
+		if (mask == NULL)
+		{
+			unsigned long long bits = 0;
+			const int begin = (first > 0) ? first : 0;
+			const int end = (first + kBitsPerWord < width) ? (first + kBitsPerWord) : width;
+			for (int x = begin; x < end; x++)
+			{
+				bits |= 1ULL << (x - first);
+			}
+			return bits;
+		}
+
+		const unsigned long long *row = mask->GetRow(y);
+		const int wordsPerRow = mask->GetWordsPerRow();
+		const int word = FloorDiv(first, kBitsPerWord);
+		const int shift = first - word * kBitsPerWord;
+
+		const unsigned long long low = (word >= 0 && word < wordsPerRow) ? row[word] : 0;
+		if (shift == 0)
+		{
+			return low;
+		}
+
+		const unsigned long long high = (word + 1 >= 0 && word + 1 < wordsPerRow) ? row[word + 1] : 0;
+		return (low >> shift) | (high << (kBitsPerWord - shift));
+	}
+
+	inline bool GetSample(const AlphaMask2D *mask, int width, int height, double x, double y)
+	{
+		if (!(x >= 0.0 && x < width && y >= 0.0 && y < height))
+		{
+			return false;
+		}
+		return (mask == NULL) || mask->GetPixel(static_cast<int>(x), static_cast<int>(y));
+	}
+}
+
+AlphaMask2D::AlphaMask2D()
+{
+	m_width = 0;
+	m_height = 0;
+	m_wordsPerRow = 0;
+}
+
+void AlphaMask2D::Create(int width, int height)
+{
+	if (width <= 0 || height <= 0)
+	{
+		Clear();
+		return;
+	}
+
+	m_width = width;
+	m_height = height;
+	m_wordsPerRow = (width + kBitsPerWord - 1) / kBitsPerWord;
+	m_words.assign(static_cast<size_t>(m_wordsPerRow) * height, 0);
+}
+
+void AlphaMask2D::Clear()
+{
+	m_width = 0;
+	m_height = 0;
+	m_wordsPerRow = 0;
+	m_words.clear();
+}
+
+bool AlphaMask2D::IsEmpty() const
+{
+	return m_words.empty();
+}
+
+int AlphaMask2D::GetWidth() const
+{
+	return m_width;
+}
+
+int AlphaMask2D::GetHeight() const
+{
+	return m_height;
+}
+
+int AlphaMask2D::GetWordsPerRow() const
+{
+	return m_wordsPerRow;
+}
+
+void AlphaMask2D::SetPixel(int x, int y, bool set)
+{
+	unsigned long long &word = m_words[y * m_wordsPerRow + x / kBitsPerWord];
+	const unsigned long long bit = 1ULL << (x % kBitsPerWord);
+	word = set ? (word | bit) : (word & ~bit);
+}
+
+bool AlphaMask2D::GetPixel(int x, int y) const
+{
+	return ( (m_words[y * m_wordsPerRow + x / kBitsPerWord] >> (x % kBitsPerWord)) & 1 ) != 0;
+}
+
+unsigned long long *AlphaMask2D::GetRow(int y)
+{
+	return &m_words[y * m_wordsPerRow];
+}
+
+const unsigned long long *AlphaMask2D::GetRow(int y) const
+{
+	return &m_words[y * m_wordsPerRow];
+}
+
+bool AlphaMasksOverlap2D(const AlphaMask2D *mask, const SpriteQuad2D &quad,
+	const AlphaMask2D *otherMask, const SpriteQuad2D &otherQuad,
+	std::vector<unsigned long long> &scratch)
+{
+	// Walk the mask that is there, two solid quads overlap wherever their outlines do
+	if (mask == NULL || mask->IsEmpty())
+	{
+		if (otherMask == NULL || otherMask->IsEmpty())
+		{
+			return true;
+		}
+		return AlphaMasksOverlap2D(otherMask, otherQuad, NULL, quad, scratch);
+	}
+
+	if (otherMask != NULL && otherMask->IsEmpty())
+	{
+		otherMask = NULL;
+	}
+
+	// A solid quad is a mask with one pixel per unit of its rectangle
+	const int width = mask->GetWidth();
+	const int height = mask->GetHeight();
+	const int otherWidth = (otherMask != NULL) ? otherMask->GetWidth() : static_cast<int>(ceil(otherQuad.width));
+	const int otherHeight = (otherMask != NULL) ? otherMask->GetHeight() : static_cast<int>(ceil(otherQuad.height));
+
+	MaskTransform transform;
+	MaskTransform otherTransform;
+	if (!transform.Init(quad, width, height) || !otherTransform.Init(otherQuad, otherWidth, otherHeight))
+	{
+		return false;
+	}
+
+	// Only the pixels within the bounds of the other mask can overlap it
+	double minX = width;
+	double minY = height;
+	double maxX = 0.0;
+	double maxY = 0.0;
+	const double cornersX[QUAD_NUM_CORNERS] = { 0.0, static_cast<double>(otherWidth), 0.0, static_cast<double>(otherWidth) };
+	const double cornersY[QUAD_NUM_CORNERS] = { 0.0, 0.0, static_cast<double>(otherHeight), static_cast<double>(otherHeight) };
+	for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+	{
+		double x;
+		double y;
+		MaskMapping::Map(otherTransform, transform, cornersX[corner], cornersY[corner], x, y);
+		minX = (x < minX) ? x : minX;
+		minY = (y < minY) ? y : minY;
+		maxX = (x > maxX) ? x : maxX;
+		maxY = (y > maxY) ? y : maxY;
+	}
+
+	const int beginX = (minX > 0.0) ? static_cast<int>(floor(minX)) : 0;
+	const int beginY = (minY > 0.0) ? static_cast<int>(floor(minY)) : 0;
+	const int endX = (maxX < width) ? static_cast<int>(ceil(maxX)) : width;
+	const int endY = (maxY < height) ? static_cast<int>(ceil(maxY)) : height;
+	if (beginX >= endX || beginY >= endY)
+	{
+		return false;
+	}
+
+	const int beginWord = beginX / kBitsPerWord;
+	const int endWord = (endX - 1) / kBitsPerWord + 1;
+
+	MaskMapping mapping;
+	mapping.Init(transform, otherTransform);
+
+	const bool linedUp =
+		fabs(mapping.stepXX - 1.0) < kAlignmentTolerance && fabs(mapping.stepXY) < kAlignmentTolerance &&
+		fabs(mapping.stepYX) < kAlignmentTolerance && fabs(mapping.stepYY - 1.0) < kAlignmentTolerance &&
+		IsWhole(mapping.originX) && IsWhole(mapping.originY);
+
+	if (linedUp)
+	{
+		const int shiftX = static_cast<int>(floor(mapping.originX + 0.5));
+		const int shiftY = static_cast<int>(floor(mapping.originY + 0.5));
+
+		for (int y = beginY; y < endY; y++)
+		{
+			const int otherY = y + shiftY;
+			if (otherY < 0 || otherY >= otherHeight)
+			{
+				continue;
+			}
+
+			const unsigned long long *row = mask->GetRow(y);
+			for (int word = beginWord; word < endWord; word++)
+			{
+				if ( row[word] != 0 &&
+					 (row[word] & GetRowBits(otherMask, otherWidth, otherY, word * kBitsPerWord + shiftX)) != 0 )
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	scratch.resize(mask->GetWordsPerRow());
+
+	for (int y = beginY; y < endY; y++)
+	{
+		const unsigned long long *row = mask->GetRow(y);
+		for (int word = beginWord; word < endWord; word++)
+		{
+			// Nothing to resample where the mask itself is empty
+			scratch[word] = 0;
+			if (row[word] == 0)
+			{
+				continue;
+			}
+
+			const int firstX = (word * kBitsPerWord > beginX) ? word * kBitsPerWord : beginX;
+			const int lastX = ((word + 1) * kBitsPerWord < endX) ? (word + 1) * kBitsPerWord : endX;
+
+			// Sample at the pixel centers
+			double sampleX = mapping.originX + (firstX + 0.5) * mapping.stepXX + (y + 0.5) * mapping.stepYX;
+			double sampleY = mapping.originY + (firstX + 0.5) * mapping.stepXY + (y + 0.5) * mapping.stepYY;
+			for (int x = firstX; x < lastX; x++)
+			{
+				if (GetSample(otherMask, otherWidth, otherHeight, sampleX, sampleY))
+				{
+					scratch[word] |= 1ULL << (x % kBitsPerWord);
+				}
+				sampleX += mapping.stepXX;
+				sampleY += mapping.stepXY;
+			}
+
+			if ((row[word] & scratch[word]) != 0)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,53 @@
+#ifndef ALPHA_MASK_2D_HPP_INCLUDED
+#define ALPHA_MASK_2D_HPP_INCLUDED
+
+#include "SpriteQuads2d.hpp"
+
+#include <vector>
+
+// One bit per pixel of a cell, set where the pixel is opaque. Every row starts on a new
+// 64-bit word and pixel x of a row is bit (x % 64) of word (x / 64), so a whole row is
+// tested against another one word by word. Padding bits past the width are always clear.
+class AlphaMask2D
+{
+public:
+	AlphaMask2D();
+
+	// Clears every pixel
+	void Create(int width, int height);
+	void Clear();
+
+	bool IsEmpty() const;
+	int GetWidth() const;
+	int GetHeight() const;
+	int GetWordsPerRow() const;
+
+	void SetPixel(int x, int y, bool set);
+	bool GetPixel(int x, int y) const;
+
+	// Rows are GetWordsPerRow() words long. Callers filling in rows directly must keep the
+	// padding bits clear.
+	unsigned long long *GetRow(int y);
+	const unsigned long long *GetRow(int y) const;
+
+private:
+	int m_width;
+	int m_height;
+	int m_wordsPerRow;
+	std::vector<unsigned long long> m_words;
+};
+
+// Tests the masks of two sprites placed by their quads. Each mask covers the quad's
+// rectangle, from (0, 0) to (width, height), so it is stretched along with the quad.
+// Passing NULL for either mask treats that quad as solid.
+//
+// Only the part of the first mask that the other quad covers is visited. Where both quads
+// have the same rotation and scale and sit a whole number of pixels apart, the rows are
+// shifted into place and tested 64 pixels at a time. Otherwise every pixel of that part is
+// looked up in the other mask first (nearest neighbour), a row at a time, and the resampled
+// row is tested the same way. 'scratch' holds that row.
+bool AlphaMasksOverlap2D(const AlphaMask2D *mask, const SpriteQuad2D &quad,
+	const AlphaMask2D *otherMask, const SpriteQuad2D &otherQuad,
+	std::vector<unsigned long long> &scratch);
+
+#endif // ALPHA_MASK_2D_HPP_INCLUDED
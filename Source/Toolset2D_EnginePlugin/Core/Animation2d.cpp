@@ -0,0 +1,127 @@
+//=======
+//
+// Purpose: Frame timing of frame based animations, advanced by whole frames and loops at once
+//
+//=======
+
+#include "Animation2d.hpp"
+
+int AdvanceAnimation2D(const AnimationTimeline2D &timeline, float deltaTime, int &frame, float &frameTime)
+{
+	const int numFrames = timeline.numFrames;
+	if (numFrames <= 0 || !(timeline.loopDuration > 0.f))
+	{
+		return 0;
+	}
+
+	if (frame < 0 || frame >= numFrames)
+	{
+		frame = (frame < 0) ? 0 : numFrames - 1;
+	}
+
+	const float *frameEndTimes = timeline.frameEndTimes;
+	const float frameStart = (frame > 0) ? frameEndTimes[frame - 1] : 0.f;
+
+	frameTime += deltaTime;
+	if (frameStart + frameTime < frameEndTimes[frame])
+	{
+		return 0;
+	}
+
+	// Skip whole loops first, then find the frame within the last one
+	float loopTime = frameStart + frameTime;
+	int numLoops = 0;
+
+	if (loopTime >= timeline.loopDuration)
+	{
+		numLoops = static_cast<int>(loopTime / timeline.loopDuration);
+		loopTime -= static_cast<float>(numLoops) * timeline.loopDuration;
+
+		// Rounding can leave the time just outside of the loop
+		if (loopTime >= timeline.loopDuration)
+		{
+			loopTime -= timeline.loopDuration;
+			numLoops++;
+		}
+		if (numLoops == 0)
+		{
+			numLoops = 1;
+		}
+		if (loopTime < 0.f)
+		{
+			loopTime = 0.f;
+		}
+	}
+
+	if (timeline.frameDuration > 0.f)
+	{
+		frame = static_cast<int>(loopTime / timeline.frameDuration);
+		if (frame >= numFrames)
+		{
+			frame = numFrames - 1;
+		}
+		frameTime = loopTime - static_cast<float>(frame) * timeline.frameDuration;
+	}
+	else
+	{
+		// First frame that ends after the current time
+		int first = 0;
+		int last = numFrames - 1;
+		while (first < last)
+		{
+			const int middle = (first + last) / 2;
+			if (frameEndTimes[middle] > loopTime)
+			{
+				last = middle;
+			}
+			else
+			{
+				first = middle + 1;
+			}
+		}
+
+		frame = first;
+		frameTime = loopTime - ((frame > 0) ? frameEndTimes[frame - 1] : 0.f);
+	}
+
+	if (frameTime < 0.f)
+	{
+		frameTime = 0.f;
+	}
+
+	return numLoops;
+}
+
+float BuildFrameEndTimes2D(const float *frameDurations, int numFrames, float framerate, float *frameEndTimes)
+{
+	const float defaultDuration = (framerate > 0.f) ? (1.0f / framerate) : 0.f;
+
+	bool uniform = true;
+	for (int frame = 0; frame < numFrames; frame++)
+	{
+		const float duration = frameDurations[frame];
+		if (duration > 0.f && duration != defaultDuration)
+		{
+			uniform = false;
+			break;
+		}
+	}
+
+	// Multiply rather than add up equal frames so the times match the division exactly
+	float time = 0.f;
+	for (int frame = 0; frame < numFrames; frame++)
+	{
+		if (uniform)
+		{
+			time = static_cast<float>(frame + 1) * defaultDuration;
+		}
+		else
+		{
+			const float duration = frameDurations[frame];
+			time += (duration > 0.f) ? duration : defaultDuration;
+		}
+		frameEndTimes[frame] = time;
+	}
+
+	return uniform ? defaultDuration : 0.f;
+}
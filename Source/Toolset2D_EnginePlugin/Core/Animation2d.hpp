@@ -0,0 +1,25 @@
+#ifndef ANIMATION_2D_HPP_INCLUDED
+#define ANIMATION_2D_HPP_INCLUDED
+
+// Frame timing of one animation. frameEndTimes holds the time within a loop at which each
+// frame ends, so the last entry is the duration of the whole loop. frameDuration is only
+// set if every frame is shown equally long, which lets the frame be found by a division.
+struct AnimationTimeline2D
+{
+	const float *frameEndTimes;
+	int numFrames;
+	float frameDuration;
+	float loopDuration;
+};
+
+// Moves 'frame' and 'frameTime' (the time the frame has been shown) on by deltaTime, across
+// as many frames and loops as it covers. Returns the number of loops that were completed.
+// Ticks that stay within the current frame only cost a compare.
+int AdvanceAnimation2D(const AnimationTimeline2D &timeline, float deltaTime, int &frame, float &frameTime);
+
+// Works out when each of the frames ends for a timeline. Frames with a duration of zero or
+// less are shown for one frame at the framerate. Returns the frame duration if all frames
+// are shown equally long and zero otherwise.
+float BuildFrameEndTimes2D(const float *frameDurations, int numFrames, float framerate, float *frameEndTimes);
+
+#endif // ANIMATION_2D_HPP_INCLUDED
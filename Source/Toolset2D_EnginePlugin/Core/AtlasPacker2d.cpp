@@ -0,0 +1,231 @@
+//=======
+//
+// Purpose: Packs small images into shared texture atlas pages at runtime
+//
+//=======
+
+#include "AtlasPacker2d.hpp"
+
+#include <stddef.h>
+
+namespace
+{
+	inline int Clamp(int value, int low, int high)
+	{
+		return (value < low) ? low : ((value > high) ? high : value);
+	}
+}
+
+AtlasPacker2D::AtlasPacker2D(int pageSize, int padding)
+{
+	m_pageSize = 0;
+	m_padding = 0;
+
+	SetPageSize(pageSize);
+	SetPadding(padding);
+}
+
+void AtlasPacker2D::SetPageSize(int pageSize)
+{
+	m_pageSize = (pageSize > 1) ? pageSize : 1;
+	Clear();
+}
+
+int AtlasPacker2D::GetPageSize() const
+{
+	return m_pageSize;
+}
+
+void AtlasPacker2D::SetPadding(int padding)
+{
+	m_padding = (padding > 0) ? padding : 0;
+	Clear();
+}
+
+int AtlasPacker2D::GetPadding() const
+{
+	return m_padding;
+}
+
+bool AtlasPacker2D::Insert(int width, int height, int &page, AtlasRect2D &rect)
+{
+	const int paddedWidth = width + m_padding * 2;
+	const int paddedHeight = height + m_padding * 2;
+
+	if (width <= 0 || height <= 0 || paddedWidth > m_pageSize || paddedHeight > m_pageSize)
+	{
+		return false;
+	}
+
+	int x = 0;
+	int y = 0;
+
+	page = -1;
+	for (int pageIndex = 0; pageIndex < static_cast<int>(m_pages.size()); pageIndex++)
+	{
+		if (InsertIntoPage(m_pages[pageIndex], paddedWidth, paddedHeight, x, y))
+		{
+			page = pageIndex;
+			break;
+		}
+	}
+
+	if (page == -1)
+	{
+		SkylineNode node;
+		node.x = 0;
+		node.y = 0;
+		node.width = m_pageSize;
+
+		m_pages.push_back(Skyline());
+		m_pages.back().push_back(node);
+
+		page = static_cast<int>(m_pages.size()) - 1;
+		InsertIntoPage(m_pages.back(), paddedWidth, paddedHeight, x, y);
+	}
+
+	rect.x = x + m_padding;
+	rect.y = y + m_padding;
+	rect.width = width;
+	rect.height = height;
+
+	return true;
+}
+
+int AtlasPacker2D::GetNumPages() const
+{
+	return static_cast<int>(m_pages.size());
+}
+
+void AtlasPacker2D::Clear()
+{
+	m_pages.clear();
+}
+
+void AtlasPacker2D::GetUvTransform(const AtlasRect2D &rect, float &offsetU, float &offsetV, float &scaleU, float &scaleV) const
+{
+	const float inversePageSize = 1.0f / static_cast<float>(m_pageSize);
+
+	offsetU = static_cast<float>(rect.x) * inversePageSize;
+	offsetV = static_cast<float>(rect.y) * inversePageSize;
+	scaleU = static_cast<float>(rect.width) * inversePageSize;
+	scaleV = static_cast<float>(rect.height) * inversePageSize;
+}
+
+void AtlasPacker2D::CopyWithBorder(const unsigned int *source, int width, int height, int padding, unsigned int *dest)
+{
+	const int destWidth = width + padding * 2;
+	const int destHeight = height + padding * 2;
+
+	for (int destY = 0; destY < destHeight; destY++)
+	{
+		const unsigned int *sourceRow = source + Clamp(destY - padding, 0, height - 1) * width;
+		unsigned int *destRow = dest + destY * destWidth;
+
+		for (int destX = 0; destX < destWidth; destX++)
+		{
+			destRow[destX] = sourceRow[Clamp(destX - padding, 0, width - 1)];
+		}
+	}
+}
+
+bool AtlasPacker2D::InsertIntoPage(Skyline &skyline, int width, int height, int &x, int &y) const
+{
+	int bestIndex = -1;
+	int bestTop = m_pageSize + 1;
+
+	// Bottom-left: pick the spot where the top of the image ends up lowest, leftmost on ties
+	for (int nodeIndex = 0; nodeIndex < static_cast<int>(skyline.size()); nodeIndex++)
+	{
+		int nodeY;
+		if (FitsAt(skyline, nodeIndex, width, height, nodeY) && nodeY + height < bestTop)
+		{
+			bestIndex = nodeIndex;
+			bestTop = nodeY + height;
+			x = skyline[nodeIndex].x;
+			y = nodeY;
+		}
+	}
+
+	if (bestIndex == -1)
+	{
+		return false;
+	}
+
+	AddSkylineLevel(skyline, bestIndex, x, y, width, height);
+	return true;
+}
+
+bool AtlasPacker2D::FitsAt(const Skyline &skyline, int nodeIndex, int width, int height, int &y) const
+{
+	const int x = skyline[nodeIndex].x;
+	if (x + width > m_pageSize)
+	{
+		return false;
+	}
+
+	// The image rests on the highest node that it spans
+	y = 0;
+	int widthLeft = width;
+	while (widthLeft > 0)
+	{
+		const SkylineNode &node = skyline[nodeIndex];
+		if (node.y > y)
+		{
+			y = node.y;
+		}
+
+		if (y + height > m_pageSize)
+		{
+			return false;
+		}
+
+		widthLeft -= node.width;
+		nodeIndex++;
+	}
+
+	return true;
+}
+
+void AtlasPacker2D::AddSkylineLevel(Skyline &skyline, int nodeIndex, int x, int y, int width, int height)
+{
+	SkylineNode newNode;
+	newNode.x = x;
+	newNode.y = y + height;
+	newNode.width = width;
+	skyline.insert(skyline.begin() + nodeIndex, newNode);
+
+	// Cut away the parts of the following nodes that are now covered
+	const int right = x + width;
+	size_t index = nodeIndex + 1;
+	while (index < skyline.size() && skyline[index].x < right)
+	{
+		SkylineNode &node = skyline[index];
+		const int shrink = right - node.x;
+
+		node.x += shrink;
+		node.width -= shrink;
+
+		if (node.width > 0)
+		{
+			break;
+		}
+
+		skyline.erase(skyline.begin() + index);
+	}
+
+	// Merge neighbours at the same height
+	index = 0;
+	while (index + 1 < skyline.size())
+	{
+		if (skyline[index].y == skyline[index + 1].y)
+		{
+			skyline[index].width += skyline[index + 1].width;
+			skyline.erase(skyline.begin() + index + 1);
+		}
+		else
+		{
+			index++;
+		}
+	}
+}
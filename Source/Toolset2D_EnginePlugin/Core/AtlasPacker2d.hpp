@@ -0,0 +1,65 @@
+#ifndef ATLAS_PACKER_2D_HPP_INCLUDED
+#define ATLAS_PACKER_2D_HPP_INCLUDED
+
+#include <vector>
+
+// Rectangle in pixels inside of an atlas page
+struct AtlasRect2D
+{
+	int x;
+	int y;
+	int width;
+	int height;
+};
+
+// Packs images into square atlas pages one at a time as they are loaded, using a skyline
+// (bottom-left) heuristic. Every image gets 'padding' pixels reserved on each side so that
+// filtering never picks up texels of a neighbouring image. Kept free of any engine types so
+// that it can be used and tested outside of the engine.
+class AtlasPacker2D
+{
+public:
+	AtlasPacker2D(int pageSize = 1024, int padding = 2);
+
+	// Changing either of these clears all pages
+	void SetPageSize(int pageSize);
+	int GetPageSize() const;
+	void SetPadding(int padding);
+	int GetPadding() const;
+
+	// Finds space for an image, opening a new page if it doesn't fit on any of the existing
+	// ones. 'rect' is where the image itself goes, not including the padding. Returns false
+	// if the image doesn't even fit on an empty page.
+	bool Insert(int width, int height, int &page, AtlasRect2D &rect);
+
+	int GetNumPages() const;
+	void Clear();
+
+	// Texture coordinates of the original image map to 'offset + uv * scale' on the page
+	void GetUvTransform(const AtlasRect2D &rect, float &offsetU, float &offsetV, float &scaleU, float &scaleV) const;
+
+	// Copies a 32-bit image into 'dest', which has to be (width + 2 * padding) by
+	// (height + 2 * padding) pixels. The edge pixels are repeated into the padding.
+	static void CopyWithBorder(const unsigned int *source, int width, int height, int padding, unsigned int *dest);
+
+private:
+	struct SkylineNode
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	typedef std::vector<SkylineNode> Skyline;
+
+	bool InsertIntoPage(Skyline &skyline, int width, int height, int &x, int &y) const;
+	bool FitsAt(const Skyline &skyline, int nodeIndex, int width, int height, int &y) const;
+	static void AddSkylineLevel(Skyline &skyline, int nodeIndex, int x, int y, int width, int height);
+
+	int m_pageSize;
+	int m_padding;
+
+	std::vector<Skyline> m_pages;
+};
+
+#endif // ATLAS_PACKER_2D_HPP_INCLUDED
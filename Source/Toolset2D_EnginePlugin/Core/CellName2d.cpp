@@ -0,0 +1,33 @@
+//=======
+//
+// Purpose: Splits the names of sprite sheet cells into state name and frame number
+//
+//=======
+
+#include "CellName2d.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool ParseCellName2D(const char *cellName, std::string &stateName, int &frameNumber)
+{
+	const char *separator = strrchr(cellName, '_');
+	if (separator == NULL)
+	{
+		const char *extension = strrchr(cellName, '.');
+		if (extension != NULL)
+		{
+			stateName.assign(cellName, extension - cellName);
+		}
+		else
+		{
+			stateName.assign(cellName);
+		}
+		return false;
+	}
+
+	// The number runs up to the extension, which atoi stops at
+	stateName.assign(cellName, separator - cellName);
+	frameNumber = atoi(separator + 1);
+	return true;
+}
@@ -0,0 +1,15 @@
+#ifndef CELL_NAME_2D_HPP_INCLUDED
+#define CELL_NAME_2D_HPP_INCLUDED
+
+#include <string>
+
+// Framerates of the states made up from the cells of a sheet written by ShoeBox
+static const float kSingleCellFramerate2D = 30.0f;
+static const float kAnimatedFramerate2D = 10.0f;
+
+// ShoeBox names cells after the image they were packed from. 'walk_0003.png' is frame 3
+// of the state 'walk', while a name without an underscore like 'background.png' is a
+// state of its own. Returns false for the latter, which leaves 'frameNumber' untouched.
+bool ParseCellName2D(const char *cellName, std::string &stateName, int &frameNumber);
+
+#endif // CELL_NAME_2D_HPP_INCLUDED
@@ -0,0 +1,347 @@
+//=======
+//
+// Purpose: Overlap tests between the quads of sprites
+//
+//=======
+
+#include "Collision2d.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+namespace
+{
+	inline float Min2D(float a, float b)
+	{
+		return (a < b) ? a : b;
+	}
+
+	inline float Max2D(float a, float b)
+	{
+		return (a > b) ? a : b;
+	}
+
+	inline float MinCorner(const float *values)
+	{
+		return Min2D( Min2D(values[0], values[1]), Min2D(values[2], values[3]) );
+	}
+
+	inline float MaxCorner(const float *values)
+	{
+		return Max2D( Max2D(values[0], values[1]), Max2D(values[2], values[3]) );
+	}
+
+	// True if the projections of both quads onto the axis don't meet
+	inline bool IsSeparatingAxis(float axisX, float axisY,
+		const float *quadX, const float *quadY, const float *otherX, const float *otherY)
+	{
+		float projected[QUAD_NUM_CORNERS];
+		float otherProjected[QUAD_NUM_CORNERS];
+		for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+		{
+			projected[corner] = quadX[corner] * axisX + quadY[corner] * axisY;
+			otherProjected[corner] = otherX[corner] * axisX + otherY[corner] * axisY;
+		}
+
+		return ( MaxCorner(projected) < MinCorner(otherProjected) ||
+				 MaxCorner(otherProjected) < MinCorner(projected) );
+	}
+
+	// Both edges leaving the top left corner are parallel to the other two edges, so
+	// their normals are the only axes a parallelogram needs
+	inline bool HasSeparatingEdge(const float *quadX, const float *quadY, const float *otherX, const float *otherY)
+	{
+		const float topX = quadX[QUAD_TOP_RIGHT] - quadX[QUAD_TOP_LEFT];
+		const float topY = quadY[QUAD_TOP_RIGHT] - quadY[QUAD_TOP_LEFT];
+		const float leftX = quadX[QUAD_BOTTOM_LEFT] - quadX[QUAD_TOP_LEFT];
+		const float leftY = quadY[QUAD_BOTTOM_LEFT] - quadY[QUAD_TOP_LEFT];
+
+		return ( IsSeparatingAxis(-topY, topX, quadX, quadY, otherX, otherY) ||
+				 IsSeparatingAxis(-leftY, leftX, quadX, quadY, otherX, otherY) );
+	}
+
+	inline bool IsVertexBefore(const Vertex2D &vertex, const Vertex2D &otherVertex)
+	{
+		return (vertex.x < otherVertex.x) || (vertex.x == otherVertex.x && vertex.y < otherVertex.y);
+	}
+
+	inline float Cross(const Vertex2D &origin, const Vertex2D &a, const Vertex2D &b)
+	{
+		return (a.x - origin.x) * (b.y - origin.y) - (a.y - origin.y) * (b.x - origin.x);
+	}
+
+	inline void ProjectPolygon(const Vertex2D *vertices, int numVertices, float axisX, float axisY, float &minimum, float &maximum)
+	{
+		minimum = maximum = vertices[0].x * axisX + vertices[0].y * axisY;
+		for (int vertex = 1; vertex < numVertices; vertex++)
+		{
+			const float projected = vertices[vertex].x * axisX + vertices[vertex].y * axisY;
+			minimum = Min2D(minimum, projected);
+			maximum = Max2D(maximum, projected);
+		}
+	}
+
+	bool HasSeparatingPolygonEdge(const Vertex2D *vertices, int numVertices, const Vertex2D *otherVertices, int otherNumVertices)
+	{
+		for (int vertex = 0, previous = numVertices - 1; vertex < numVertices; previous = vertex++)
+		{
+			const float axisX = vertices[previous].y - vertices[vertex].y;
+			const float axisY = vertices[vertex].x - vertices[previous].x;
+
+			float minimum;
+			float maximum;
+			float otherMinimum;
+			float otherMaximum;
+			ProjectPolygon(vertices, numVertices, axisX, axisY, minimum, maximum);
+			ProjectPolygon(otherVertices, otherNumVertices, axisX, axisY, otherMinimum, otherMaximum);
+
+			if (maximum < otherMinimum || otherMaximum < minimum)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Narrows [enter, exit] down to the part of the move during which the projections onto
+	// every edge normal of the first polygon meet. Returns false once nothing is left.
+	bool ClipSweepToPolygonEdges(const Vertex2D *vertices, int numVertices, const Vertex2D *otherVertices, int otherNumVertices,
+		float moveX, float moveY, float &enter, float &exit)
+	{
+		for (int vertex = 0, previous = numVertices - 1; vertex < numVertices; previous = vertex++)
+		{
+			const float axisX = vertices[previous].y - vertices[vertex].y;
+			const float axisY = vertices[vertex].x - vertices[previous].x;
+
+			float minimum;
+			float maximum;
+			float otherMinimum;
+			float otherMaximum;
+			ProjectPolygon(vertices, numVertices, axisX, axisY, minimum, maximum);
+			ProjectPolygon(otherVertices, otherNumVertices, axisX, axisY, otherMinimum, otherMaximum);
+
+			// The first polygon moves relative to the other one, which stands still, and
+			// the projections are taken at the end so they start out 'speed' further back
+			const float speed = moveX * axisX + moveY * axisY;
+			minimum -= speed;
+			maximum -= speed;
+
+			if (speed == 0.f)
+			{
+				if (maximum < otherMinimum || otherMaximum < minimum)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const float touch = (otherMinimum - maximum) / speed;
+			const float separate = (otherMaximum - minimum) / speed;
+			enter = Max2D( enter, Min2D(touch, separate) );
+			exit = Min2D( exit, Max2D(touch, separate) );
+
+			if (enter > exit)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline float SegmentPointDistanceSquared(const Vertex2D &start, const Vertex2D &end, float x, float y)
+	{
+		const float edgeX = end.x - start.x;
+		const float edgeY = end.y - start.y;
+		const float lengthSquared = edgeX * edgeX + edgeY * edgeY;
+
+		float along = 0.f;
+		if (lengthSquared > 0.f)
+		{
+			along = ((x - start.x) * edgeX + (y - start.y) * edgeY) / lengthSquared;
+			along = Min2D( Max2D(along, 0.f), 1.f );
+		}
+
+		const float offsetX = start.x + edgeX * along - x;
+		const float offsetY = start.y + edgeY * along - y;
+		return offsetX * offsetX + offsetY * offsetY;
+	}
+}
+
+bool QuadsOverlap2D(const float *quadX, const float *quadY, const float *otherX, const float *otherY)
+{
+	// The bounding boxes are the projections onto the world axes
+	if ( MaxCorner(quadX) < MinCorner(otherX) || MaxCorner(otherX) < MinCorner(quadX) ||
+		 MaxCorner(quadY) < MinCorner(otherY) || MaxCorner(otherY) < MinCorner(quadY) )
+	{
+		return false;
+	}
+
+	return ( !HasSeparatingEdge(quadX, quadY, otherX, otherY) &&
+			 !HasSeparatingEdge(otherX, otherY, quadX, quadY) );
+}
+
+void BuildConvexHull2D(const std::vector<Vertex2D> &points, std::vector<Vertex2D> &hull)
+{
+	// Monotone chain, same as the hull baker
+	std::vector<Vertex2D> sorted(points);
+	std::sort(sorted.begin(), sorted.end(), IsVertexBefore);
+
+	hull.clear();
+	if (sorted.size() < 3)
+	{
+		hull = sorted;
+		return;
+	}
+
+	hull.resize(sorted.size() * 2);
+	int numVertices = 0;
+
+	// Lower half left to right, then the upper half back
+	for (size_t point = 0; point < sorted.size(); point++)
+	{
+		while (numVertices >= 2 && Cross(hull[numVertices - 2], hull[numVertices - 1], sorted[point]) <= 0.f)
+		{
+			numVertices--;
+		}
+		hull[numVertices++] = sorted[point];
+	}
+
+	const int lowerSize = numVertices + 1;
+	for (size_t point = sorted.size() - 1; point-- > 0; )
+	{
+		while (numVertices >= lowerSize && Cross(hull[numVertices - 2], hull[numVertices - 1], sorted[point]) <= 0.f)
+		{
+			numVertices--;
+		}
+		hull[numVertices++] = sorted[point];
+	}
+
+	// The last vertex is the first one again
+	hull.resize(numVertices - 1);
+}
+
+void PlaceHull2D(const SpriteQuad2D &quad, const Vertex2D *hull, int numVertices, Vertex2D *placed)
+{
+	const float rectangleX = quad.offsetX + quad.width * 0.5f;
+	const float rectangleY = quad.offsetY + quad.height * 0.5f;
+
+	const float originX = quad.positionX + quad.centerX;
+	const float originY = quad.positionY + quad.centerY;
+
+	const float c = quad.cosRotation;
+	const float s = quad.sinRotation;
+
+	for (int vertex = 0; vertex < numVertices; vertex++)
+	{
+		const float x = (rectangleX + hull[vertex].x) * quad.scaleX;
+		const float y = (rectangleY + hull[vertex].y) * quad.scaleY;
+
+		placed[vertex].x = c * x - s * y + originX;
+		placed[vertex].y = s * x + c * y + originY;
+	}
+}
+
+bool ConvexPolygonsOverlap2D(const Vertex2D *vertices, int numVertices, const Vertex2D *otherVertices, int otherNumVertices)
+{
+	return ( !HasSeparatingPolygonEdge(vertices, numVertices, otherVertices, otherNumVertices) &&
+			 !HasSeparatingPolygonEdge(otherVertices, otherNumVertices, vertices, numVertices) );
+}
+
+bool SweepConvexPolygons2D(const Vertex2D *vertices, int numVertices, float moveX, float moveY,
+	const Vertex2D *otherVertices, int otherNumVertices, float otherMoveX, float otherMoveY,
+	float &timeOfImpact)
+{
+	// Separating axis test along the move. Without any turning the edge normals stay the
+	// same all the way, and on each one the projections only meet for a single stretch of
+	// the move. The polygons touch from the latest start of those stretches on.
+	const float relativeX = moveX - otherMoveX;
+	const float relativeY = moveY - otherMoveY;
+
+	float enter = 0.f;
+	float exit = 1.f;
+	if ( !ClipSweepToPolygonEdges(vertices, numVertices, otherVertices, otherNumVertices, relativeX, relativeY, enter, exit) ||
+		 !ClipSweepToPolygonEdges(otherVertices, otherNumVertices, vertices, numVertices, -relativeX, -relativeY, enter, exit) )
+	{
+		return false;
+	}
+
+	timeOfImpact = enter;
+	return true;
+}
+
+float ConvexPolygonPointDistance2D(const Vertex2D *vertices, int numVertices, float x, float y)
+{
+	// Inside if the point lies on the same side of every edge, whichever way they wind
+	bool hasLeft = false;
+	bool hasRight = false;
+	float distanceSquared = 0.f;
+
+	for (int vertex = 0, previous = numVertices - 1; vertex < numVertices; previous = vertex++)
+	{
+		const Vertex2D &start = vertices[previous];
+		const Vertex2D &end = vertices[vertex];
+
+		const float side = (end.x - start.x) * (y - start.y) - (end.y - start.y) * (x - start.x);
+		hasLeft = hasLeft || (side > 0.f);
+		hasRight = hasRight || (side < 0.f);
+
+		const float edgeDistanceSquared = SegmentPointDistanceSquared(start, end, x, y);
+		distanceSquared = (vertex == 0) ? edgeDistanceSquared : Min2D(distanceSquared, edgeDistanceSquared);
+	}
+
+	if (!(hasLeft && hasRight))
+	{
+		return 0.f;
+	}
+
+	return sqrtf(distanceSquared);
+}
+
+bool RaycastConvexPolygon2D(const Vertex2D *vertices, int numVertices,
+	float startX, float startY, float endX, float endY, float &fraction)
+{
+	// A convex polygon is where its projections onto all of its edge normals overlap, so
+	// the segment is clipped to each of those bands in turn
+	const float deltaX = endX - startX;
+	const float deltaY = endY - startY;
+
+	float enter = 0.f;
+	float exit = 1.f;
+
+	for (int vertex = 0, previous = numVertices - 1; vertex < numVertices; previous = vertex++)
+	{
+		const float axisX = vertices[previous].y - vertices[vertex].y;
+		const float axisY = vertices[vertex].x - vertices[previous].x;
+
+		float minimum;
+		float maximum;
+		ProjectPolygon(vertices, numVertices, axisX, axisY, minimum, maximum);
+
+		const float start = startX * axisX + startY * axisY;
+		const float speed = deltaX * axisX + deltaY * axisY;
+
+		if (speed == 0.f)
+		{
+			if (start < minimum || start > maximum)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const float touch = (minimum - start) / speed;
+		const float leave = (maximum - start) / speed;
+		enter = Max2D( enter, Min2D(touch, leave) );
+		exit = Min2D( exit, Max2D(touch, leave) );
+
+		if (enter > exit)
+		{
+			return false;
+		}
+	}
+
+	fraction = enter;
+	return true;
+}
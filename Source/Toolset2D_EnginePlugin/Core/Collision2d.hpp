@@ -0,0 +1,50 @@
+#ifndef COLLISION_2D_HPP_INCLUDED
+#define COLLISION_2D_HPP_INCLUDED
+
+#include "SpriteQuads2d.hpp"
+
+#include <vector>
+
+struct Vertex2D
+{
+	float x;
+	float y;
+};
+
+// Corners of both quads are given in QuadCorner2D order, as written by SpriteQuads2D, so
+// each quad is a parallelogram whatever its rotation, scale or mirroring. Returns true if
+// the quads overlap or touch. The bounding boxes are compared first, then the quads are
+// projected onto the two edge normals of each one (separating axis test).
+bool QuadsOverlap2D(const float *quadX, const float *quadY, const float *otherX, const float *otherY);
+
+// Convex hull of the points without collinear vertices, wound counter clockwise with y
+// pointing up (clockwise on screen). Fewer than three points come back as they are.
+void BuildConvexHull2D(const std::vector<Vertex2D> &points, std::vector<Vertex2D> &hull);
+
+// Places a hull given relative to the center of the quad's rectangle the same way as the
+// quad's corners, 'placed' has room for numVertices vertices
+void PlaceHull2D(const SpriteQuad2D &quad, const Vertex2D *hull, int numVertices, Vertex2D *placed);
+
+// Convex polygons wound either way, with at least three vertices each. Returns true if they
+// overlap or touch, by projecting both onto the edge normals of each one.
+bool ConvexPolygonsOverlap2D(const Vertex2D *vertices, int numVertices, const Vertex2D *otherVertices, int otherNumVertices);
+
+// Same polygons, given where they end up after moving in a straight line by (moveX, moveY)
+// and (otherMoveX, otherMoveY) without turning. Returns true if they touch anywhere along
+// the way, with the fraction of the move at which they first do in 'timeOfImpact': zero if
+// they overlapped before moving, one if they only meet at the end.
+bool SweepConvexPolygons2D(const Vertex2D *vertices, int numVertices, float moveX, float moveY,
+	const Vertex2D *otherVertices, int otherNumVertices, float otherMoveX, float otherMoveY,
+	float &timeOfImpact);
+
+// Distance from the point to the closest edge of a convex polygon wound either way, zero if
+// the point is inside or on the polygon
+float ConvexPolygonPointDistance2D(const Vertex2D *vertices, int numVertices, float x, float y);
+
+// Returns true if the segment from the start to the end point touches the convex polygon,
+// with the fraction of the way to the end point at which it first does in 'fraction': zero
+// if the start point is inside already
+bool RaycastConvexPolygon2D(const Vertex2D *vertices, int numVertices,
+	float startX, float startY, float endX, float endY, float &fraction);
+
+#endif // COLLISION_2D_HPP_INCLUDED
@@ -0,0 +1,102 @@
+//=======
+//
+// Purpose: Collects contacts for deferred dispatch and tracks them across frames
+//
+//=======
+
+#include "ContactBuffer2d.hpp"
+
+#include <algorithm>
+
+void ContactBuffer2D::BeginFrame()
+{
+	m_previousContacts.swap(m_contacts);
+	m_contacts.clear();
+}
+
+void ContactBuffer2D::AddContact(long long idA, int proxyA, long long idB, int proxyB, float time)
+{
+	Contact2D contact;
+	if (idA < idB)
+	{
+		contact.idA = idA;
+		contact.idB = idB;
+		contact.proxyA = proxyA;
+		contact.proxyB = proxyB;
+	}
+	else
+	{
+		contact.idA = idB;
+		contact.idB = idA;
+		contact.proxyA = proxyB;
+		contact.proxyB = proxyA;
+	}
+	contact.state = CONTACT_BEGIN;
+	contact.time = time;
+
+	m_contacts.push_back(contact);
+}
+
+void ContactBuffer2D::EndFrame()
+{
+	std::sort(m_contacts.begin(), m_contacts.end(), IsLess);
+	m_contacts.erase(std::unique(m_contacts.begin(), m_contacts.end(), IsSamePair), m_contacts.end());
+
+	// Both lists are sorted, so walk them side by side
+	m_events.clear();
+
+	size_t index = 0;
+	size_t previousIndex = 0;
+	while (index < m_contacts.size() || previousIndex < m_previousContacts.size())
+	{
+		if (previousIndex == m_previousContacts.size() ||
+			(index < m_contacts.size() && IsLess(m_contacts[index], m_previousContacts[previousIndex])))
+		{
+			m_contacts[index].state = CONTACT_BEGIN;
+			m_events.push_back(m_contacts[index++]);
+		}
+		else if (index == m_contacts.size() ||
+				 IsLess(m_previousContacts[previousIndex], m_contacts[index]))
+		{
+			m_events.push_back(m_previousContacts[previousIndex++]);
+			m_events.back().state = CONTACT_END;
+		}
+		else
+		{
+			m_contacts[index].state = CONTACT_STAY;
+			m_events.push_back(m_contacts[index++]);
+			previousIndex++;
+		}
+	}
+}
+
+int ContactBuffer2D::GetNumEvents() const
+{
+	return static_cast<int>(m_events.size());
+}
+
+const Contact2D &ContactBuffer2D::GetEvent(int index) const
+{
+	return m_events[index];
+}
+
+void ContactBuffer2D::Clear()
+{
+	m_contacts.clear();
+	m_previousContacts.clear();
+	m_events.clear();
+}
+
+bool ContactBuffer2D::IsLess(const Contact2D &contact, const Contact2D &otherContact)
+{
+	if (contact.idA != otherContact.idA)
+	{
+		return (contact.idA < otherContact.idA);
+	}
+	return (contact.idB < otherContact.idB);
+}
+
+bool ContactBuffer2D::IsSamePair(const Contact2D &contact, const Contact2D &otherContact)
+{
+	return (contact.idA == otherContact.idA && contact.idB == otherContact.idB);
+}
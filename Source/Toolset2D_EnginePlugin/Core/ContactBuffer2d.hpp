@@ -0,0 +1,61 @@
+#ifndef CONTACT_BUFFER_2D_HPP_INCLUDED
+#define CONTACT_BUFFER_2D_HPP_INCLUDED
+
+#include <vector>
+
+enum ContactState2D
+{
+	CONTACT_BEGIN = 0,
+	CONTACT_STAY,
+	CONTACT_END
+};
+
+// One contact between two objects. 'idA' is always smaller than 'idB' and the proxies are
+// whatever handles the caller needs to find the objects again.
+struct Contact2D
+{
+	long long idA;
+	long long idB;
+	int proxyA;
+	int proxyB;
+	ContactState2D state;
+
+	// When during the frame the objects first touched, from zero to one. Ended contacts
+	// keep the time of the frame they were last found in.
+	float time;
+};
+
+// Collects the contacts found during one frame so they can be reported in a single pass
+// once all tests are done. Duplicates are dropped and every contact is compared with the
+// previous frame, so a persistent overlap is reported as one begin, a stay every frame
+// and one end once the objects separate.
+class ContactBuffer2D
+{
+public:
+	// Starts collecting a new frame, the current contacts become the previous ones
+	void BeginFrame();
+
+	// Order of the two objects doesn't matter. Contacts only found at the end of the frame
+	// have a time of one.
+	void AddContact(long long idA, int proxyA, long long idB, int proxyB, float time = 1.0f);
+
+	// Sorts out the contacts of this frame and builds the list of events
+	void EndFrame();
+
+	// Events are sorted by object IDs so they always come out in the same order
+	int GetNumEvents() const;
+	const Contact2D &GetEvent(int index) const;
+
+	// Forgets all contacts without reporting them as ended
+	void Clear();
+
+private:
+	static bool IsLess(const Contact2D &contact, const Contact2D &otherContact);
+	static bool IsSamePair(const Contact2D &contact, const Contact2D &otherContact);
+
+	std::vector<Contact2D> m_contacts;
+	std::vector<Contact2D> m_previousContacts;
+	std::vector<Contact2D> m_events;
+};
+
+#endif // CONTACT_BUFFER_2D_HPP_INCLUDED
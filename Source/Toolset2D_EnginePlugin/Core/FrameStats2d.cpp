@@ -0,0 +1,210 @@
+//=======
+//
+// Purpose: Collects per frame timings and counters of the 2D pipeline
+//
+//=======
+
+#include "FrameStats2d.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+	const char *kTimerNames[NUM_FRAME_TIMERS] =
+	{
+		"updateMs",
+		"animationMs",
+		"spritesMs",
+		"collisionMs",
+		"sortMs",
+		"renderMs"
+	};
+
+	const char *kCounterNames[NUM_FRAME_COUNTERS] =
+	{
+		"spritesUpdated",
+		"spritesCulled",
+		"pairTests",
+		"collisionHits",
+		"drawCalls",
+		"bytesUploaded",
+		"sheetLoads"
+	};
+}
+
+void FrameSample2D::Clear()
+{
+	for (int timer = 0; timer < NUM_FRAME_TIMERS; timer++)
+	{
+		milliseconds[timer] = 0.f;
+	}
+	for (int counter = 0; counter < NUM_FRAME_COUNTERS; counter++)
+	{
+		counters[counter] = 0;
+	}
+}
+
+FrameStats2D::FrameStats2D(int historySize)
+{
+	m_numCompletedFrames = 0;
+	m_currentFrame.Clear();
+	m_frameOpen = false;
+
+	SetHistorySize(historySize);
+}
+
+void FrameStats2D::SetHistorySize(int historySize)
+{
+	m_frames.resize( (historySize > 1) ? historySize : 1 );
+	m_newestFrame = -1;
+	m_numFrames = 0;
+}
+
+int FrameStats2D::GetHistorySize() const
+{
+	return static_cast<int>(m_frames.size());
+}
+
+void FrameStats2D::BeginFrame()
+{
+	EndFrame();
+	m_frameOpen = true;
+}
+
+bool FrameStats2D::EndFrame()
+{
+	if (!m_frameOpen)
+	{
+		return false;
+	}
+
+	const int historySize = static_cast<int>(m_frames.size());
+	m_newestFrame = (m_newestFrame + 1) % historySize;
+	m_frames[m_newestFrame] = m_currentFrame;
+	if (m_numFrames < historySize)
+	{
+		m_numFrames++;
+	}
+	m_numCompletedFrames++;
+
+	m_currentFrame.Clear();
+	m_frameOpen = false;
+
+	return true;
+}
+
+void FrameStats2D::AddTime(FrameTimer2D timer, float milliseconds)
+{
+	m_currentFrame.milliseconds[timer] += milliseconds;
+}
+
+void FrameStats2D::AddCount(FrameCounter2D counter, unsigned int count)
+{
+	m_currentFrame.counters[counter] += count;
+}
+
+int FrameStats2D::GetNumFrames() const
+{
+	return m_numFrames;
+}
+
+const FrameSample2D &FrameStats2D::GetFrame(int age) const
+{
+	const int historySize = static_cast<int>(m_frames.size());
+	return m_frames[(m_newestFrame - age + historySize) % historySize];
+}
+
+unsigned int FrameStats2D::GetFrameNumber(int age) const
+{
+	return m_numCompletedFrames - 1 - static_cast<unsigned int>(age);
+}
+
+float FrameStats2D::GetAverageTime(FrameTimer2D timer) const
+{
+	if (m_numFrames == 0)
+	{
+		return 0.f;
+	}
+
+	float total = 0.f;
+	for (int age = 0; age < m_numFrames; age++)
+	{
+		total += GetFrame(age).milliseconds[timer];
+	}
+	return total / static_cast<float>(m_numFrames);
+}
+
+float FrameStats2D::GetMaxTime(FrameTimer2D timer) const
+{
+	float maxTime = 0.f;
+	for (int age = 0; age < m_numFrames; age++)
+	{
+		if (GetFrame(age).milliseconds[timer] > maxTime)
+		{
+			maxTime = GetFrame(age).milliseconds[timer];
+		}
+	}
+	return maxTime;
+}
+
+float FrameStats2D::GetAverageCount(FrameCounter2D counter) const
+{
+	if (m_numFrames == 0)
+	{
+		return 0.f;
+	}
+
+	// Summed up in double, byte counts add up quickly
+	double total = 0.0;
+	for (int age = 0; age < m_numFrames; age++)
+	{
+		total += static_cast<double>(GetFrame(age).counters[counter]);
+	}
+	return static_cast<float>(total / static_cast<double>(m_numFrames));
+}
+
+const char *FrameStats2D::GetTimerName(FrameTimer2D timer)
+{
+	return kTimerNames[timer];
+}
+
+const char *FrameStats2D::GetCounterName(FrameCounter2D counter)
+{
+	return kCounterNames[counter];
+}
+
+void FrameStats2D::AppendCsvHeader(std::string &csv)
+{
+	csv += "frame";
+	for (int timer = 0; timer < NUM_FRAME_TIMERS; timer++)
+	{
+		csv += ',';
+		csv += kTimerNames[timer];
+	}
+	for (int counter = 0; counter < NUM_FRAME_COUNTERS; counter++)
+	{
+		csv += ',';
+		csv += kCounterNames[counter];
+	}
+	csv += '\n';
+}
+
+void FrameStats2D::AppendCsvLine(int age, std::string &csv) const
+{
+	const FrameSample2D &frame = GetFrame(age);
+
+	std::ostringstream line;
+	line << GetFrameNumber(age) << std::fixed << std::setprecision(3);
+	for (int timer = 0; timer < NUM_FRAME_TIMERS; timer++)
+	{
+		line << ',' << frame.milliseconds[timer];
+	}
+	for (int counter = 0; counter < NUM_FRAME_COUNTERS; counter++)
+	{
+		line << ',' << frame.counters[counter];
+	}
+	line << '\n';
+
+	csv += line.str();
+}
@@ -0,0 +1,88 @@
+#ifndef FRAME_STATS_2D_HPP_INCLUDED
+#define FRAME_STATS_2D_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+
+// Time spent in each part of the 2D pipeline, in milliseconds
+enum FrameTimer2D
+{
+	FRAME_TIMER_UPDATE = 0,
+	FRAME_TIMER_ANIMATION,
+	FRAME_TIMER_SPRITES,
+	FRAME_TIMER_COLLISION,
+	FRAME_TIMER_SORT,
+	FRAME_TIMER_RENDER,
+	NUM_FRAME_TIMERS
+};
+
+enum FrameCounter2D
+{
+	FRAME_COUNTER_SPRITES = 0,
+	FRAME_COUNTER_CULLED,
+	FRAME_COUNTER_PAIR_TESTS,
+	FRAME_COUNTER_HITS,
+	FRAME_COUNTER_DRAW_CALLS,
+	FRAME_COUNTER_BYTES_UPLOADED,
+	FRAME_COUNTER_SHEET_LOADS,
+	NUM_FRAME_COUNTERS
+};
+
+struct FrameSample2D
+{
+	void Clear();
+
+	float milliseconds[NUM_FRAME_TIMERS];
+	unsigned int counters[NUM_FRAME_COUNTERS];
+};
+
+// Timings and counters of the last few frames in a ring buffer. Everything added between
+// BeginFrame and EndFrame ends up in the same sample, anything added outside of a frame
+// goes into the next one.
+class FrameStats2D
+{
+public:
+	FrameStats2D(int historySize = 120);
+
+	// Changing the size drops the frames collected so far
+	void SetHistorySize(int historySize);
+	int GetHistorySize() const;
+
+	// Beginning a frame while another one is open ends that one first. EndFrame returns
+	// false if there was no frame to end.
+	void BeginFrame();
+	bool EndFrame();
+
+	void AddTime(FrameTimer2D timer, float milliseconds);
+	void AddCount(FrameCounter2D counter, unsigned int count = 1);
+
+	// Completed frames, zero being the most recent one. Frame numbers count every frame
+	// ever completed.
+	int GetNumFrames() const;
+	const FrameSample2D &GetFrame(int age) const;
+	unsigned int GetFrameNumber(int age) const;
+
+	// Over all the frames in the history, zero without any
+	float GetAverageTime(FrameTimer2D timer) const;
+	float GetMaxTime(FrameTimer2D timer) const;
+	float GetAverageCount(FrameCounter2D counter) const;
+
+	// Names are used as keys and CSV columns, timers end in 'Ms'
+	static const char *GetTimerName(FrameTimer2D timer);
+	static const char *GetCounterName(FrameCounter2D counter);
+
+	// One comma separated line each, ending with a line break
+	static void AppendCsvHeader(std::string &csv);
+	void AppendCsvLine(int age, std::string &csv) const;
+
+private:
+	std::vector<FrameSample2D> m_frames;
+	int m_newestFrame;
+	int m_numFrames;
+	unsigned int m_numCompletedFrames;
+
+	FrameSample2D m_currentFrame;
+	bool m_frameOpen;
+};
+
+#endif // FRAME_STATS_2D_HPP_INCLUDED
@@ -0,0 +1,92 @@
+//=======
+//
+// Purpose: Hash lookup of indices into caller owned arrays
+//
+//=======
+
+#include "HashIndex2d.hpp"
+
+#include <stddef.h>
+
+static const unsigned int kFnvPrime = 16777619u;
+
+unsigned int HashPath2D(const char *path, unsigned int hash)
+{
+	if (path == NULL)
+	{
+		return hash;
+	}
+
+	for (const unsigned char *character = reinterpret_cast<const unsigned char*>(path); *character != '\0'; character++)
+	{
+		unsigned char value = *character;
+		if (value >= 'A' && value <= 'Z')
+		{
+			value = static_cast<unsigned char>(value - 'A' + 'a');
+		}
+		else if (value == '\\')
+		{
+			value = '/';
+		}
+
+		hash = (hash ^ value) * kFnvPrime;
+	}
+
+	// Keep "a" + "bc" apart from "ab" + "c" when paths are chained
+	return (hash ^ 0xff) * kFnvPrime;
+}
+
+HashIndex2D::HashIndex2D(int numBuckets)
+{
+	int size = 1;
+	while (size < numBuckets)
+	{
+		size <<= 1;
+	}
+
+	m_buckets.assign(size, -1);
+	m_bucketMask = static_cast<unsigned int>(size - 1);
+}
+
+void HashIndex2D::Add(unsigned int hash, int index)
+{
+	if (index >= static_cast<int>(m_next.size()))
+	{
+		m_next.resize(index + 1, -1);
+	}
+
+	int &bucket = m_buckets[hash & m_bucketMask];
+	m_next[index] = bucket;
+	bucket = index;
+}
+
+void HashIndex2D::Remove(unsigned int hash, int index)
+{
+	int *link = &m_buckets[hash & m_bucketMask];
+	while (*link != -1)
+	{
+		if (*link == index)
+		{
+			*link = m_next[index];
+			m_next[index] = -1;
+			return;
+		}
+		link = &m_next[*link];
+	}
+}
+
+void HashIndex2D::Clear()
+{
+	m_buckets.assign(m_buckets.size(), -1);
+	m_next.clear();
+}
+
+int HashIndex2D::First(unsigned int hash) const
+{
+	return m_buckets[hash & m_bucketMask];
+}
+
+int HashIndex2D::Next(int index) const
+{
+	return m_next[index];
+}
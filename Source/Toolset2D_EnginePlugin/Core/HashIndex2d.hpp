@@ -0,0 +1,39 @@
+#ifndef HASH_INDEX_2D_HPP_INCLUDED
+#define HASH_INDEX_2D_HPP_INCLUDED
+
+#include <vector>
+
+// Hash of a file path that treats upper and lower case and both kinds of slashes as the
+// same, so the same file always ends up with the same hash. Pass the hash of a previous
+// path in 'hash' to combine several paths into one key.
+static const unsigned int kPathHashSeed2D = 2166136261u;
+unsigned int HashPath2D(const char *path, unsigned int hash = kPathHashSeed2D);
+
+// Maps hashes to indices into an array that is owned by the caller. Several indices can
+// share a hash, so the caller still has to check that the entry it finds is the one it
+// was looking for:
+//
+//   for (int index = hashIndex.First(hash); index != -1; index = hashIndex.Next(index))
+//
+// Indices are expected to be small and dense since the chains are stored per index.
+class HashIndex2D
+{
+public:
+	// 'numBuckets' is rounded up to a power of two
+	HashIndex2D(int numBuckets = 256);
+
+	void Add(unsigned int hash, int index);
+	void Remove(unsigned int hash, int index);
+	void Clear();
+
+	// Returns -1 at the end of the chain
+	int First(unsigned int hash) const;
+	int Next(int index) const;
+
+private:
+	std::vector<int> m_buckets;
+	std::vector<int> m_next;
+	unsigned int m_bucketMask;
+};
+
+#endif // HASH_INDEX_2D_HPP_INCLUDED
@@ -0,0 +1,880 @@
+//=======
+//
+// Purpose: Uniform grid broadphase used to find potentially colliding sprites
+//
+//=======
+
+#include "SpatialHash2d.hpp"
+
+#include <math.h>
+#include <stddef.h>
+
+namespace
+{
+	// Boxes that would be inserted into more cells than this are tested against everything instead
+	const int kMaxCellsPerProxy = 64;
+
+	const int kInitialTableSize = 256;
+
+	// Keeps cell coordinates well inside the range of an int even for bogus positions
+	const float kMaxCellCoordinate = 1000000.0f;
+
+	inline int ToCell(float value, float inverseCellSize)
+	{
+		float cell = floorf(value * inverseCellSize);
+		if (cell > kMaxCellCoordinate)
+		{
+			cell = kMaxCellCoordinate;
+		}
+		else if (!(cell >= -kMaxCellCoordinate))
+		{
+			// also catches NaN
+			cell = -kMaxCellCoordinate;
+		}
+		return static_cast<int>(cell);
+	}
+
+	inline int Max(int a, int b)
+	{
+		return (a > b) ? a : b;
+	}
+
+	inline int Abs(int a)
+	{
+		return (a < 0) ? -a : a;
+	}
+
+	inline bool IsInRange(int cellX, int cellY, int minX, int minY, int maxX, int maxY)
+	{
+		return (cellX >= minX && cellX <= maxX && cellY >= minY && cellY <= maxY);
+	}
+
+	// Narrows [enter, exit] down to where the moving coordinate is within [minimum, maximum]
+	inline bool ClipToSlab(float start, float delta, float minimum, float maximum, float &enter, float &exit)
+	{
+		if (delta == 0.0f)
+		{
+			return (start >= minimum && start <= maximum);
+		}
+
+		float near = (minimum - start) / delta;
+		float far = (maximum - start) / delta;
+		if (near > far)
+		{
+			const float swap = near;
+			near = far;
+			far = swap;
+		}
+
+		enter = (near > enter) ? near : enter;
+		exit = (far < exit) ? far : exit;
+		return (enter <= exit);
+	}
+}
+
+bool Aabb2D::OverlapsSegment(float startX, float startY, float deltaX, float deltaY) const
+{
+	float enter = 0.0f;
+	float exit = 1.0f;
+	return ( ClipToSlab(startX, deltaX, minX, maxX, enter, exit) &&
+			 ClipToSlab(startY, deltaY, minY, maxY, enter, exit) );
+}
+
+SpatialHash2D::SpatialHash2D(float cellSize)
+{
+	m_freeProxy = -1;
+	m_numProxies = 0;
+	m_numOccupiedBuckets = 0;
+	m_cellSize = 0.0f;
+	m_inverseCellSize = 0.0f;
+	m_table.resize(kInitialTableSize, -1);
+
+	SetCellSize(cellSize);
+}
+
+void SpatialHash2D::SetCellSize(float cellSize)
+{
+	if (!(cellSize > 1.0f))
+	{
+		cellSize = 1.0f;
+	}
+
+	if (cellSize != m_cellSize)
+	{
+		m_cellSize = cellSize;
+		m_inverseCellSize = 1.0f / cellSize;
+		Rebuild();
+	}
+}
+
+float SpatialHash2D::GetCellSize() const
+{
+	return m_cellSize;
+}
+
+bool SpatialHash2D::ShouldCollide(unsigned int layerA, unsigned int maskA, unsigned int layerB, unsigned int maskB)
+{
+	return ((layerA & maskB) != 0 && (layerB & maskA) != 0);
+}
+
+int SpatialHash2D::CreateProxy(const Aabb2D &box, void *userData, unsigned int layer, unsigned int mask)
+{
+	int proxyIndex = m_freeProxy;
+	if (proxyIndex != -1)
+	{
+		m_freeProxy = m_proxies[proxyIndex].nextFree;
+	}
+	else
+	{
+		proxyIndex = static_cast<int>(m_proxies.size());
+		m_proxies.push_back(Proxy());
+	}
+
+	Proxy &proxy = m_proxies[proxyIndex];
+	proxy.box = box;
+	proxy.userData = userData;
+	proxy.filter = AcquireFilter(layer, mask);
+	proxy.nextFree = -1;
+	ComputeCellRange(box, proxy.cellMinX, proxy.cellMinY, proxy.cellMaxX, proxy.cellMaxY);
+	proxy.oversized = IsOversized(proxy.cellMinX, proxy.cellMinY, proxy.cellMaxX, proxy.cellMaxY);
+
+	InsertIntoCells(proxyIndex);
+	m_numProxies++;
+
+	return proxyIndex;
+}
+
+void SpatialHash2D::UpdateProxy(int proxyIndex, const Aabb2D &box)
+{
+	Proxy &proxy = m_proxies[proxyIndex];
+	proxy.box = box;
+
+	int minX, minY, maxX, maxY;
+	ComputeCellRange(box, minX, minY, maxX, maxY);
+
+	// Most sprites stay within the same cells from frame to frame, so only re-bucket when needed
+	if (minX != proxy.cellMinX || minY != proxy.cellMinY ||
+		maxX != proxy.cellMaxX || maxY != proxy.cellMaxY)
+	{
+		RemoveFromCells(proxyIndex);
+
+		proxy.cellMinX = minX;
+		proxy.cellMinY = minY;
+		proxy.cellMaxX = maxX;
+		proxy.cellMaxY = maxY;
+		proxy.oversized = IsOversized(minX, minY, maxX, maxY);
+
+		InsertIntoCells(proxyIndex);
+
+		CompactIfNeeded();
+	}
+}
+
+void SpatialHash2D::SetProxyFilter(int proxyIndex, unsigned int layer, unsigned int mask)
+{
+	Proxy &proxy = m_proxies[proxyIndex];
+
+	const Filter &filter = m_filters[proxy.filter];
+	if (filter.layer == layer && filter.mask == mask)
+	{
+		return;
+	}
+
+	RemoveFromCells(proxyIndex);
+	ReleaseFilter(proxy.filter);
+
+	proxy.filter = AcquireFilter(layer, mask);
+	InsertIntoCells(proxyIndex);
+}
+
+void SpatialHash2D::DestroyProxy(int proxyIndex)
+{
+	if (proxyIndex < 0 || proxyIndex >= static_cast<int>(m_proxies.size()))
+	{
+		return;
+	}
+
+	Proxy &proxy = m_proxies[proxyIndex];
+	if (proxy.userData == NULL)
+	{
+		return;
+	}
+
+	RemoveFromCells(proxyIndex);
+	ReleaseFilter(proxy.filter);
+
+	proxy.userData = NULL;
+	proxy.nextFree = m_freeProxy;
+	m_freeProxy = proxyIndex;
+	m_numProxies--;
+
+	CompactIfNeeded();
+}
+
+void SpatialHash2D::Clear()
+{
+	m_proxies.clear();
+	m_freeProxy = -1;
+	m_numProxies = 0;
+	m_filters.clear();
+
+	m_buckets.clear();
+	m_numOccupiedBuckets = 0;
+	m_oversized.clear();
+
+	m_table.assign(kInitialTableSize, -1);
+}
+
+void *SpatialHash2D::GetUserData(int proxyIndex) const
+{
+	void *userData = NULL;
+	if (proxyIndex >= 0 && proxyIndex < static_cast<int>(m_proxies.size()))
+	{
+		userData = m_proxies[proxyIndex].userData;
+	}
+	return userData;
+}
+
+int SpatialHash2D::GetNumProxies() const
+{
+	return m_numProxies;
+}
+
+void SpatialHash2D::FindPairs(std::vector<Pair> &pairs) const
+{
+	pairs.clear();
+
+	const int numBuckets = static_cast<int>(m_buckets.size());
+	for (int bucketIndex = 0; bucketIndex < numBuckets; bucketIndex++)
+	{
+		const Bucket &bucket = m_buckets[bucketIndex];
+		if (bucket.proxies.empty())
+		{
+			continue;
+		}
+
+		const Filter &filter = m_filters[bucket.filter];
+		if (filter.collidesWithSelf)
+		{
+			AddBucketPairs(bucket, pairs);
+		}
+
+		// Buckets of filter groups that can't collide with this one are never visited
+		for (size_t i = 0; i < filter.collidesWith.size(); i++)
+		{
+			const int otherBucketIndex = FindBucket(bucket.cellX, bucket.cellY, filter.collidesWith[i]);
+			if (otherBucketIndex != -1)
+			{
+				AddBucketPairs(bucket, m_buckets[otherBucketIndex], pairs);
+			}
+		}
+	}
+
+	const int numOversized = static_cast<int>(m_oversized.size());
+	for (int i = 0; i < numOversized; i++)
+	{
+		const int proxyIndexA = m_oversized[i];
+		const Proxy &proxyA = m_proxies[proxyIndexA];
+
+		const int numProxies = static_cast<int>(m_proxies.size());
+		for (int proxyIndexB = 0; proxyIndexB < numProxies; proxyIndexB++)
+		{
+			const Proxy &proxyB = m_proxies[proxyIndexB];
+
+			// Pairs of two oversized proxies are only reported by the lower index
+			if (proxyB.userData == NULL ||
+				proxyIndexB == proxyIndexA ||
+				(proxyB.oversized && proxyIndexB < proxyIndexA) ||
+				!FiltersCollide(proxyA.filter, proxyB.filter))
+			{
+				continue;
+			}
+
+			if (proxyA.box.Overlaps(proxyB.box))
+			{
+				Pair pair;
+				pair.proxyA = proxyIndexA;
+				pair.proxyB = proxyIndexB;
+				pairs.push_back(pair);
+			}
+		}
+	}
+}
+
+void SpatialHash2D::QueryBox(const Aabb2D &box, unsigned int layerMask, std::vector<int> &proxies) const
+{
+	// Nothing in any of the layers, oversized proxies included
+	const int numQueryFilters = CountQueryFilters(layerMask);
+	if (numQueryFilters == 0)
+	{
+		return;
+	}
+
+	int minX, minY, maxX, maxY;
+	ComputeCellRange(box, minX, minY, maxX, maxY);
+
+	// Looking up every cell of a large box costs more than going through the buckets
+	const float numLookups = static_cast<float>(maxX - minX + 1) * static_cast<float>(maxY - minY + 1) *
+		static_cast<float>(numQueryFilters);
+	const bool lookUpCells = (numLookups <= static_cast<float>(m_numOccupiedBuckets));
+
+	const int numFilters = static_cast<int>(m_filters.size());
+	const int numBuckets = static_cast<int>(m_buckets.size());
+	int cellX = minX;
+	int cellY = minY;
+	int filterIndex = 0;
+	int bucketIndex = 0;
+
+	while (true)
+	{
+		// Either the next filter of the next cell in the box, or the next bucket in the box
+		const Bucket *bucket = NULL;
+		if (lookUpCells)
+		{
+			if (cellY > maxY)
+			{
+				break;
+			}
+
+			const Filter &filter = m_filters[filterIndex];
+			if (filter.numProxies > 0 && (filter.layer & layerMask) != 0)
+			{
+				const int foundBucket = FindBucket(cellX, cellY, filterIndex);
+				if (foundBucket != -1)
+				{
+					bucket = &m_buckets[foundBucket];
+				}
+			}
+
+			if (++filterIndex == numFilters)
+			{
+				filterIndex = 0;
+				if (++cellX > maxX)
+				{
+					cellX = minX;
+					cellY++;
+				}
+			}
+		}
+		else
+		{
+			if (bucketIndex == numBuckets)
+			{
+				break;
+			}
+
+			const Bucket &nextBucket = m_buckets[bucketIndex++];
+			if ( (m_filters[nextBucket.filter].layer & layerMask) != 0 &&
+				 IsInRange(nextBucket.cellX, nextBucket.cellY, minX, minY, maxX, maxY) )
+			{
+				bucket = &nextBucket;
+			}
+		}
+
+		if (bucket == NULL)
+		{
+			continue;
+		}
+
+		for (size_t i = 0; i < bucket->proxies.size(); i++)
+		{
+			const int proxyIndex = bucket->proxies[i];
+			const Proxy &proxy = m_proxies[proxyIndex];
+
+			// Same as for pairs, a proxy is only reported from the first cell it shares with the box
+			if (Max(proxy.cellMinX, minX) == bucket->cellX &&
+				Max(proxy.cellMinY, minY) == bucket->cellY &&
+				proxy.box.Overlaps(box))
+			{
+				proxies.push_back(proxyIndex);
+			}
+		}
+	}
+
+	AddOversizedQueryProxies(box, layerMask, proxies);
+}
+
+void SpatialHash2D::QuerySegment(float startX, float startY, float endX, float endY, unsigned int layerMask, std::vector<int> &proxies) const
+{
+	const int numFilters = CountQueryFilters(layerMask);
+	if (numFilters == 0)
+	{
+		return;
+	}
+
+	const float deltaX = endX - startX;
+	const float deltaY = endY - startY;
+
+	Aabb2D box;
+	box.minX = (startX < endX) ? startX : endX;
+	box.minY = (startY < endY) ? startY : endY;
+	box.maxX = (startX < endX) ? endX : startX;
+	box.maxY = (startY < endY) ? endY : startY;
+
+	int cellX = ToCell(startX, m_inverseCellSize);
+	int cellY = ToCell(startY, m_inverseCellSize);
+	const int endCellX = ToCell(endX, m_inverseCellSize);
+	const int endCellY = ToCell(endY, m_inverseCellSize);
+	const int numSteps = Abs(endCellX - cellX) + Abs(endCellY - cellY);
+
+	// Long segments through a sparse grid go through the buckets in the segment's box instead
+	if ( static_cast<float>(numSteps + 1) * static_cast<float>(numFilters) > static_cast<float>(m_numOccupiedBuckets) )
+	{
+		const size_t begin = proxies.size();
+		QueryBox(box, layerMask, proxies);
+
+		size_t numHits = begin;
+		for (size_t i = begin; i < proxies.size(); i++)
+		{
+			if (m_proxies[proxies[i]].box.OverlapsSegment(startX, startY, deltaX, deltaY))
+			{
+				proxies[numHits++] = proxies[i];
+			}
+		}
+		proxies.resize(numHits);
+		return;
+	}
+
+	// Walk the cells along the segment in order, always crossing into the cell whose border
+	// comes up first
+	const int stepX = (endCellX > cellX) ? 1 : -1;
+	const int stepY = (endCellY > cellY) ? 1 : -1;
+	const float nextBorderX = static_cast<float>( (stepX > 0) ? cellX + 1 : cellX ) * m_cellSize;
+	const float nextBorderY = static_cast<float>( (stepY > 0) ? cellY + 1 : cellY ) * m_cellSize;
+	float nextCrossingX = (deltaX != 0.0f) ? (nextBorderX - startX) / deltaX : 2.0f;
+	float nextCrossingY = (deltaY != 0.0f) ? (nextBorderY - startY) / deltaY : 2.0f;
+	const float crossingStepX = (deltaX != 0.0f) ? m_cellSize / fabsf(deltaX) : 0.0f;
+	const float crossingStepY = (deltaY != 0.0f) ? m_cellSize / fabsf(deltaY) : 0.0f;
+
+	int stepsLeftX = Abs(endCellX - cellX);
+	int stepsLeftY = Abs(endCellY - cellY);
+	int previousCellX = 0;
+	int previousCellY = 0;
+	bool hasPreviousCell = false;
+
+	while (true)
+	{
+		const int numFilterSlots = static_cast<int>(m_filters.size());
+		for (int filterIndex = 0; filterIndex < numFilterSlots; filterIndex++)
+		{
+			const Filter &filter = m_filters[filterIndex];
+			if (filter.numProxies == 0 || (filter.layer & layerMask) == 0)
+			{
+				continue;
+			}
+
+			const int bucketIndex = FindBucket(cellX, cellY, filterIndex);
+			if (bucketIndex == -1)
+			{
+				continue;
+			}
+
+			const Bucket &bucket = m_buckets[bucketIndex];
+			for (size_t i = 0; i < bucket.proxies.size(); i++)
+			{
+				const int proxyIndex = bucket.proxies[i];
+				const Proxy &proxy = m_proxies[proxyIndex];
+
+				// A segment runs through the rectangle of cells of a proxy in one go, so
+				// the proxy has already been seen if the previous cell was one of them
+				if ( hasPreviousCell &&
+					 IsInRange(previousCellX, previousCellY, proxy.cellMinX, proxy.cellMinY, proxy.cellMaxX, proxy.cellMaxY) )
+				{
+					continue;
+				}
+
+				if (proxy.box.OverlapsSegment(startX, startY, deltaX, deltaY))
+				{
+					proxies.push_back(proxyIndex);
+				}
+			}
+		}
+
+		if (stepsLeftX == 0 && stepsLeftY == 0)
+		{
+			break;
+		}
+
+		previousCellX = cellX;
+		previousCellY = cellY;
+		hasPreviousCell = true;
+
+		// Rounding can't take the walk past the end cell
+		if (stepsLeftY == 0 || (stepsLeftX > 0 && nextCrossingX < nextCrossingY))
+		{
+			cellX += stepX;
+			nextCrossingX += crossingStepX;
+			stepsLeftX--;
+		}
+		else
+		{
+			cellY += stepY;
+			nextCrossingY += crossingStepY;
+			stepsLeftY--;
+		}
+	}
+
+	// Oversized proxies aren't in any cell, so they are checked against the segment directly
+	for (size_t i = 0; i < m_oversized.size(); i++)
+	{
+		const Proxy &proxy = m_proxies[m_oversized[i]];
+		if ( (m_filters[proxy.filter].layer & layerMask) != 0 &&
+			 proxy.box.OverlapsSegment(startX, startY, deltaX, deltaY) )
+		{
+			proxies.push_back(m_oversized[i]);
+		}
+	}
+}
+
+int SpatialHash2D::CountQueryFilters(unsigned int layerMask) const
+{
+	int numFilters = 0;
+	for (size_t filterIndex = 0; filterIndex < m_filters.size(); filterIndex++)
+	{
+		if (m_filters[filterIndex].numProxies > 0 && (m_filters[filterIndex].layer & layerMask) != 0)
+		{
+			numFilters++;
+		}
+	}
+	return numFilters;
+}
+
+void SpatialHash2D::AddOversizedQueryProxies(const Aabb2D &box, unsigned int layerMask, std::vector<int> &proxies) const
+{
+	for (size_t i = 0; i < m_oversized.size(); i++)
+	{
+		const Proxy &proxy = m_proxies[m_oversized[i]];
+		if ((m_filters[proxy.filter].layer & layerMask) != 0 && proxy.box.Overlaps(box))
+		{
+			proxies.push_back(m_oversized[i]);
+		}
+	}
+}
+
+void SpatialHash2D::AddBucketPairs(const Bucket &bucket, std::vector<Pair> &pairs) const
+{
+	const int numProxies = static_cast<int>(bucket.proxies.size());
+	for (int i = 0; i < numProxies; i++)
+	{
+		const int proxyIndexA = bucket.proxies[i];
+		const Proxy &proxyA = m_proxies[proxyIndexA];
+
+		for (int j = i + 1; j < numProxies; j++)
+		{
+			const int proxyIndexB = bucket.proxies[j];
+			const Proxy &proxyB = m_proxies[proxyIndexB];
+
+			// Two proxies can share several cells. Only report the pair from the cell at the
+			// minimum corner of the overlapping cell range so that it shows up exactly once.
+			if (Max(proxyA.cellMinX, proxyB.cellMinX) != bucket.cellX ||
+				Max(proxyA.cellMinY, proxyB.cellMinY) != bucket.cellY)
+			{
+				continue;
+			}
+
+			if (proxyA.box.Overlaps(proxyB.box))
+			{
+				Pair pair;
+				pair.proxyA = proxyIndexA;
+				pair.proxyB = proxyIndexB;
+				pairs.push_back(pair);
+			}
+		}
+	}
+}
+
+void SpatialHash2D::AddBucketPairs(const Bucket &bucket, const Bucket &otherBucket, std::vector<Pair> &pairs) const
+{
+	const int numProxies = static_cast<int>(bucket.proxies.size());
+	const int numOtherProxies = static_cast<int>(otherBucket.proxies.size());
+	for (int i = 0; i < numProxies; i++)
+	{
+		const int proxyIndexA = bucket.proxies[i];
+		const Proxy &proxyA = m_proxies[proxyIndexA];
+
+		for (int j = 0; j < numOtherProxies; j++)
+		{
+			const int proxyIndexB = otherBucket.proxies[j];
+			const Proxy &proxyB = m_proxies[proxyIndexB];
+
+			if (Max(proxyA.cellMinX, proxyB.cellMinX) != bucket.cellX ||
+				Max(proxyA.cellMinY, proxyB.cellMinY) != bucket.cellY)
+			{
+				continue;
+			}
+
+			if (proxyA.box.Overlaps(proxyB.box))
+			{
+				Pair pair;
+				pair.proxyA = proxyIndexA;
+				pair.proxyB = proxyIndexB;
+				pairs.push_back(pair);
+			}
+		}
+	}
+}
+
+void SpatialHash2D::ComputeCellRange(const Aabb2D &box, int &minX, int &minY, int &maxX, int &maxY) const
+{
+	minX = ToCell(box.minX, m_inverseCellSize);
+	minY = ToCell(box.minY, m_inverseCellSize);
+	maxX = ToCell(box.maxX, m_inverseCellSize);
+	maxY = ToCell(box.maxY, m_inverseCellSize);
+
+	if (maxX < minX)
+	{
+		maxX = minX;
+	}
+
+	if (maxY < minY)
+	{
+		maxY = minY;
+	}
+}
+
+bool SpatialHash2D::IsOversized(int minX, int minY, int maxX, int maxY) const
+{
+	const float cellsX = static_cast<float>(maxX - minX + 1);
+	const float cellsY = static_cast<float>(maxY - minY + 1);
+	return (cellsX * cellsY > static_cast<float>(kMaxCellsPerProxy));
+}
+
+int SpatialHash2D::AcquireFilter(unsigned int layer, unsigned int mask)
+{
+	int freeFilter = -1;
+
+	const int numFilters = static_cast<int>(m_filters.size());
+	for (int filterIndex = 0; filterIndex < numFilters; filterIndex++)
+	{
+		Filter &filter = m_filters[filterIndex];
+		if (filter.layer == layer && filter.mask == mask)
+		{
+			filter.numProxies++;
+			return filterIndex;
+		}
+
+		if (filter.numProxies == 0 && freeFilter == -1)
+		{
+			freeFilter = filterIndex;
+		}
+	}
+
+	// Any buckets left over from a recycled filter are empty, so they can be reused as is
+	if (freeFilter == -1)
+	{
+		freeFilter = numFilters;
+		m_filters.push_back(Filter());
+	}
+
+	Filter &filter = m_filters[freeFilter];
+	filter.layer = layer;
+	filter.mask = mask;
+	filter.numProxies = 1;
+
+	UpdateFilterLinks();
+
+	return freeFilter;
+}
+
+void SpatialHash2D::ReleaseFilter(int filterIndex)
+{
+	m_filters[filterIndex].numProxies--;
+}
+
+void SpatialHash2D::UpdateFilterLinks()
+{
+	const int numFilters = static_cast<int>(m_filters.size());
+	for (int filterIndex = 0; filterIndex < numFilters; filterIndex++)
+	{
+		Filter &filter = m_filters[filterIndex];
+		filter.collidesWithSelf = FiltersCollide(filterIndex, filterIndex);
+		filter.collidesWith.clear();
+
+		for (int otherIndex = filterIndex + 1; otherIndex < numFilters; otherIndex++)
+		{
+			if (FiltersCollide(filterIndex, otherIndex))
+			{
+				filter.collidesWith.push_back(otherIndex);
+			}
+		}
+	}
+}
+
+bool SpatialHash2D::FiltersCollide(int filterA, int filterB) const
+{
+	return ShouldCollide(m_filters[filterA].layer, m_filters[filterA].mask,
+		m_filters[filterB].layer, m_filters[filterB].mask);
+}
+
+void SpatialHash2D::InsertIntoCells(int proxyIndex)
+{
+	const Proxy &proxy = m_proxies[proxyIndex];
+
+	if (proxy.oversized)
+	{
+		m_oversized.push_back(proxyIndex);
+		return;
+	}
+
+	for (int cellY = proxy.cellMinY; cellY <= proxy.cellMaxY; cellY++)
+	{
+		for (int cellX = proxy.cellMinX; cellX <= proxy.cellMaxX; cellX++)
+		{
+			Bucket &bucket = m_buckets[FindOrCreateBucket(cellX, cellY, proxy.filter)];
+			if (bucket.proxies.empty())
+			{
+				m_numOccupiedBuckets++;
+			}
+			bucket.proxies.push_back(proxyIndex);
+		}
+	}
+}
+
+void SpatialHash2D::RemoveFromCells(int proxyIndex)
+{
+	const Proxy &proxy = m_proxies[proxyIndex];
+
+	if (proxy.oversized)
+	{
+		for (size_t i = 0; i < m_oversized.size(); i++)
+		{
+			if (m_oversized[i] == proxyIndex)
+			{
+				m_oversized[i] = m_oversized.back();
+				m_oversized.pop_back();
+				break;
+			}
+		}
+		return;
+	}
+
+	for (int cellY = proxy.cellMinY; cellY <= proxy.cellMaxY; cellY++)
+	{
+		for (int cellX = proxy.cellMinX; cellX <= proxy.cellMaxX; cellX++)
+		{
+			const int bucketIndex = FindBucket(cellX, cellY, proxy.filter);
+			if (bucketIndex == -1)
+			{
+				continue;
+			}
+
+			std::vector<int> &proxies = m_buckets[bucketIndex].proxies;
+			for (size_t i = 0; i < proxies.size(); i++)
+			{
+				if (proxies[i] == proxyIndex)
+				{
+					proxies[i] = proxies.back();
+					proxies.pop_back();
+
+					if (proxies.empty())
+					{
+						m_numOccupiedBuckets--;
+					}
+					break;
+				}
+			}
+		}
+	}
+}
+
+unsigned int SpatialHash2D::HashCell(int cellX, int cellY, int filter)
+{
+	return (static_cast<unsigned int>(cellX) * 73856093u) ^
+		(static_cast<unsigned int>(cellY) * 19349663u) ^
+		(static_cast<unsigned int>(filter) * 83492791u);
+}
+
+int SpatialHash2D::FindBucket(int cellX, int cellY, int filter) const
+{
+	const unsigned int mask = static_cast<unsigned int>(m_table.size()) - 1;
+	unsigned int slot = HashCell(cellX, cellY, filter) & mask;
+
+	while (m_table[slot] != -1)
+	{
+		const Bucket &bucket = m_buckets[m_table[slot]];
+		if (bucket.cellX == cellX && bucket.cellY == cellY && bucket.filter == filter)
+		{
+			return m_table[slot];
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	return -1;
+}
+
+int SpatialHash2D::FindOrCreateBucket(int cellX, int cellY, int filter)
+{
+	int bucketIndex = FindBucket(cellX, cellY, filter);
+	if (bucketIndex != -1)
+	{
+		return bucketIndex;
+	}
+
+	// Keep the load factor at or below one half
+	if ((m_buckets.size() + 1) * 2 > m_table.size())
+	{
+		GrowTable();
+	}
+
+	bucketIndex = static_cast<int>(m_buckets.size());
+	m_buckets.push_back(Bucket());
+	m_buckets.back().cellX = cellX;
+	m_buckets.back().cellY = cellY;
+	m_buckets.back().filter = filter;
+
+	const unsigned int mask = static_cast<unsigned int>(m_table.size()) - 1;
+	unsigned int slot = HashCell(cellX, cellY, filter) & mask;
+	while (m_table[slot] != -1)
+	{
+		slot = (slot + 1) & mask;
+	}
+	m_table[slot] = bucketIndex;
+
+	return bucketIndex;
+}
+
+void SpatialHash2D::GrowTable()
+{
+	m_table.assign(m_table.size() * 2, -1);
+
+	const unsigned int mask = static_cast<unsigned int>(m_table.size()) - 1;
+	for (size_t bucketIndex = 0; bucketIndex < m_buckets.size(); bucketIndex++)
+	{
+		const Bucket &bucket = m_buckets[bucketIndex];
+		unsigned int slot = HashCell(bucket.cellX, bucket.cellY, bucket.filter) & mask;
+		while (m_table[slot] != -1)
+		{
+			slot = (slot + 1) & mask;
+		}
+		m_table[slot] = static_cast<int>(bucketIndex);
+	}
+}
+
+void SpatialHash2D::CompactIfNeeded()
+{
+	// Don't let cells that sprites have passed through pile up forever
+	const int numBuckets = static_cast<int>(m_buckets.size());
+	if (numBuckets > kInitialTableSize && numBuckets > m_numOccupiedBuckets * 4)
+	{
+		Rebuild();
+	}
+}
+
+void SpatialHash2D::Rebuild()
+{
+	m_buckets.clear();
+	m_numOccupiedBuckets = 0;
+	m_oversized.clear();
+	m_table.assign(kInitialTableSize, -1);
+
+	for (size_t proxyIndex = 0; proxyIndex < m_proxies.size(); proxyIndex++)
+	{
+		Proxy &proxy = m_proxies[proxyIndex];
+		if (proxy.userData != NULL)
+		{
+			ComputeCellRange(proxy.box, proxy.cellMinX, proxy.cellMinY, proxy.cellMaxX, proxy.cellMaxY);
+			proxy.oversized = IsOversized(proxy.cellMinX, proxy.cellMinY, proxy.cellMaxX, proxy.cellMaxY);
+			InsertIntoCells(static_cast<int>(proxyIndex));
+		}
+	}
+}
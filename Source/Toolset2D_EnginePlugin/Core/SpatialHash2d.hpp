@@ -0,0 +1,153 @@
+#ifndef SPATIAL_HASH_2D_HPP_INCLUDED
+#define SPATIAL_HASH_2D_HPP_INCLUDED
+
+#include <vector>
+
+// Axis aligned box in 2D. Kept free of any engine types so that the broadphase can be
+// used (and profiled) outside of the engine.
+struct Aabb2D
+{
+	float minX;
+	float minY;
+	float maxX;
+	float maxY;
+
+	inline bool Overlaps(const Aabb2D &other) const
+	{
+		return (minX <= other.maxX && other.minX <= maxX &&
+				minY <= other.maxY && other.minY <= maxY);
+	}
+
+	// True if the segment from the start point to the start plus (deltaX, deltaY) touches the box
+	bool OverlapsSegment(float startX, float startY, float deltaX, float deltaY) const;
+};
+
+// Uniform grid broadphase backed by a hash of the occupied cells. Every proxy is stored
+// in each cell that its bounding box touches and candidate pairs are only generated for
+// proxies that share a cell. Proxies are updated incrementally and only re-bucketed when
+// the range of cells they touch actually changes.
+//
+// Every proxy also carries a collision layer and mask. Proxies with the same layer/mask
+// pair share a filter group and each cell keeps a separate bucket per group, so proxies
+// from groups that can't collide with each other are never even looked at together.
+class SpatialHash2D
+{
+public:
+	struct Pair
+	{
+		int proxyA;
+		int proxyB;
+	};
+
+	SpatialHash2D(float cellSize = 128.0f);
+
+	// Changing the cell size re-buckets every proxy
+	void SetCellSize(float cellSize);
+	float GetCellSize() const;
+
+	// Two proxies collide if each one's layer is in the other one's mask
+	static bool ShouldCollide(unsigned int layerA, unsigned int maskA, unsigned int layerB, unsigned int maskB);
+
+	// 'userData' must not be NULL
+	int CreateProxy(const Aabb2D &box, void *userData, unsigned int layer = 1, unsigned int mask = 0xFFFFFFFF);
+	void UpdateProxy(int proxy, const Aabb2D &box);
+	void SetProxyFilter(int proxy, unsigned int layer, unsigned int mask);
+	void DestroyProxy(int proxy);
+	void Clear();
+
+	// Returns NULL if the proxy has been destroyed
+	void *GetUserData(int proxy) const;
+	int GetNumProxies() const;
+
+	// Fills 'pairs' with every pair of proxies whose boxes overlap and whose filters
+	// collide. Each pair is only reported once even if the proxies share more than one cell.
+	void FindPairs(std::vector<Pair> &pairs) const;
+
+	// Append every proxy whose layer shares a bit with 'layerMask' and whose box is touched by
+	// the box or segment. Each proxy is only appended once, and nothing is allocated beyond
+	// what 'proxies' needs to grow. Only the cells along the way are looked at, unless there
+	// are fewer buckets in use than that.
+	void QueryBox(const Aabb2D &box, unsigned int layerMask, std::vector<int> &proxies) const;
+	void QuerySegment(float startX, float startY, float endX, float endY, unsigned int layerMask, std::vector<int> &proxies) const;
+
+private:
+	struct Proxy
+	{
+		Aabb2D box;
+		void *userData;
+		int filter;
+		int cellMinX;
+		int cellMinY;
+		int cellMaxX;
+		int cellMaxY;
+		bool oversized;
+		int nextFree;
+	};
+
+	struct Filter
+	{
+		unsigned int layer;
+		unsigned int mask;
+		int numProxies;
+		bool collidesWithSelf;
+
+		// Higher indexed filters that this one collides with
+		std::vector<int> collidesWith;
+	};
+
+	struct Bucket
+	{
+		int cellX;
+		int cellY;
+		int filter;
+		std::vector<int> proxies;
+	};
+
+	void ComputeCellRange(const Aabb2D &box, int &minX, int &minY, int &maxX, int &maxY) const;
+	bool IsOversized(int minX, int minY, int maxX, int maxY) const;
+
+	int AcquireFilter(unsigned int layer, unsigned int mask);
+	void ReleaseFilter(int filter);
+	void UpdateFilterLinks();
+	bool FiltersCollide(int filterA, int filterB) const;
+
+	void InsertIntoCells(int proxy);
+	void RemoveFromCells(int proxy);
+
+	void AddBucketPairs(const Bucket &bucket, std::vector<Pair> &pairs) const;
+	void AddBucketPairs(const Bucket &bucket, const Bucket &otherBucket, std::vector<Pair> &pairs) const;
+
+	int CountQueryFilters(unsigned int layerMask) const;
+	void AddOversizedQueryProxies(const Aabb2D &box, unsigned int layerMask, std::vector<int> &proxies) const;
+
+	int FindBucket(int cellX, int cellY, int filter) const;
+	int FindOrCreateBucket(int cellX, int cellY, int filter);
+	void GrowTable();
+	void CompactIfNeeded();
+	void Rebuild();
+
+	static unsigned int HashCell(int cellX, int cellY, int filter);
+
+	float m_cellSize;
+	float m_inverseCellSize;
+
+	std::vector<Proxy> m_proxies;
+	int m_freeProxy;
+	int m_numProxies;
+
+	// Distinct layer/mask pairs in use. There are normally only a handful of them, so
+	// they are looked up linearly and slots are recycled once no proxy uses them.
+	std::vector<Filter> m_filters;
+
+	// Open addressed table of bucket indices, -1 for an empty slot. Buckets are never
+	// removed from the table individually; once too many of them are empty the whole
+	// grid is rebuilt instead.
+	std::vector<int> m_table;
+	std::vector<Bucket> m_buckets;
+	int m_numOccupiedBuckets;
+
+	// Proxies that would touch too many cells are kept aside and tested against everything
+	std::vector<int> m_oversized;
+};
+
+#endif // SPATIAL_HASH_2D_HPP_INCLUDED
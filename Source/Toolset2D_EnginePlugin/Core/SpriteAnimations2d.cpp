@@ -0,0 +1,469 @@
+//=======
+//
+// Purpose: Advances the animations and texture scrolling of all sprites in one pass
+//
+//=======
+
+#include "SpriteAnimations2d.hpp"
+
+#include <float.h>
+#include <string.h>
+
+#if SPRITE_ANIMATIONS_2D_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+	const int kMinCapacity = 64;
+
+	// Frame length of animations that never move on to another frame
+	const float kNeverEnds = FLT_MAX;
+
+	inline AnimationTimeline2D EmptyTimeline()
+	{
+		AnimationTimeline2D timeline;
+		timeline.frameEndTimes = NULL;
+		timeline.numFrames = 0;
+		timeline.frameDuration = 0.f;
+		timeline.loopDuration = 0.f;
+		return timeline;
+	}
+
+	// Free handles store the next free handle as -2 - handle, so that -1 ends the list
+	// and every free entry is negative
+	inline int EncodeFreeHandle(int nextFreeHandle)
+	{
+		return -2 - nextFreeHandle;
+	}
+
+	inline int DecodeFreeHandle(int value)
+	{
+		return -2 - value;
+	}
+}
+
+SpriteAnimations2D::SpriteAnimations2D()
+{
+	m_freeHandle = -1;
+	m_count = 0;
+	m_capacity = kMinCapacity;
+	m_data.resize(NUM_STREAMS * m_capacity, 0.0f);
+}
+
+void SpriteAnimations2D::Reserve(int count)
+{
+	if (count > m_capacity)
+	{
+		int capacity = m_capacity * 2;
+		if (capacity < count)
+		{
+			capacity = (count + 3) & ~3;
+		}
+
+		// Every stream moves, so copy them over one by one
+		std::vector<float> data(NUM_STREAMS * capacity, 0.0f);
+		for (int stream = 0; stream < NUM_STREAMS; stream++)
+		{
+			memcpy(&data[stream * capacity], GetStream(stream), m_count * sizeof(float));
+		}
+
+		m_data.swap(data);
+		m_capacity = capacity;
+	}
+}
+
+int SpriteAnimations2D::CreateAnimation(void *userData)
+{
+	Reserve(m_count + 1);
+
+	int handle = m_freeHandle;
+	if (handle != -1)
+	{
+		m_freeHandle = DecodeFreeHandle(m_indices[handle]);
+	}
+	else
+	{
+		handle = static_cast<int>(m_indices.size());
+		m_indices.push_back(0);
+	}
+
+	const int index = m_count++;
+	m_indices[handle] = index;
+
+	m_timelines.push_back(EmptyTimeline());
+	m_frames.push_back(-1);
+	m_flags.push_back(0);
+	m_userData.push_back(userData);
+	m_handles.push_back(handle);
+
+	Reset(handle);
+
+	return handle;
+}
+
+void SpriteAnimations2D::DestroyAnimation(int animation)
+{
+	if (GetUserData(animation) == NULL)
+	{
+		return;
+	}
+
+	// Move the last animation into the gap to keep everything packed
+	const int index = m_indices[animation];
+	const int lastIndex = m_count - 1;
+	if (index != lastIndex)
+	{
+		for (int stream = 0; stream < NUM_STREAMS; stream++)
+		{
+			float *data = GetStream(stream);
+			data[index] = data[lastIndex];
+		}
+
+		m_timelines[index] = m_timelines[lastIndex];
+		m_frames[index] = m_frames[lastIndex];
+		m_flags[index] = m_flags[lastIndex];
+		m_userData[index] = m_userData[lastIndex];
+		m_handles[index] = m_handles[lastIndex];
+
+		m_indices[m_handles[index]] = index;
+	}
+
+	m_timelines.pop_back();
+	m_frames.pop_back();
+	m_flags.pop_back();
+	m_userData.pop_back();
+	m_handles.pop_back();
+	m_count--;
+
+	m_indices[animation] = EncodeFreeHandle(m_freeHandle);
+	m_freeHandle = animation;
+}
+
+void *SpriteAnimations2D::GetUserData(int animation) const
+{
+	if (animation < 0 || animation >= static_cast<int>(m_indices.size()) || m_indices[animation] < 0)
+	{
+		return NULL;
+	}
+	return m_userData[m_indices[animation]];
+}
+
+int SpriteAnimations2D::GetNumAnimations() const
+{
+	return m_count;
+}
+
+void SpriteAnimations2D::SetEnabled(int animation, bool enabled)
+{
+	const int index = m_indices[animation];
+	SetFlag(index, FLAG_ENABLED, enabled);
+	UpdateTimeScale(index);
+}
+
+bool SpriteAnimations2D::IsEnabled(int animation) const
+{
+	return (m_flags[m_indices[animation]] & FLAG_ENABLED) != 0;
+}
+
+void SpriteAnimations2D::Reset(int animation)
+{
+	const int index = m_indices[animation];
+
+	m_timelines[index] = EmptyTimeline();
+	m_frames[index] = -1;
+	m_flags[index] = static_cast<unsigned char>((m_flags[index] & FLAG_ENABLED) | FLAG_PLAYING);
+
+	GetStream(STREAM_FRAME_TIME)[index] = 0.f;
+	GetStream(STREAM_SCROLL_SPEED_X)[index] = 0.f;
+	GetStream(STREAM_SCROLL_SPEED_Y)[index] = 0.f;
+	GetStream(STREAM_SCROLL_OFFSET_X)[index] = 0.f;
+	GetStream(STREAM_SCROLL_OFFSET_Y)[index] = 0.f;
+
+	UpdateTimeScale(index);
+	UpdateFrameLength(index);
+}
+
+void SpriteAnimations2D::SetTimeline(int animation, const AnimationTimeline2D *timeline)
+{
+	const int index = m_indices[animation];
+
+	m_timelines[index] = (timeline != NULL) ? *timeline : EmptyTimeline();
+	m_frames[index] = (timeline != NULL && timeline->numFrames > 0) ? 0 : -1;
+	SetFlag(index, FLAG_TIMELINE, m_frames[index] != -1);
+
+	GetStream(STREAM_FRAME_TIME)[index] = 0.f;
+
+	UpdateTimeScale(index);
+	UpdateFrameLength(index);
+}
+
+bool SpriteAnimations2D::HasTimeline(int animation) const
+{
+	return (m_flags[m_indices[animation]] & FLAG_TIMELINE) != 0;
+}
+
+void SpriteAnimations2D::SetFrame(int animation, int frame)
+{
+	const int index = m_indices[animation];
+
+	const int numFrames = m_timelines[index].numFrames;
+	if (numFrames > 0)
+	{
+		m_frames[index] = (frame < 0) ? 0 : ((frame >= numFrames) ? numFrames - 1 : frame);
+		UpdateFrameLength(index);
+	}
+}
+
+int SpriteAnimations2D::GetFrame(int animation) const
+{
+	return m_frames[m_indices[animation]];
+}
+
+void SpriteAnimations2D::SetFrameTime(int animation, float frameTime)
+{
+	GetStream(STREAM_FRAME_TIME)[m_indices[animation]] = frameTime;
+}
+
+float SpriteAnimations2D::GetFrameTime(int animation) const
+{
+	return GetStream(STREAM_FRAME_TIME)[m_indices[animation]];
+}
+
+void SpriteAnimations2D::SetPlaying(int animation, bool playing)
+{
+	const int index = m_indices[animation];
+	SetFlag(index, FLAG_PLAYING, playing);
+	UpdateTimeScale(index);
+}
+
+bool SpriteAnimations2D::IsPlaying(int animation) const
+{
+	return (m_flags[m_indices[animation]] & FLAG_PLAYING) != 0;
+}
+
+void SpriteAnimations2D::SetPlayOnce(int animation, bool playOnce)
+{
+	SetFlag(m_indices[animation], FLAG_PLAY_ONCE, playOnce);
+}
+
+bool SpriteAnimations2D::IsPlayOnce(int animation) const
+{
+	return (m_flags[m_indices[animation]] & FLAG_PLAY_ONCE) != 0;
+}
+
+void SpriteAnimations2D::SetScrollSpeed(int animation, float speedX, float speedY)
+{
+	const int index = m_indices[animation];
+	GetStream(STREAM_SCROLL_SPEED_X)[index] = speedX;
+	GetStream(STREAM_SCROLL_SPEED_Y)[index] = speedY;
+}
+
+void SpriteAnimations2D::SetScrollOffset(int animation, float offsetX, float offsetY)
+{
+	const int index = m_indices[animation];
+	GetStream(STREAM_SCROLL_OFFSET_X)[index] = offsetX;
+	GetStream(STREAM_SCROLL_OFFSET_Y)[index] = offsetY;
+}
+
+float SpriteAnimations2D::GetScrollOffsetX(int animation) const
+{
+	return GetStream(STREAM_SCROLL_OFFSET_X)[m_indices[animation]];
+}
+
+float SpriteAnimations2D::GetScrollOffsetY(int animation) const
+{
+	return GetStream(STREAM_SCROLL_OFFSET_Y)[m_indices[animation]];
+}
+
+void SpriteAnimations2D::SetFlag(int index, unsigned char flag, bool set)
+{
+	if (set)
+	{
+		m_flags[index] = static_cast<unsigned char>(m_flags[index] | flag);
+	}
+	else
+	{
+		m_flags[index] = static_cast<unsigned char>(m_flags[index] & ~flag);
+	}
+}
+
+void SpriteAnimations2D::UpdateTimeScale(int index)
+{
+	const unsigned char running = FLAG_ENABLED | FLAG_PLAYING | FLAG_TIMELINE;
+	GetStream(STREAM_TIME_SCALE)[index] = ((m_flags[index] & running) == running) ? 1.f : 0.f;
+}
+
+void SpriteAnimations2D::UpdateFrameLength(int index)
+{
+	const AnimationTimeline2D &timeline = m_timelines[index];
+	const int frame = m_frames[index];
+
+	float frameLength = kNeverEnds;
+	if (timeline.numFrames > 1 && timeline.loopDuration > 0.f && frame >= 0 && frame < timeline.numFrames)
+	{
+		const float frameStart = (frame > 0) ? timeline.frameEndTimes[frame - 1] : 0.f;
+		frameLength = timeline.frameEndTimes[frame] - frameStart;
+	}
+
+	GetStream(STREAM_FRAME_LENGTH)[index] = frameLength;
+}
+
+void SpriteAnimations2D::Advance(float deltaTime, std::vector<AnimationEvent2D> &events)
+{
+	int scalarBegin = 0;
+
+#if SPRITE_ANIMATIONS_2D_USE_SSE
+	// Groups of four are done with SSE, whatever is left over one at a time
+	scalarBegin = m_count & ~3;
+	AdvanceSSE(0, scalarBegin, deltaTime, events);
+#endif
+
+	AdvanceScalar(scalarBegin, m_count, deltaTime, events);
+}
+
+void SpriteAnimations2D::AdvanceScalar(float deltaTime, std::vector<AnimationEvent2D> &events)
+{
+	AdvanceScalar(0, m_count, deltaTime, events);
+}
+
+void SpriteAnimations2D::AdvanceScalar(int begin, int end, float deltaTime, std::vector<AnimationEvent2D> &events)
+{
+	ScrollScalar(begin, end, deltaTime);
+
+	const float *timeScale = GetStream(STREAM_TIME_SCALE);
+	float *frameTime = GetStream(STREAM_FRAME_TIME);
+	const float *frameLength = GetStream(STREAM_FRAME_LENGTH);
+
+	for (int index = begin; index < end; index++)
+	{
+		frameTime[index] += deltaTime * timeScale[index];
+		if (!(frameTime[index] < frameLength[index]))
+		{
+			AdvanceFrame(index, events);
+		}
+	}
+}
+
+void SpriteAnimations2D::ScrollScalar(int begin, int end, float deltaTime)
+{
+	const float *timeScale = GetStream(STREAM_TIME_SCALE);
+	const float *speedX = GetStream(STREAM_SCROLL_SPEED_X);
+	const float *speedY = GetStream(STREAM_SCROLL_SPEED_Y);
+	float *offsetX = GetStream(STREAM_SCROLL_OFFSET_X);
+	float *offsetY = GetStream(STREAM_SCROLL_OFFSET_Y);
+
+	for (int index = begin; index < end; index++)
+	{
+		const float step = deltaTime * timeScale[index];
+
+		offsetX[index] += speedX[index] * step;
+		if (speedX[index] > 0.f && offsetX[index] > 1.f)
+		{
+			offsetX[index] -= 1.f;
+		}
+		else if (speedX[index] < 0.f && offsetX[index] < 0.f)
+		{
+			offsetX[index] += 1.f;
+		}
+
+		offsetY[index] += speedY[index] * step;
+		if (speedY[index] > 0.f && offsetY[index] > 1.f)
+		{
+			offsetY[index] -= 1.f;
+		}
+		else if (speedY[index] < 0.f && offsetY[index] < 0.f)
+		{
+			offsetY[index] += 1.f;
+		}
+	}
+}
+
+void SpriteAnimations2D::AdvanceFrame(int index, std::vector<AnimationEvent2D> &events)
+{
+	// A frame time set past the end while standing still waits until it plays again
+	if (GetStream(STREAM_TIME_SCALE)[index] == 0.f)
+	{
+		return;
+	}
+
+	const AnimationTimeline2D &timeline = m_timelines[index];
+	float &frameTime = GetStream(STREAM_FRAME_TIME)[index];
+
+	// The time has already been added
+	int numLoops = AdvanceAnimation2D(timeline, 0.f, m_frames[index], frameTime);
+	if (numLoops > 0 && (m_flags[index] & FLAG_PLAY_ONCE) != 0)
+	{
+		// Stop on the last frame no matter how far past the end this tick went
+		m_frames[index] = timeline.numFrames - 1;
+		frameTime = 0.f;
+		numLoops = 1;
+
+		SetFlag(index, FLAG_PLAYING, false);
+		UpdateTimeScale(index);
+	}
+
+	UpdateFrameLength(index);
+
+	if (numLoops > 0)
+	{
+		AnimationEvent2D event;
+		event.animation = m_handles[index];
+		event.userData = m_userData[index];
+		event.numLoops = numLoops;
+		events.push_back(event);
+	}
+}
+
+#if SPRITE_ANIMATIONS_2D_USE_SSE
+void SpriteAnimations2D::AdvanceSSE(int begin, int end, float deltaTime, std::vector<AnimationEvent2D> &events)
+{
+	const float *timeScale = GetStream(STREAM_TIME_SCALE);
+	float *frameTime = GetStream(STREAM_FRAME_TIME);
+	const float *frameLength = GetStream(STREAM_FRAME_LENGTH);
+	const float *speedX = GetStream(STREAM_SCROLL_SPEED_X);
+	const float *speedY = GetStream(STREAM_SCROLL_SPEED_Y);
+	float *offsetX = GetStream(STREAM_SCROLL_OFFSET_X);
+	float *offsetY = GetStream(STREAM_SCROLL_OFFSET_Y);
+
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (int index = begin; index < end; index += 4)
+	{
+		const __m128 step = _mm_mul_ps(dt, _mm_loadu_ps(timeScale + index));
+
+		const __m128 time = _mm_add_ps(_mm_loadu_ps(frameTime + index), step);
+		_mm_storeu_ps(frameTime + index, time);
+
+		// Same wrapping as the scalar path, without the branches
+		const __m128 sx = _mm_loadu_ps(speedX + index);
+		__m128 ox = _mm_add_ps(_mm_loadu_ps(offsetX + index), _mm_mul_ps(sx, step));
+		const __m128 wrapDownX = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(sx, zero), _mm_cmpgt_ps(ox, one)), one);
+		const __m128 wrapUpX = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(sx, zero), _mm_cmplt_ps(ox, zero)), one);
+		ox = _mm_add_ps(_mm_sub_ps(ox, wrapDownX), wrapUpX);
+		_mm_storeu_ps(offsetX + index, ox);
+
+		const __m128 sy = _mm_loadu_ps(speedY + index);
+		__m128 oy = _mm_add_ps(_mm_loadu_ps(offsetY + index), _mm_mul_ps(sy, step));
+		const __m128 wrapDownY = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(sy, zero), _mm_cmpgt_ps(oy, one)), one);
+		const __m128 wrapUpY = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(sy, zero), _mm_cmplt_ps(oy, zero)), one);
+		oy = _mm_add_ps(_mm_sub_ps(oy, wrapDownY), wrapUpY);
+		_mm_storeu_ps(offsetY + index, oy);
+
+		// Only the lanes that moved past the end of their frame need any more work
+		const int frameEnded = _mm_movemask_ps(_mm_cmpnlt_ps(time, _mm_loadu_ps(frameLength + index)));
+		if (frameEnded != 0)
+		{
+			for (int lane = 0; lane < 4; lane++)
+			{
+				if ((frameEnded & (1 << lane)) != 0)
+				{
+					AdvanceFrame(index + lane, events);
+				}
+			}
+		}
+	}
+}
+#endif // SPRITE_ANIMATIONS_2D_USE_SSE
@@ -0,0 +1,152 @@
+#ifndef SPRITE_ANIMATIONS_2D_HPP_INCLUDED
+#define SPRITE_ANIMATIONS_2D_HPP_INCLUDED
+
+#include "Animation2d.hpp"
+
+#include <vector>
+
+// SSE is always there on x86/x64, everything else goes through the scalar path
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#define SPRITE_ANIMATIONS_2D_USE_SSE 1
+#else
+#define SPRITE_ANIMATIONS_2D_USE_SSE 0
+#endif
+
+// Reported by Advance for every animation that completed one or more loops
+struct AnimationEvent2D
+{
+	int animation;
+	void *userData;
+	int numLoops;
+};
+
+// Frame and texture scroll state of all sprites, kept as a structure of arrays so that
+// every animation is advanced in a single pass, four at a time where SSE is available.
+// Ticks that stay within the current frame only add and compare, anything that moves on
+// to another frame goes through AdvanceAnimation2D.
+//
+// Animations are referred to by handles that stay valid until they are destroyed, while
+// the data behind them is kept packed. New animations are disabled and playing.
+class SpriteAnimations2D
+{
+public:
+	SpriteAnimations2D();
+
+	// 'userData' must not be NULL
+	int CreateAnimation(void *userData);
+	void DestroyAnimation(int animation);
+
+	// Returns NULL if the animation has been destroyed
+	void *GetUserData(int animation) const;
+	int GetNumAnimations() const;
+
+	// Disabled animations keep their state but are neither advanced nor scrolled
+	void SetEnabled(int animation, bool enabled);
+	bool IsEnabled(int animation) const;
+
+	// Everything but the enabled flag back to the state of a new animation
+	void Reset(int animation);
+
+	// Starts the timeline over from its first frame, NULL for no timeline at all. The
+	// frame table has to stay around for as long as the timeline is set. Timelines with a
+	// single frame only scroll.
+	void SetTimeline(int animation, const AnimationTimeline2D *timeline);
+	bool HasTimeline(int animation) const;
+
+	// The frame is -1 without a timeline
+	void SetFrame(int animation, int frame);
+	int GetFrame(int animation) const;
+	void SetFrameTime(int animation, float frameTime);
+	float GetFrameTime(int animation) const;
+
+	void SetPlaying(int animation, bool playing);
+	bool IsPlaying(int animation) const;
+
+	// Play-once animations stop on their last frame
+	void SetPlayOnce(int animation, bool playOnce);
+	bool IsPlayOnce(int animation) const;
+
+	// Texture coordinate offset moving by the speed every second, wrapped back into [0, 1]
+	void SetScrollSpeed(int animation, float speedX, float speedY);
+	void SetScrollOffset(int animation, float offsetX, float offsetY);
+	float GetScrollOffsetX(int animation) const;
+	float GetScrollOffsetY(int animation) const;
+
+	// Moves every enabled animation that is playing and has a timeline on by deltaTime and
+	// appends one event per animation that completed a loop. Play-once animations report
+	// a single loop.
+	void Advance(float deltaTime, std::vector<AnimationEvent2D> &events);
+
+	// Advances the animations one at a time, the way it goes where SSE isn't available. Tests and
+	// benchmarks call it to check the SSE path against it.
+	void AdvanceScalar(float deltaTime, std::vector<AnimationEvent2D> &events);
+
+private:
+	enum Stream
+	{
+		// One while the animation moves on, zero while it stands still
+		STREAM_TIME_SCALE,
+
+		STREAM_FRAME_TIME,
+
+		// How long the current frame is shown, so the fast path doesn't need the timeline
+		STREAM_FRAME_LENGTH,
+
+		STREAM_SCROLL_SPEED_X,
+		STREAM_SCROLL_SPEED_Y,
+		STREAM_SCROLL_OFFSET_X,
+		STREAM_SCROLL_OFFSET_Y,
+
+		NUM_STREAMS
+	};
+
+	enum Flags
+	{
+		FLAG_ENABLED = 1 << 0,
+		FLAG_PLAYING = 1 << 1,
+		FLAG_PLAY_ONCE = 1 << 2,
+		FLAG_TIMELINE = 1 << 3
+	};
+
+	inline float *GetStream(int stream)
+	{
+		return &m_data[stream * m_capacity];
+	}
+
+	inline const float *GetStream(int stream) const
+	{
+		return &m_data[stream * m_capacity];
+	}
+
+	void Reserve(int count);
+	void SetFlag(int index, unsigned char flag, bool set);
+	void UpdateTimeScale(int index);
+	void UpdateFrameLength(int index);
+
+	void AdvanceScalar(int begin, int end, float deltaTime, std::vector<AnimationEvent2D> &events);
+	void ScrollScalar(int begin, int end, float deltaTime);
+	void AdvanceFrame(int index, std::vector<AnimationEvent2D> &events);
+#if SPRITE_ANIMATIONS_2D_USE_SSE
+	void AdvanceSSE(int begin, int end, float deltaTime, std::vector<AnimationEvent2D> &events);
+#endif
+
+	// Handle to packed index, with destroyed handles chained up into a free list
+	std::vector<int> m_indices;
+	int m_freeHandle;
+
+	int m_count;
+
+	// Always a multiple of four so every stream starts on the same SSE lane
+	int m_capacity;
+
+	std::vector<float> m_data;
+
+	// Packed alongside the streams
+	std::vector<AnimationTimeline2D> m_timelines;
+	std::vector<int> m_frames;
+	std::vector<unsigned char> m_flags;
+	std::vector<void*> m_userData;
+	std::vector<int> m_handles;
+};
+
+#endif // SPRITE_ANIMATIONS_2D_HPP_INCLUDED
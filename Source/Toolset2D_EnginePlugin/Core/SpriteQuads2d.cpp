@@ -0,0 +1,281 @@
+//=======
+//
+// Purpose: Computes the screen space corners of all sprite quads in one pass
+//
+//=======
+
+#include "SpriteQuads2d.hpp"
+
+#include <string.h>
+
+#if SPRITE_QUADS_2D_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+	const int kMinCapacity = 64;
+
+	// Quads are always drawn with a white vertex color
+	const unsigned int kWhite = 0xFFFFFFFF;
+
+	inline void SetVertex(QuadVertex2D &vertex, float x, float y, float u, float v)
+	{
+		vertex.x = x;
+		vertex.y = y;
+		vertex.u = u;
+		vertex.v = v;
+		vertex.color = kWhite;
+	}
+}
+
+SpriteQuads2D::SpriteQuads2D()
+{
+	m_count = 0;
+	m_capacity = kMinCapacity;
+	m_data.assign(NUM_STREAMS * m_capacity, 0.0f);
+}
+
+void SpriteQuads2D::Resize(int count)
+{
+	if (count > m_capacity)
+	{
+		int capacity = m_capacity * 2;
+		if (capacity < count)
+		{
+			capacity = (count + 3) & ~3;
+		}
+
+		// Every stream moves, so copy them over one by one
+		std::vector<float> data(NUM_STREAMS * capacity, 0.0f);
+		for (int stream = 0; stream < NUM_STREAMS; stream++)
+		{
+			memcpy(&data[stream * capacity], GetStream(stream), m_count * sizeof(float));
+		}
+
+		m_data.swap(data);
+		m_capacity = capacity;
+	}
+
+	m_count = (count > 0) ? count : 0;
+}
+
+int SpriteQuads2D::GetCount() const
+{
+	return m_count;
+}
+
+void SpriteQuads2D::SetQuad(int index, const SpriteQuad2D &quad)
+{
+	GetStream(STREAM_POSITION_X)[index] = quad.positionX;
+	GetStream(STREAM_POSITION_Y)[index] = quad.positionY;
+	GetStream(STREAM_CENTER_X)[index] = quad.centerX;
+	GetStream(STREAM_CENTER_Y)[index] = quad.centerY;
+	GetStream(STREAM_OFFSET_X)[index] = quad.offsetX;
+	GetStream(STREAM_OFFSET_Y)[index] = quad.offsetY;
+	GetStream(STREAM_WIDTH)[index] = quad.width;
+	GetStream(STREAM_HEIGHT)[index] = quad.height;
+	GetStream(STREAM_SCALE_X)[index] = quad.scaleX;
+	GetStream(STREAM_SCALE_Y)[index] = quad.scaleY;
+	GetStream(STREAM_COS_ROTATION)[index] = quad.cosRotation;
+	GetStream(STREAM_SIN_ROTATION)[index] = quad.sinRotation;
+	GetStream(STREAM_U0)[index] = quad.u0;
+	GetStream(STREAM_V0)[index] = quad.v0;
+	GetStream(STREAM_U1)[index] = quad.u1;
+	GetStream(STREAM_V1)[index] = quad.v1;
+}
+
+void SpriteQuads2D::ComputeCorners()
+{
+	ComputeCorners(0, m_count);
+}
+
+void SpriteQuads2D::ComputeCorners(int begin, int end)
+{
+#if SPRITE_QUADS_2D_USE_SSE
+	// Groups of four are done with SSE, whatever sticks out on either side one at a time
+	const int groupsBegin = (begin + 3) & ~3;
+	const int groupsEnd = end & ~3;
+
+	if (groupsBegin < groupsEnd)
+	{
+		ComputeCornersScalar(begin, groupsBegin);
+		ComputeCornersSSE(groupsBegin, groupsEnd);
+		ComputeCornersScalar(groupsEnd, end);
+	}
+	else
+	{
+		ComputeCornersScalar(begin, end);
+	}
+#else
+	ComputeCornersScalar(begin, end);
+#endif
+}
+
+void SpriteQuads2D::GetCorners(int index, float *cornersX, float *cornersY) const
+{
+	for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+	{
+		cornersX[corner] = GetStream(STREAM_CORNER_X + corner)[index];
+		cornersY[corner] = GetStream(STREAM_CORNER_Y + corner)[index];
+	}
+}
+
+void SpriteQuads2D::WriteVertices(int index, QuadVertex2D *vertices) const
+{
+	const float topLeftX = GetStream(STREAM_CORNER_X + QUAD_TOP_LEFT)[index];
+	const float topLeftY = GetStream(STREAM_CORNER_Y + QUAD_TOP_LEFT)[index];
+	const float topRightX = GetStream(STREAM_CORNER_X + QUAD_TOP_RIGHT)[index];
+	const float topRightY = GetStream(STREAM_CORNER_Y + QUAD_TOP_RIGHT)[index];
+	const float bottomLeftX = GetStream(STREAM_CORNER_X + QUAD_BOTTOM_LEFT)[index];
+	const float bottomLeftY = GetStream(STREAM_CORNER_Y + QUAD_BOTTOM_LEFT)[index];
+	const float bottomRightX = GetStream(STREAM_CORNER_X + QUAD_BOTTOM_RIGHT)[index];
+	const float bottomRightY = GetStream(STREAM_CORNER_Y + QUAD_BOTTOM_RIGHT)[index];
+
+	const float u0 = GetStream(STREAM_U0)[index];
+	const float v0 = GetStream(STREAM_V0)[index];
+	const float u1 = GetStream(STREAM_U1)[index];
+	const float v1 = GetStream(STREAM_V1)[index];
+
+	SetVertex(vertices[0], topLeftX, topLeftY, u0, v0);
+	SetVertex(vertices[1], bottomLeftX, bottomLeftY, u0, v1);
+	SetVertex(vertices[2], topRightX, topRightY, u1, v0);
+	SetVertex(vertices[3], topRightX, topRightY, u1, v0);
+	SetVertex(vertices[4], bottomLeftX, bottomLeftY, u0, v1);
+	SetVertex(vertices[5], bottomRightX, bottomRightY, u1, v1);
+}
+
+void SpriteQuads2D::ComputeCorners(const SpriteQuad2D &quad, float *cornersX, float *cornersY)
+{
+	const float left = quad.offsetX * quad.scaleX;
+	const float top = quad.offsetY * quad.scaleY;
+	const float right = (quad.offsetX + quad.width) * quad.scaleX;
+	const float bottom = (quad.offsetY + quad.height) * quad.scaleY;
+
+	const float originX = quad.positionX + quad.centerX;
+	const float originY = quad.positionY + quad.centerY;
+
+	const float c = quad.cosRotation;
+	const float s = quad.sinRotation;
+
+	cornersX[QUAD_TOP_LEFT] = c * left - s * top + originX;
+	cornersY[QUAD_TOP_LEFT] = s * left + c * top + originY;
+	cornersX[QUAD_TOP_RIGHT] = c * right - s * top + originX;
+	cornersY[QUAD_TOP_RIGHT] = s * right + c * top + originY;
+	cornersX[QUAD_BOTTOM_LEFT] = c * left - s * bottom + originX;
+	cornersY[QUAD_BOTTOM_LEFT] = s * left + c * bottom + originY;
+	cornersX[QUAD_BOTTOM_RIGHT] = c * right - s * bottom + originX;
+	cornersY[QUAD_BOTTOM_RIGHT] = s * right + c * bottom + originY;
+}
+
+void SpriteQuads2D::ComputeCornersScalar(int begin, int end)
+{
+	const float *positionX = GetStream(STREAM_POSITION_X);
+	const float *positionY = GetStream(STREAM_POSITION_Y);
+	const float *centerX = GetStream(STREAM_CENTER_X);
+	const float *centerY = GetStream(STREAM_CENTER_Y);
+	const float *offsetX = GetStream(STREAM_OFFSET_X);
+	const float *offsetY = GetStream(STREAM_OFFSET_Y);
+	const float *width = GetStream(STREAM_WIDTH);
+	const float *height = GetStream(STREAM_HEIGHT);
+	const float *scaleX = GetStream(STREAM_SCALE_X);
+	const float *scaleY = GetStream(STREAM_SCALE_Y);
+	const float *cosRotation = GetStream(STREAM_COS_ROTATION);
+	const float *sinRotation = GetStream(STREAM_SIN_ROTATION);
+
+	float *cornerX[QUAD_NUM_CORNERS];
+	float *cornerY[QUAD_NUM_CORNERS];
+	for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+	{
+		cornerX[corner] = GetStream(STREAM_CORNER_X + corner);
+		cornerY[corner] = GetStream(STREAM_CORNER_Y + corner);
+	}
+
+	for (int index = begin; index < end; index++)
+	{
+		const float left = offsetX[index] * scaleX[index];
+		const float top = offsetY[index] * scaleY[index];
+		const float right = (offsetX[index] + width[index]) * scaleX[index];
+		const float bottom = (offsetY[index] + height[index]) * scaleY[index];
+
+		const float originX = positionX[index] + centerX[index];
+		const float originY = positionY[index] + centerY[index];
+
+		const float c = cosRotation[index];
+		const float s = sinRotation[index];
+
+		cornerX[QUAD_TOP_LEFT][index] = c * left - s * top + originX;
+		cornerY[QUAD_TOP_LEFT][index] = s * left + c * top + originY;
+		cornerX[QUAD_TOP_RIGHT][index] = c * right - s * top + originX;
+		cornerY[QUAD_TOP_RIGHT][index] = s * right + c * top + originY;
+		cornerX[QUAD_BOTTOM_LEFT][index] = c * left - s * bottom + originX;
+		cornerY[QUAD_BOTTOM_LEFT][index] = s * left + c * bottom + originY;
+		cornerX[QUAD_BOTTOM_RIGHT][index] = c * right - s * bottom + originX;
+		cornerY[QUAD_BOTTOM_RIGHT][index] = s * right + c * bottom + originY;
+	}
+}
+
+#if SPRITE_QUADS_2D_USE_SSE
+void SpriteQuads2D::ComputeCornersSSE(int begin, int end)
+{
+	const float *positionX = GetStream(STREAM_POSITION_X);
+	const float *positionY = GetStream(STREAM_POSITION_Y);
+	const float *centerX = GetStream(STREAM_CENTER_X);
+	const float *centerY = GetStream(STREAM_CENTER_Y);
+	const float *offsetX = GetStream(STREAM_OFFSET_X);
+	const float *offsetY = GetStream(STREAM_OFFSET_Y);
+	const float *width = GetStream(STREAM_WIDTH);
+	const float *height = GetStream(STREAM_HEIGHT);
+	const float *scaleX = GetStream(STREAM_SCALE_X);
+	const float *scaleY = GetStream(STREAM_SCALE_Y);
+	const float *cosRotation = GetStream(STREAM_COS_ROTATION);
+	const float *sinRotation = GetStream(STREAM_SIN_ROTATION);
+
+	float *cornerX[QUAD_NUM_CORNERS];
+	float *cornerY[QUAD_NUM_CORNERS];
+	for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+	{
+		cornerX[corner] = GetStream(STREAM_CORNER_X + corner);
+		cornerY[corner] = GetStream(STREAM_CORNER_Y + corner);
+	}
+
+	// std::vector only guarantees the alignment of malloc, so stick to unaligned loads
+	for (int index = begin; index < end; index += 4)
+	{
+		const __m128 sx = _mm_loadu_ps(scaleX + index);
+		const __m128 sy = _mm_loadu_ps(scaleY + index);
+		const __m128 ox = _mm_loadu_ps(offsetX + index);
+		const __m128 oy = _mm_loadu_ps(offsetY + index);
+
+		const __m128 left = _mm_mul_ps(ox, sx);
+		const __m128 top = _mm_mul_ps(oy, sy);
+		const __m128 right = _mm_mul_ps(_mm_add_ps(ox, _mm_loadu_ps(width + index)), sx);
+		const __m128 bottom = _mm_mul_ps(_mm_add_ps(oy, _mm_loadu_ps(height + index)), sy);
+
+		const __m128 originX = _mm_add_ps(_mm_loadu_ps(positionX + index), _mm_loadu_ps(centerX + index));
+		const __m128 originY = _mm_add_ps(_mm_loadu_ps(positionY + index), _mm_loadu_ps(centerY + index));
+
+		const __m128 c = _mm_loadu_ps(cosRotation + index);
+		const __m128 s = _mm_loadu_ps(sinRotation + index);
+
+		// Each corner only combines these, so compute them once
+		const __m128 cLeft = _mm_add_ps(_mm_mul_ps(c, left), originX);
+		const __m128 cRight = _mm_add_ps(_mm_mul_ps(c, right), originX);
+		const __m128 sLeft = _mm_add_ps(_mm_mul_ps(s, left), originY);
+		const __m128 sRight = _mm_add_ps(_mm_mul_ps(s, right), originY);
+		const __m128 sTop = _mm_mul_ps(s, top);
+		const __m128 sBottom = _mm_mul_ps(s, bottom);
+		const __m128 cTop = _mm_mul_ps(c, top);
+		const __m128 cBottom = _mm_mul_ps(c, bottom);
+
+		_mm_storeu_ps(cornerX[QUAD_TOP_LEFT] + index, _mm_sub_ps(cLeft, sTop));
+		_mm_storeu_ps(cornerY[QUAD_TOP_LEFT] + index, _mm_add_ps(sLeft, cTop));
+		_mm_storeu_ps(cornerX[QUAD_TOP_RIGHT] + index, _mm_sub_ps(cRight, sTop));
+		_mm_storeu_ps(cornerY[QUAD_TOP_RIGHT] + index, _mm_add_ps(sRight, cTop));
+		_mm_storeu_ps(cornerX[QUAD_BOTTOM_LEFT] + index, _mm_sub_ps(cLeft, sBottom));
+		_mm_storeu_ps(cornerY[QUAD_BOTTOM_LEFT] + index, _mm_add_ps(sLeft, cBottom));
+		_mm_storeu_ps(cornerX[QUAD_BOTTOM_RIGHT] + index, _mm_sub_ps(cRight, sBottom));
+		_mm_storeu_ps(cornerY[QUAD_BOTTOM_RIGHT] + index, _mm_add_ps(sRight, cBottom));
+	}
+}
+#endif // SPRITE_QUADS_2D_USE_SSE
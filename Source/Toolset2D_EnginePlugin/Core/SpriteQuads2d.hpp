@@ -0,0 +1,135 @@
+#ifndef SPRITE_QUADS_2D_HPP_INCLUDED
+#define SPRITE_QUADS_2D_HPP_INCLUDED
+
+#include <vector>
+
+// SSE is always there on x86/x64, everything else goes through the scalar path
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#define SPRITE_QUADS_2D_USE_SSE 1
+#else
+#define SPRITE_QUADS_2D_USE_SSE 0
+#endif
+
+// Same layout as the engine's 2D overlay vertex so quads can be written straight into the
+// buffer that gets rendered
+struct QuadVertex2D
+{
+	float x;
+	float y;
+	float u;
+	float v;
+	unsigned int color;
+};
+
+// Everything needed to place one sprite on screen. The corners end up at
+// 'position + center + rotate(scale * (offset + corner))' where 'corner' goes from (0, 0)
+// to (width, height), so 'center' is the point that the sprite rotates around.
+struct SpriteQuad2D
+{
+	float positionX;
+	float positionY;
+	float centerX;
+	float centerY;
+	float offsetX;
+	float offsetY;
+	float width;
+	float height;
+	float scaleX;
+	float scaleY;
+	float cosRotation;
+	float sinRotation;
+	float u0;
+	float v0;
+	float u1;
+	float v1;
+};
+
+// Same order as the sprite's vertices
+enum QuadCorner2D
+{
+	QUAD_TOP_LEFT = 0,
+	QUAD_TOP_RIGHT,
+	QUAD_BOTTOM_LEFT,
+	QUAD_BOTTOM_RIGHT,
+	QUAD_NUM_CORNERS
+};
+
+// Structure of arrays holding the quads of all sprites so that the corners of all of them
+// can be computed in a single pass, four at a time where SSE is available.
+class SpriteQuads2D
+{
+public:
+	SpriteQuads2D();
+
+	void Resize(int count);
+	int GetCount() const;
+
+	void SetQuad(int index, const SpriteQuad2D &quad);
+	void ComputeCorners();
+
+	// Only touches the quads in [begin, end) so separate ranges can be done on separate threads
+	void ComputeCorners(int begin, int end);
+
+	// Same without SSE, which is what platforms without it run. Public so that both paths
+	// can be compared within one build.
+	void ComputeCornersScalar(int begin, int end);
+
+	// 'cornersX' and 'cornersY' have room for QUAD_NUM_CORNERS values
+	void GetCorners(int index, float *cornersX, float *cornersY) const;
+
+	// Writes the two triangles of a quad as six vertices
+	void WriteVertices(int index, QuadVertex2D *vertices) const;
+
+	// Same math for a single quad that isn't part of the store
+	static void ComputeCorners(const SpriteQuad2D &quad, float *cornersX, float *cornersY);
+
+private:
+	enum Stream
+	{
+		STREAM_POSITION_X,
+		STREAM_POSITION_Y,
+		STREAM_CENTER_X,
+		STREAM_CENTER_Y,
+		STREAM_OFFSET_X,
+		STREAM_OFFSET_Y,
+		STREAM_WIDTH,
+		STREAM_HEIGHT,
+		STREAM_SCALE_X,
+		STREAM_SCALE_Y,
+		STREAM_COS_ROTATION,
+		STREAM_SIN_ROTATION,
+		STREAM_U0,
+		STREAM_V0,
+		STREAM_U1,
+		STREAM_V1,
+
+		// Output, one stream per corner
+		STREAM_CORNER_X,
+		STREAM_CORNER_Y = STREAM_CORNER_X + QUAD_NUM_CORNERS,
+
+		NUM_STREAMS = STREAM_CORNER_Y + QUAD_NUM_CORNERS
+	};
+
+	inline float *GetStream(int stream)
+	{
+		return &m_data[stream * m_capacity];
+	}
+
+	inline const float *GetStream(int stream) const
+	{
+		return &m_data[stream * m_capacity];
+	}
+
+#if SPRITE_QUADS_2D_USE_SSE
+	void ComputeCornersSSE(int begin, int end);
+#endif
+
+	int m_count;
+
+	// Always a multiple of four so every stream starts on the same SSE lane
+	int m_capacity;
+
+	std::vector<float> m_data;
+};
+
+#endif // SPRITE_QUADS_2D_HPP_INCLUDED
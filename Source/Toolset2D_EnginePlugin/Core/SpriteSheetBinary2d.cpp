@@ -0,0 +1,191 @@
+//=======
+//
+// Purpose: Reads precompiled sprite sheets without any parsing
+//
+//=======
+
+#include "SpriteSheetBinary2d.hpp"
+
+SpriteSheetBinary2D::SpriteSheetBinary2D()
+{
+	m_header = NULL;
+	m_cells = NULL;
+	m_states = NULL;
+	m_stateCells = NULL;
+	m_hullVertices = NULL;
+	m_maskWords = NULL;
+	m_strings = NULL;
+}
+
+bool SpriteSheetBinary2D::Load(const void *data, size_t size)
+{
+	m_header = NULL;
+
+	if (data == NULL || size < sizeof(SheetHeader2D))
+	{
+		return false;
+	}
+
+	const SheetHeader2D *header = static_cast<const SheetHeader2D*>(data);
+	if (header->magic != kSpriteSheetBinaryMagic || header->version != kSpriteSheetBinaryVersion)
+	{
+		return false;
+	}
+
+	// Work out the size in 64 bits so that huge counts in a broken file can't wrap around
+	const unsigned long long expectedSize =
+		sizeof(SheetHeader2D) +
+		static_cast<unsigned long long>(header->numCells) * sizeof(SheetCell2D) +
+		static_cast<unsigned long long>(header->numStates) * sizeof(SheetState2D) +
+		static_cast<unsigned long long>(header->numStateCells) * sizeof(unsigned int) +
+		static_cast<unsigned long long>(header->numHullVertices) * sizeof(SheetVertex2D) +
+		static_cast<unsigned long long>(header->numMaskWords) * sizeof(unsigned int) +
+		header->stringTableSize;
+
+	if (expectedSize != size)
+	{
+		return false;
+	}
+
+	const char *section = static_cast<const char*>(data) + sizeof(SheetHeader2D);
+
+	m_cells = reinterpret_cast<const SheetCell2D*>(section);
+	section += header->numCells * sizeof(SheetCell2D);
+
+	m_states = reinterpret_cast<const SheetState2D*>(section);
+	section += header->numStates * sizeof(SheetState2D);
+
+	m_stateCells = reinterpret_cast<const unsigned int*>(section);
+	section += header->numStateCells * sizeof(unsigned int);
+
+	m_hullVertices = reinterpret_cast<const SheetVertex2D*>(section);
+	section += header->numHullVertices * sizeof(SheetVertex2D);
+
+	m_maskWords = reinterpret_cast<const unsigned int*>(section);
+	section += header->numMaskWords * sizeof(unsigned int);
+
+	m_strings = section;
+
+	m_header = header;
+	if (!Validate())
+	{
+		m_header = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+float SpriteSheetBinary2D::GetSourceWidth() const
+{
+	return m_header->sourceWidth;
+}
+
+float SpriteSheetBinary2D::GetSourceHeight() const
+{
+	return m_header->sourceHeight;
+}
+
+int SpriteSheetBinary2D::GetNumCells() const
+{
+	return (m_header != NULL) ? static_cast<int>(m_header->numCells) : 0;
+}
+
+const SheetCell2D &SpriteSheetBinary2D::GetCell(int cell) const
+{
+	return m_cells[cell];
+}
+
+const char *SpriteSheetBinary2D::GetCellName(int cell) const
+{
+	return &m_strings[m_cells[cell].nameOffset];
+}
+
+const SheetVertex2D *SpriteSheetBinary2D::GetCellHullVertices(int cell) const
+{
+	return &m_hullVertices[m_cells[cell].firstHullVertex];
+}
+
+const unsigned int *SpriteSheetBinary2D::GetCellMaskWords(int cell) const
+{
+	return &m_maskWords[m_cells[cell].firstMaskWord];
+}
+
+unsigned int SpriteSheetBinary2D::GetNumMaskWords(const SheetCell2D &cell)
+{
+	return ((cell.maskWidth + 63) / 64) * 2 * cell.maskHeight;
+}
+
+int SpriteSheetBinary2D::GetNumStates() const
+{
+	return (m_header != NULL) ? static_cast<int>(m_header->numStates) : 0;
+}
+
+const SheetState2D &SpriteSheetBinary2D::GetState(int state) const
+{
+	return m_states[state];
+}
+
+const char *SpriteSheetBinary2D::GetStateName(int state) const
+{
+	return &m_strings[m_states[state].nameOffset];
+}
+
+const unsigned int *SpriteSheetBinary2D::GetStateCells(int state) const
+{
+	return &m_stateCells[m_states[state].firstStateCell];
+}
+
+bool SpriteSheetBinary2D::Validate() const
+{
+	const unsigned int stringTableSize = m_header->stringTableSize;
+
+	// Every name has to end within the table
+	if (stringTableSize == 0 || m_strings[stringTableSize - 1] != '\0')
+	{
+		return false;
+	}
+
+	for (unsigned int cellIndex = 0; cellIndex < m_header->numCells; cellIndex++)
+	{
+		const SheetCell2D &cell = m_cells[cellIndex];
+		if (cell.nameOffset >= stringTableSize ||
+			cell.firstHullVertex > m_header->numHullVertices ||
+			cell.numHullVertices > m_header->numHullVertices - cell.firstHullVertex)
+		{
+			return false;
+		}
+
+		// Masks are either complete or missing, checked in 64 bits for the same reason as the size
+		const unsigned long long numMaskWords =
+			((static_cast<unsigned long long>(cell.maskWidth) + 63) / 64) * 2 * cell.maskHeight;
+		if ((cell.maskWidth == 0) != (cell.maskHeight == 0) ||
+			cell.firstMaskWord > m_header->numMaskWords ||
+			numMaskWords > m_header->numMaskWords - cell.firstMaskWord)
+		{
+			return false;
+		}
+	}
+
+	for (unsigned int stateIndex = 0; stateIndex < m_header->numStates; stateIndex++)
+	{
+		const SheetState2D &state = m_states[stateIndex];
+		if (state.nameOffset >= stringTableSize ||
+			state.numStateCells == 0 ||
+			state.firstStateCell > m_header->numStateCells ||
+			state.numStateCells > m_header->numStateCells - state.firstStateCell)
+		{
+			return false;
+		}
+	}
+
+	for (unsigned int stateCellIndex = 0; stateCellIndex < m_header->numStateCells; stateCellIndex++)
+	{
+		if (m_stateCells[stateCellIndex] >= m_header->numCells)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,117 @@
+#ifndef SPRITE_SHEET_BINARY_2D_HPP_INCLUDED
+#define SPRITE_SHEET_BINARY_2D_HPP_INCLUDED
+
+#include <stddef.h>
+
+// Precompiled sprite sheet as written by Source/BuildSystem/spritesheetbin.py. All values
+// are 32-bit little-endian and every section directly follows the previous one:
+//
+//   header
+//   cells          numCells * SheetCell2D
+//   states         numStates * SheetState2D
+//   state cells    numStateCells * uint32, the cell indices of all states back to back
+//   hull vertices  numHullVertices * SheetVertex2D, in cell space with (0, 0) at the center
+//   alpha masks    numMaskWords * uint32, see GetCellMaskWords
+//   strings        stringTableSize bytes of zero terminated names
+//
+// Bump kSpriteSheetBinaryVersion whenever the layout changes, older files are then simply
+// ignored and the XML is used instead.
+
+static const unsigned int kSpriteSheetBinaryMagic = 0x42443253; // 'S2DB'
+static const unsigned int kSpriteSheetBinaryVersion = 3;
+
+struct SheetHeader2D
+{
+	unsigned int magic;
+	unsigned int version;
+	float sourceWidth;
+	float sourceHeight;
+	unsigned int numCells;
+	unsigned int numStates;
+	unsigned int numStateCells;
+	unsigned int numHullVertices;
+	unsigned int numMaskWords;
+	unsigned int stringTableSize;
+};
+
+struct SheetCell2D
+{
+	float offsetX;
+	float offsetY;
+	float pivotX;
+	float pivotY;
+	float width;
+	float height;
+	float originalWidth;
+	float originalHeight;
+	int index;
+	unsigned int nameOffset;
+	unsigned int firstHullVertex;
+	unsigned int numHullVertices;
+
+	// Seconds the cell is shown in an animation, zero to use the state's framerate
+	float duration;
+
+	// Size of the alpha mask in pixels, both zero if the sheet was baked without masks
+	unsigned int maskWidth;
+	unsigned int maskHeight;
+	unsigned int firstMaskWord;
+};
+
+struct SheetState2D
+{
+	unsigned int nameOffset;
+	float framerate;
+	unsigned int firstStateCell;
+	unsigned int numStateCells;
+};
+
+struct SheetVertex2D
+{
+	float x;
+	float y;
+};
+
+// Read-only view of a precompiled sprite sheet. Nothing is copied, so the data passed to
+// Load has to be 4-byte aligned and stay around for as long as the sheet is used.
+class SpriteSheetBinary2D
+{
+public:
+	SpriteSheetBinary2D();
+
+	// Returns false unless the data is a complete sheet of the current version with all
+	// offsets and indices in range
+	bool Load(const void *data, size_t size);
+
+	float GetSourceWidth() const;
+	float GetSourceHeight() const;
+
+	int GetNumCells() const;
+	const SheetCell2D &GetCell(int cell) const;
+	const char *GetCellName(int cell) const;
+	const SheetVertex2D *GetCellHullVertices(int cell) const;
+
+	// Rows of the cell's alpha mask, one bit per pixel. Each row is padded to a multiple of
+	// 64 pixels and every 64-bit word is stored as two 32-bit words, low half first. Bit
+	// (x % 32) of word (x / 32) is pixel x of the row.
+	const unsigned int *GetCellMaskWords(int cell) const;
+	static unsigned int GetNumMaskWords(const SheetCell2D &cell);
+
+	int GetNumStates() const;
+	const SheetState2D &GetState(int state) const;
+	const char *GetStateName(int state) const;
+	const unsigned int *GetStateCells(int state) const;
+
+private:
+	bool Validate() const;
+
+	const SheetHeader2D *m_header;
+	const SheetCell2D *m_cells;
+	const SheetState2D *m_states;
+	const unsigned int *m_stateCells;
+	const SheetVertex2D *m_hullVertices;
+	const unsigned int *m_maskWords;
+	const char *m_strings;
+};
+
+#endif // SPRITE_SHEET_BINARY_2D_HPP_INCLUDED
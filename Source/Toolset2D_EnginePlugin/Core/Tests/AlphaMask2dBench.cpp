@@ -0,0 +1,62 @@
+//=======
+//
+// Purpose: Benchmark of the pixel perfect overlap test on Explosion sized masks
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "AlphaMask2d.hpp"
+
+#include <math.h>
+#include <stdio.h>
+
+BENCH_2D(AlphaMask2D_Overlap)
+{
+	const int kWidth = 230;
+	const int kHeight = 160;
+	const int kNumTests = 20000;
+
+	// Dotted ellipse about 155 pixels wide
+	AlphaMask2D mask;
+	mask.Create(kWidth, kHeight);
+	for (int y = 0; y < kHeight; y++)
+	{
+		for (int x = 0; x < kWidth; x++)
+		{
+			const int distanceX = x - kWidth / 2;
+			const int distanceY = y - kHeight / 2;
+			mask.SetPixel(x, y, distanceX * distanceX / 4 + distanceY * distanceY < 1500 && (x + y) % 7 != 0);
+		}
+	}
+
+	SpriteQuad2D quad = { 0, 0, 0, 0, -kWidth / 2, -kHeight / 2, kWidth, kHeight, 1, 1, 1, 0, 0, 0, 1, 1 };
+	SpriteQuad2D otherQuad = quad;
+
+	// Moved over by less than that, so that the rims of the two masks overlap
+	otherQuad.positionX = 140.f;
+
+	std::vector<unsigned long long> scratch;
+	for (int rotated = 0; rotated < 2; rotated++)
+	{
+		if (rotated != 0)
+		{
+			otherQuad.cosRotation = cosf(0.3f);
+			otherQuad.sinRotation = sinf(0.3f);
+		}
+
+		int numHits = 0;
+		const double start = GetTestSeconds2D();
+		for (int test = 0; test < kNumTests; test++)
+		{
+			numHits += AlphaMasksOverlap2D(&mask, quad, &mask, otherQuad, scratch) ? 1 : 0;
+		}
+		const double seconds = GetTestSeconds2D() - start;
+
+		printf("  %s: %.2f us per test (%d hits)\n", (rotated != 0) ? "rotated" : "aligned",
+			seconds * 1e6 / kNumTests, numHits);
+
+		// Masks that never touch would only time the early out
+		CHECK_2D( numHits == kNumTests );
+	}
+}
@@ -0,0 +1,203 @@
+//=======
+//
+// Purpose: Tests of the alpha masks and the pixel perfect overlap test
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "AlphaMask2d.hpp"
+
+namespace
+{
+	void ToWorld(const SpriteQuad2D &quad, double x, double y, double &worldX, double &worldY)
+	{
+		const double localX = (quad.offsetX + x) * quad.scaleX;
+		const double localY = (quad.offsetY + y) * quad.scaleY;
+		worldX = quad.cosRotation * localX - quad.sinRotation * localY + quad.positionX + quad.centerX;
+		worldY = quad.sinRotation * localX + quad.cosRotation * localY + quad.positionY + quad.centerY;
+	}
+
+	void FromWorld(const SpriteQuad2D &quad, double worldX, double worldY, double &x, double &y)
+	{
+		const double relativeX = worldX - quad.positionX - quad.centerX;
+		const double relativeY = worldY - quad.positionY - quad.centerY;
+		x = (quad.cosRotation * relativeX + quad.sinRotation * relativeY) / quad.scaleX - quad.offsetX;
+		y = (quad.cosRotation * relativeY - quad.sinRotation * relativeX) / quad.scaleY - quad.offsetY;
+	}
+
+	// Looks up the center of every set pixel of one mask in the other one
+	bool MasksOverlapPerPixel(const AlphaMask2D *mask, const SpriteQuad2D &quad, const AlphaMask2D *otherMask, const SpriteQuad2D &otherQuad)
+	{
+		if (mask == NULL)
+		{
+			return (otherMask == NULL) || MasksOverlapPerPixel(otherMask, otherQuad, mask, quad);
+		}
+
+		const int otherWidth = (otherMask != NULL) ? otherMask->GetWidth() : static_cast<int>(ceil(otherQuad.width));
+		const int otherHeight = (otherMask != NULL) ? otherMask->GetHeight() : static_cast<int>(ceil(otherQuad.height));
+
+		for (int y = 0; y < mask->GetHeight(); y++)
+		{
+			for (int x = 0; x < mask->GetWidth(); x++)
+			{
+				if (!mask->GetPixel(x, y))
+				{
+					continue;
+				}
+
+				double worldX;
+				double worldY;
+				ToWorld(quad, (x + 0.5) * quad.width / static_cast<double>(mask->GetWidth()),
+					(y + 0.5) * quad.height / static_cast<double>(mask->GetHeight()), worldX, worldY);
+
+				double otherX;
+				double otherY;
+				FromWorld(otherQuad, worldX, worldY, otherX, otherY);
+				otherX /= otherQuad.width / static_cast<double>(otherWidth);
+				otherY /= otherQuad.height / static_cast<double>(otherHeight);
+
+				if ( otherX >= 0.0 && otherX < otherWidth && otherY >= 0.0 && otherY < otherHeight &&
+					 (otherMask == NULL || otherMask->GetPixel(static_cast<int>(otherX), static_cast<int>(otherY))) )
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	// Sparse disc of pixels somewhere on the mask
+	void FillMask(TestRandom2D &random, AlphaMask2D &mask, int width, int height)
+	{
+		mask.Create(width, height);
+
+		const float density = random.NextFloat(0.f, 0.2f);
+		const float centerX = random.NextFloat(0.f, static_cast<float>(width));
+		const float centerY = random.NextFloat(0.f, static_cast<float>(height));
+		const float radius = random.NextFloat(1.f, static_cast<float>(width));
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				const float distanceX = static_cast<float>(x) - centerX;
+				const float distanceY = static_cast<float>(y) - centerY;
+				const bool set = random.NextFloat(0.f, 1.f) < density &&
+					distanceX * distanceX + distanceY * distanceY < radius * radius;
+				mask.SetPixel(x, y, set);
+			}
+		}
+	}
+
+	SpriteQuad2D MakeQuad(float x, float y, int width, int height)
+	{
+		const SpriteQuad2D quad =
+		{
+			x, y, 0.f, 0.f,
+			static_cast<float>(-(width / 2)), static_cast<float>(-(height / 2)),
+			static_cast<float>(width), static_cast<float>(height),
+			1.f, 1.f, 1.f, 0.f,
+			0.f, 0.f, 1.f, 1.f
+		};
+		return quad;
+	}
+}
+
+TEST_2D(AlphaMask2D_Pixels)
+{
+	AlphaMask2D mask;
+	CHECK_2D( mask.IsEmpty() );
+
+	mask.Create(130, 3);
+	CHECK_2D( !mask.IsEmpty() );
+	CHECK_2D( mask.GetWidth() == 130 && mask.GetHeight() == 3 && mask.GetWordsPerRow() == 3 );
+
+	mask.SetPixel(0, 0, true);
+	mask.SetPixel(64, 1, true);
+	mask.SetPixel(129, 2, true);
+	CHECK_2D( mask.GetPixel(0, 0) && mask.GetPixel(64, 1) && mask.GetPixel(129, 2) );
+	CHECK_2D( !mask.GetPixel(1, 0) && !mask.GetPixel(64, 0) );
+	CHECK_2D( mask.GetRow(1)[1] == 1 && mask.GetRow(2)[2] == 2 );
+
+	mask.SetPixel(64, 1, false);
+	CHECK_2D( mask.GetRow(1)[1] == 0 );
+
+	mask.Create(0, 5);
+	CHECK_2D( mask.IsEmpty() && mask.GetWidth() == 0 );
+}
+
+TEST_2D(AlphaMask2D_AlignedOverlap)
+{
+	std::vector<unsigned long long> scratch;
+
+	// Two single pixels, one row and 70 columns apart within their masks
+	AlphaMask2D mask;
+	mask.Create(100, 4);
+	mask.SetPixel(90, 2, true);
+
+	AlphaMask2D otherMask;
+	otherMask.Create(100, 4);
+	otherMask.SetPixel(20, 1, true);
+
+	const SpriteQuad2D quad = MakeQuad(0.f, 0.f, 100, 4);
+	CHECK_2D( !AlphaMasksOverlap2D(&mask, quad, &otherMask, quad, scratch) );
+	CHECK_2D( AlphaMasksOverlap2D(&mask, quad, &otherMask, MakeQuad(70.f, 1.f, 100, 4), scratch) );
+	CHECK_2D( AlphaMasksOverlap2D(&otherMask, MakeQuad(70.f, 1.f, 100, 4), &mask, quad, scratch) );
+	CHECK_2D( !AlphaMasksOverlap2D(&mask, quad, &otherMask, MakeQuad(71.f, 1.f, 100, 4), scratch) );
+
+	// Solid quads and empty masks
+	CHECK_2D( AlphaMasksOverlap2D(&mask, quad, NULL, MakeQuad(40.f, 0.f, 1, 1), scratch) );
+	CHECK_2D( !AlphaMasksOverlap2D(&mask, quad, NULL, MakeQuad(41.f, 0.f, 1, 1), scratch) );
+	CHECK_2D( AlphaMasksOverlap2D(NULL, quad, NULL, quad, scratch) );
+
+	AlphaMask2D emptyMask;
+	CHECK_2D( AlphaMasksOverlap2D(&emptyMask, quad, NULL, quad, scratch) );
+}
+
+TEST_2D(AlphaMask2D_OverlapMatchesPerPixel)
+{
+	TestRandom2D random(7);
+	std::vector<unsigned long long> scratch;
+
+	for (int test = 0; test < 4000; test++)
+	{
+		const int width = 1 + random.NextInt(150);
+		const int height = 1 + random.NextInt(40);
+		const int otherWidth = 1 + random.NextInt(150);
+		const int otherHeight = 1 + random.NextInt(40);
+
+		AlphaMask2D mask;
+		AlphaMask2D otherMask;
+		FillMask(random, mask, width, height);
+		FillMask(random, otherMask, otherWidth, otherHeight);
+
+		SpriteQuad2D quad = MakeQuad(static_cast<float>(random.NextInt(100)), static_cast<float>(random.NextInt(30)), width, height);
+		SpriteQuad2D otherQuad = MakeQuad(static_cast<float>(random.NextInt(100)), static_cast<float>(random.NextInt(30)), otherWidth, otherHeight);
+
+		// Half of the pairs take the resampling path
+		if (random.NextBool())
+		{
+			const float rotation = random.NextFloat(0.f, 6.3f);
+			const float otherRotation = random.NextFloat(0.f, 6.3f);
+			quad.cosRotation = cosf(rotation);
+			quad.sinRotation = sinf(rotation);
+			otherQuad.cosRotation = cosf(otherRotation);
+			otherQuad.sinRotation = sinf(otherRotation);
+			quad.scaleX = random.NextFloat(0.3f, 2.f);
+			quad.scaleY = random.NextBool() ? random.NextFloat(0.3f, 2.f) : random.NextFloat(-2.f, -0.3f);
+			otherQuad.scaleX = random.NextBool() ? random.NextFloat(0.3f, 2.f) : random.NextFloat(-2.f, -0.3f);
+			otherQuad.scaleY = random.NextFloat(0.3f, 2.f);
+			quad.width *= random.NextFloat(0.5f, 2.f);
+			otherQuad.height *= random.NextFloat(0.5f, 2.f);
+			quad.positionX += random.NextFloat(0.f, 1.f);
+			otherQuad.positionY += random.NextFloat(0.f, 1.f);
+		}
+
+		const AlphaMask2D *testedMask = (random.NextInt(8) != 0) ? &mask : NULL;
+		const AlphaMask2D *testedOtherMask = (random.NextInt(8) != 0) ? &otherMask : NULL;
+
+		CHECK_2D( AlphaMasksOverlap2D(testedMask, quad, testedOtherMask, otherQuad, scratch) ==
+				  MasksOverlapPerPixel(testedMask, quad, testedOtherMask, otherQuad) );
+	}
+}
@@ -0,0 +1,177 @@
+//=======
+//
+// Purpose: Tests of the skyline atlas packer
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "AtlasPacker2d.hpp"
+
+TEST_2D(AtlasPacker2D_Insert)
+{
+	AtlasPacker2D packer(64, 1);
+	CHECK_2D( packer.GetNumPages() == 0 );
+
+	int page = -1;
+	AtlasRect2D rect;
+	CHECK_2D( packer.Insert(10, 20, page, rect) );
+	CHECK_2D( page == 0 && packer.GetNumPages() == 1 );
+	CHECK_2D( rect.x == 1 && rect.y == 1 && rect.width == 10 && rect.height == 20 );
+
+	// Exactly a page with its padding, and one pixel too many
+	CHECK_2D( packer.Insert(62, 62, page, rect) );
+	CHECK_2D( page == 1 );
+	CHECK_2D( !packer.Insert(63, 1, page, rect) );
+	CHECK_2D( packer.GetNumPages() == 2 );
+
+	// Changing the layout starts over
+	packer.SetPadding(0);
+	CHECK_2D( packer.GetNumPages() == 0 && packer.GetPadding() == 0 );
+	CHECK_2D( packer.Insert(64, 64, page, rect) );
+	CHECK_2D( page == 0 && rect.x == 0 && rect.y == 0 );
+
+	packer.SetPageSize(32);
+	CHECK_2D( packer.GetNumPages() == 0 && packer.GetPageSize() == 32 );
+	CHECK_2D( !packer.Insert(64, 64, page, rect) );
+}
+
+TEST_2D(AtlasPacker2D_PaddedImagesStayApartAndOnThePage)
+{
+	TestRandom2D random(3);
+	const int kPageSize = 512;
+
+	for (int trial = 0; trial < 50; trial++)
+	{
+		AtlasPacker2D packer(kPageSize, random.NextInt(4));
+		const int padding = packer.GetPadding();
+
+		std::vector<int> pages;
+		std::vector<AtlasRect2D> rects;
+		long long paddedArea = 0;
+		for (int image = 0; image < 300; image++)
+		{
+			const int width = 1 + random.NextInt(120);
+			const int height = 1 + random.NextInt(120);
+
+			int page;
+			AtlasRect2D rect;
+			CHECK_2D( packer.Insert(width, height, page, rect) );
+			CHECK_2D( rect.width == width && rect.height == height );
+			CHECK_2D( page >= 0 && page < packer.GetNumPages() );
+
+			// The padding around the image is on the page too
+			CHECK_2D( rect.x - padding >= 0 && rect.y - padding >= 0 );
+			CHECK_2D( rect.x + width + padding <= kPageSize && rect.y + height + padding <= kPageSize );
+
+			// Padded rectangles never overlap, so there are at least two paddings between images
+			for (size_t other = 0; other < rects.size(); other++)
+			{
+				const AtlasRect2D &otherRect = rects[other];
+				const bool overlap =
+					rect.x - padding < otherRect.x + otherRect.width + padding &&
+					otherRect.x - padding < rect.x + rect.width + padding &&
+					rect.y - padding < otherRect.y + otherRect.height + padding &&
+					otherRect.y - padding < rect.y + rect.height + padding;
+				CHECK_2D( pages[other] != page || !overlap );
+			}
+
+			pages.push_back(page);
+			rects.push_back(rect);
+			paddedArea += static_cast<long long>(width + padding * 2) * (height + padding * 2);
+		}
+
+		// Pages are filled reasonably before new ones are opened
+		CHECK_2D( paddedArea > static_cast<long long>(packer.GetNumPages() - 1) * kPageSize * kPageSize * 6 / 10 );
+	}
+}
+
+TEST_2D(AtlasPacker2D_SpillsOntoNewPages)
+{
+	AtlasPacker2D packer(64, 0);
+	int page;
+	AtlasRect2D rect;
+
+	// Four quarters fill the first page exactly
+	for (int image = 0; image < 4; image++)
+	{
+		CHECK_2D( packer.Insert(32, 32, page, rect) );
+		CHECK_2D( page == 0 );
+	}
+	CHECK_2D( packer.GetNumPages() == 1 );
+
+	CHECK_2D( packer.Insert(32, 32, page, rect) );
+	CHECK_2D( page == 1 && rect.x == 0 && rect.y == 0 );
+
+	CHECK_2D( packer.Insert(64, 64, page, rect) );
+	CHECK_2D( page == 2 );
+	CHECK_2D( packer.GetNumPages() == 3 );
+
+	// Earlier pages with room left are filled up first
+	CHECK_2D( packer.Insert(16, 16, page, rect) );
+	CHECK_2D( page == 1 );
+
+	packer.Clear();
+	CHECK_2D( packer.GetNumPages() == 0 );
+	CHECK_2D( packer.Insert(64, 64, page, rect) );
+	CHECK_2D( page == 0 );
+}
+
+TEST_2D(AtlasPacker2D_UvTransform)
+{
+	AtlasPacker2D packer(256, 2);
+	const AtlasRect2D rect = { 64, 32, 16, 128 };
+
+	float offsetU;
+	float offsetV;
+	float scaleU;
+	float scaleV;
+	packer.GetUvTransform(rect, offsetU, offsetV, scaleU, scaleV);
+	CHECK_2D( offsetU == 0.25f && offsetV == 0.125f );
+	CHECK_2D( scaleU == 0.0625f && scaleV == 0.5f );
+
+	// The corners of the image, not of its padding
+	CHECK_2D( offsetU + scaleU == (64.f + 16.f) / 256.f );
+	CHECK_2D( offsetV + scaleV == (32.f + 128.f) / 256.f );
+
+	// Packed images map onto exactly their own texels
+	int page;
+	AtlasRect2D packed;
+	CHECK_2D( packer.Insert(30, 10, page, packed) );
+	packer.GetUvTransform(packed, offsetU, offsetV, scaleU, scaleV);
+	CHECK_2D( offsetU * 256.f == static_cast<float>(packed.x) && offsetV * 256.f == static_cast<float>(packed.y) );
+	CHECK_2D( scaleU * 256.f == 30.f && scaleV * 256.f == 10.f );
+}
+
+TEST_2D(AtlasPacker2D_CopyWithBorder)
+{
+	const unsigned int source[6] =
+	{
+		1, 2, 3,
+		4, 5, 6
+	};
+
+	// Edges and corners are repeated outwards
+	const unsigned int bordered[7 * 6] =
+	{
+		1, 1, 1, 2, 3, 3, 3,
+		1, 1, 1, 2, 3, 3, 3,
+		1, 1, 1, 2, 3, 3, 3,
+		4, 4, 4, 5, 6, 6, 6,
+		4, 4, 4, 5, 6, 6, 6,
+		4, 4, 4, 5, 6, 6, 6
+	};
+	unsigned int dest[7 * 6];
+	AtlasPacker2D::CopyWithBorder(source, 3, 2, 2, dest);
+	for (int pixel = 0; pixel < 7 * 6; pixel++)
+	{
+		CHECK_2D( dest[pixel] == bordered[pixel] );
+	}
+
+	// No padding is a plain copy
+	AtlasPacker2D::CopyWithBorder(source, 3, 2, 0, dest);
+	for (int pixel = 0; pixel < 6; pixel++)
+	{
+		CHECK_2D( dest[pixel] == source[pixel] );
+	}
+}
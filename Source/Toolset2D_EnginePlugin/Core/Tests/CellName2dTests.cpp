@@ -0,0 +1,29 @@
+//=======
+//
+// Purpose: Tests of splitting cell names into state name and frame number
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "CellName2d.hpp"
+
+TEST_2D(CellName2D_Parse)
+{
+	std::string stateName;
+	int frameNumber = -1;
+
+	CHECK_2D( ParseCellName2D("walk_0003.png", stateName, frameNumber) );
+	CHECK_2D( stateName == "walk" && frameNumber == 3 );
+
+	// The last underscore separates the frame number
+	CHECK_2D( ParseCellName2D("enemy_ship_12", stateName, frameNumber) );
+	CHECK_2D( stateName == "enemy_ship" && frameNumber == 12 );
+
+	frameNumber = -1;
+	CHECK_2D( !ParseCellName2D("background.png", stateName, frameNumber) );
+	CHECK_2D( stateName == "background" && frameNumber == -1 );
+
+	CHECK_2D( !ParseCellName2D("background", stateName, frameNumber) );
+	CHECK_2D( stateName == "background" );
+}
@@ -0,0 +1,434 @@
+//=======
+//
+// Purpose: Tests of the quad, hull and polygon overlap tests
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "Collision2d.hpp"
+
+#include <algorithm>
+
+namespace
+{
+	// Corners of an axis aligned rectangle in QuadCorner2D order
+	void MakeRectangle(float x, float y, float width, float height, float *cornersX, float *cornersY)
+	{
+		cornersX[QUAD_TOP_LEFT] = x;
+		cornersY[QUAD_TOP_LEFT] = y;
+		cornersX[QUAD_TOP_RIGHT] = x + width;
+		cornersY[QUAD_TOP_RIGHT] = y;
+		cornersX[QUAD_BOTTOM_LEFT] = x;
+		cornersY[QUAD_BOTTOM_LEFT] = y + height;
+		cornersX[QUAD_BOTTOM_RIGHT] = x + width;
+		cornersY[QUAD_BOTTOM_RIGHT] = y + height;
+	}
+
+	void MakeRandomHull(TestRandom2D &random, float centerX, float centerY, float radius, std::vector<Vertex2D> &hull)
+	{
+		do
+		{
+			std::vector<Vertex2D> points(3 + random.NextInt(8));
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				points[i].x = centerX + random.NextFloat(-radius, radius);
+				points[i].y = centerY + random.NextFloat(-radius, radius);
+			}
+			BuildConvexHull2D(points, hull);
+		}
+		while (hull.size() < 3);
+	}
+
+	std::vector<Vertex2D> Moved(const std::vector<Vertex2D> &vertices, float moveX, float moveY)
+	{
+		std::vector<Vertex2D> moved(vertices);
+		for (size_t i = 0; i < moved.size(); i++)
+		{
+			moved[i].x += moveX;
+			moved[i].y += moveY;
+		}
+		return moved;
+	}
+
+	bool Overlap(const std::vector<Vertex2D> &vertices, const std::vector<Vertex2D> &otherVertices)
+	{
+		return ConvexPolygonsOverlap2D(&vertices[0], static_cast<int>(vertices.size()),
+			&otherVertices[0], static_cast<int>(otherVertices.size()));
+	}
+
+	struct ClipPoint
+	{
+		double x;
+		double y;
+	};
+
+	typedef std::vector<ClipPoint> ClipPolygon;
+
+	double Cross(const ClipPoint &a, const ClipPoint &b, const ClipPoint &c)
+	{
+		return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	}
+
+	double GetSignedArea(const ClipPolygon &polygon)
+	{
+		double area = 0.0;
+		for (size_t i = 0; i < polygon.size(); i++)
+		{
+			const ClipPoint &a = polygon[i];
+			const ClipPoint &b = polygon[(i + 1) % polygon.size()];
+			area += a.x * b.y - b.x * a.y;
+		}
+		return area * 0.5;
+	}
+
+	// Quad corners in outline order, counter clockwise
+	ClipPolygon GetQuadOutline(const float *cornersX, const float *cornersY)
+	{
+		const int order[QUAD_NUM_CORNERS] = { QUAD_TOP_LEFT, QUAD_TOP_RIGHT, QUAD_BOTTOM_RIGHT, QUAD_BOTTOM_LEFT };
+
+		ClipPolygon outline(QUAD_NUM_CORNERS);
+		for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+		{
+			outline[corner].x = cornersX[order[corner]];
+			outline[corner].y = cornersY[order[corner]];
+		}
+		if (GetSignedArea(outline) < 0.0)
+		{
+			std::reverse(outline.begin(), outline.end());
+		}
+		return outline;
+	}
+
+	// Scaled up around its center by a thousandth
+	ClipPolygon Grown(const ClipPolygon &polygon)
+	{
+		ClipPoint center = { 0.0, 0.0 };
+		for (size_t i = 0; i < polygon.size(); i++)
+		{
+			center.x += polygon[i].x / static_cast<double>(polygon.size());
+			center.y += polygon[i].y / static_cast<double>(polygon.size());
+		}
+
+		ClipPolygon grown(polygon);
+		for (size_t i = 0; i < grown.size(); i++)
+		{
+			grown[i].x = center.x + (grown[i].x - center.x) * 1.001;
+			grown[i].y = center.y + (grown[i].y - center.y) * 1.001;
+		}
+		return grown;
+	}
+
+	// Sutherland-Hodgman, clipping the subject by every edge of the counter clockwise clip polygon
+	double GetOverlapArea(ClipPolygon subject, const ClipPolygon &clip)
+	{
+		for (size_t edge = 0; edge < clip.size() && !subject.empty(); edge++)
+		{
+			const ClipPoint &start = clip[edge];
+			const ClipPoint &end = clip[(edge + 1) % clip.size()];
+
+			ClipPolygon clipped;
+			for (size_t i = 0; i < subject.size(); i++)
+			{
+				const ClipPoint &point = subject[i];
+				const ClipPoint &next = subject[(i + 1) % subject.size()];
+				const double side = Cross(start, end, point);
+				const double nextSide = Cross(start, end, next);
+
+				if (side >= 0.0)
+				{
+					clipped.push_back(point);
+				}
+				if ((side >= 0.0) != (nextSide >= 0.0))
+				{
+					const double along = side / (side - nextSide);
+					ClipPoint crossing;
+					crossing.x = point.x + (next.x - point.x) * along;
+					crossing.y = point.y + (next.y - point.y) * along;
+					clipped.push_back(crossing);
+				}
+			}
+			subject.swap(clipped);
+		}
+
+		return fabs(GetSignedArea(subject));
+	}
+}
+
+TEST_2D(Collision2D_QuadsOverlap)
+{
+	float x[QUAD_NUM_CORNERS];
+	float y[QUAD_NUM_CORNERS];
+	float otherX[QUAD_NUM_CORNERS];
+	float otherY[QUAD_NUM_CORNERS];
+
+	MakeRectangle(0, 0, 10, 10, x, y);
+
+	MakeRectangle(5, 5, 10, 10, otherX, otherY);
+	CHECK_2D( QuadsOverlap2D(x, y, otherX, otherY) );
+
+	MakeRectangle(20, 0, 10, 10, otherX, otherY);
+	CHECK_2D( !QuadsOverlap2D(x, y, otherX, otherY) );
+
+	// Touching edges count as overlapping
+	MakeRectangle(10, 0, 10, 10, otherX, otherY);
+	CHECK_2D( QuadsOverlap2D(x, y, otherX, otherY) );
+
+	// A cross where neither quad holds a corner of the other
+	MakeRectangle(-5, 3, 20, 4, otherX, otherY);
+	MakeRectangle(3, -5, 4, 20, x, y);
+	CHECK_2D( QuadsOverlap2D(x, y, otherX, otherY) );
+	CHECK_2D( QuadsOverlap2D(otherX, otherY, x, y) );
+
+	// Diamond next to the corner of a square, overlapping bounding boxes but apart
+	MakeRectangle(0, 0, 10, 10, x, y);
+	const float diamondX[QUAD_NUM_CORNERS] = { 14, 18, 10, 14 };
+	const float diamondY[QUAD_NUM_CORNERS] = { 10, 14, 14, 18 };
+	CHECK_2D( !QuadsOverlap2D(x, y, diamondX, diamondY) );
+	CHECK_2D( !QuadsOverlap2D(diamondX, diamondY, x, y) );
+}
+
+TEST_2D(Collision2D_QuadsOverlapMatchesClipping)
+{
+	TestRandom2D random(7);
+
+	int numHits = 0;
+	for (int test = 0; test < 200000; test++)
+	{
+		// Rotated, scaled and mirrored rectangles placed the way SpriteQuads2D does it
+		float cornersX[2][QUAD_NUM_CORNERS];
+		float cornersY[2][QUAD_NUM_CORNERS];
+		for (int quad = 0; quad < 2; quad++)
+		{
+			const float rotation = random.NextFloat(0.f, 6.283f);
+			const float width = random.NextFloat(1.f, 40.f);
+			const float height = random.NextFloat(1.f, 40.f);
+			const float scaleX = random.NextBool() ? 1.f : -1.f;
+			const float scaleY = random.NextFloat(0.3f, 2.f);
+			const float positionX = random.NextFloat(0.f, 60.f);
+			const float positionY = random.NextFloat(0.f, 60.f);
+			const float offsetX = random.NextFloat(-20.f, 0.f);
+			const float offsetY = random.NextFloat(-20.f, 0.f);
+
+			const float rectangleX[QUAD_NUM_CORNERS] = { 0.f, width, 0.f, width };
+			const float rectangleY[QUAD_NUM_CORNERS] = { 0.f, 0.f, height, height };
+			for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+			{
+				const float localX = scaleX * (offsetX + rectangleX[corner]);
+				const float localY = scaleY * (offsetY + rectangleY[corner]);
+				cornersX[quad][corner] = positionX + cosf(rotation) * localX - sinf(rotation) * localY;
+				cornersY[quad][corner] = positionY + sinf(rotation) * localX + cosf(rotation) * localY;
+			}
+		}
+
+		const bool overlap = QuadsOverlap2D(cornersX[0], cornersY[0], cornersX[1], cornersY[1]);
+		const double area = GetOverlapArea(GetQuadOutline(cornersX[0], cornersY[0]), GetQuadOutline(cornersX[1], cornersY[1]));
+
+		// Touching quads overlap without any area, but they do once one of them grows a little
+		if (overlap)
+		{
+			CHECK_2D( area > 1e-3 ||
+					  GetOverlapArea(Grown(GetQuadOutline(cornersX[0], cornersY[0])), GetQuadOutline(cornersX[1], cornersY[1])) > 0.0 );
+			numHits++;
+		}
+		else
+		{
+			CHECK_2D( area <= 1e-3 );
+		}
+	}
+
+	// Enough of both outcomes to mean something
+	CHECK_2D( numHits > 20000 && numHits < 180000 );
+}
+
+TEST_2D(Collision2D_ConvexHull)
+{
+	std::vector<Vertex2D> points;
+	const float coordinates[][2] =
+	{
+		{ 0, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 },
+		{ 2, 2 }, { 1, 3 }, { 2, 0 }, { 4, 2 }, { 0, 0 }
+	};
+	for (size_t i = 0; i < sizeof(coordinates) / sizeof(coordinates[0]); i++)
+	{
+		Vertex2D point;
+		point.x = coordinates[i][0];
+		point.y = coordinates[i][1];
+		points.push_back(point);
+	}
+
+	// Interior, duplicate and collinear points are all dropped
+	std::vector<Vertex2D> hull;
+	BuildConvexHull2D(points, hull);
+	CHECK_2D( hull.size() == 4 );
+
+	// Counter clockwise with y pointing up
+	float area = 0.f;
+	for (size_t i = 0; i < hull.size(); i++)
+	{
+		const Vertex2D &a = hull[i];
+		const Vertex2D &b = hull[(i + 1) % hull.size()];
+		area += a.x * b.y - b.x * a.y;
+	}
+	CHECK_CLOSE_2D( area * 0.5f, 16.0, 1e-4 );
+
+	points.resize(2);
+	BuildConvexHull2D(points, hull);
+	CHECK_2D( hull.size() == 2 );
+}
+
+TEST_2D(Collision2D_PlacedHullMatchesQuad)
+{
+	// A hull covering the whole rectangle ends up on the corners of the quad
+	SpriteQuad2D quad = { 3, 4, 10, 8, -2, 1, 20, 16, 1.5f, -0.5f, 0, 0, 0, 0, 1, 1 };
+	quad.cosRotation = cosf(0.7f);
+	quad.sinRotation = sinf(0.7f);
+
+	float cornersX[QUAD_NUM_CORNERS];
+	float cornersY[QUAD_NUM_CORNERS];
+	SpriteQuads2D::ComputeCorners(quad, cornersX, cornersY);
+
+	const Vertex2D rectangle[QUAD_NUM_CORNERS] = { { -10, -8 }, { 10, -8 }, { -10, 8 }, { 10, 8 } };
+	Vertex2D placed[QUAD_NUM_CORNERS];
+	PlaceHull2D(quad, rectangle, QUAD_NUM_CORNERS, placed);
+
+	for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+	{
+		CHECK_CLOSE_2D( placed[corner].x, cornersX[corner], 1e-4 );
+		CHECK_CLOSE_2D( placed[corner].y, cornersY[corner], 1e-4 );
+	}
+}
+
+TEST_2D(Collision2D_HullsOverlap)
+{
+	const Vertex2D square[4] = { { 0, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 } };
+
+	const Vertex2D apart[3] = { { 5, 0 }, { 8, 0 }, { 5, 3 } };
+	CHECK_2D( !ConvexPolygonsOverlap2D(square, 4, apart, 3) );
+
+	const Vertex2D overlapping[3] = { { 3, 3 }, { 6, 3 }, { 3, 6 } };
+	CHECK_2D( ConvexPolygonsOverlap2D(square, 4, overlapping, 3) );
+	CHECK_2D( ConvexPolygonsOverlap2D(overlapping, 3, square, 4) );
+
+	// Wound the other way
+	const Vertex2D clockwise[3] = { { 3, 3 }, { 3, 6 }, { 6, 3 } };
+	CHECK_2D( ConvexPolygonsOverlap2D(square, 4, clockwise, 3) );
+
+	// Touching edges count as overlapping
+	const Vertex2D touching[3] = { { 4, 1 }, { 7, 1 }, { 4, 4 } };
+	CHECK_2D( ConvexPolygonsOverlap2D(square, 4, touching, 3) );
+
+	// Diamond next to the corner of the square, overlapping bounding boxes but apart
+	const Vertex2D diamond[4] = { { 5, 4 }, { 6, 5 }, { 5, 6 }, { 4, 5 } };
+	CHECK_2D( !ConvexPolygonsOverlap2D(square, 4, diamond, 4) );
+	CHECK_2D( !ConvexPolygonsOverlap2D(diamond, 4, square, 4) );
+}
+
+TEST_2D(Collision2D_SweepMatchesSampling)
+{
+	TestRandom2D random(3);
+	const int kNumSteps = 1000;
+
+	for (int test = 0; test < 2000; test++)
+	{
+		std::vector<Vertex2D> polygon;
+		std::vector<Vertex2D> otherPolygon;
+		MakeRandomHull(random, random.NextFloat(-200, 200), random.NextFloat(-200, 200), random.NextFloat(1, 40), polygon);
+		MakeRandomHull(random, random.NextFloat(-200, 200), random.NextFloat(-200, 200), random.NextFloat(1, 40), otherPolygon);
+
+		const float moveX = random.NextFloat(-400, 400);
+		const float moveY = random.NextFloat(-400, 400);
+		const float otherMoveX = random.NextBool() ? random.NextFloat(-400, 400) : 0.f;
+		const float otherMoveY = random.NextBool() ? random.NextFloat(-400, 400) : 0.f;
+
+		float timeOfImpact = -1.f;
+		const bool hit = SweepConvexPolygons2D(&polygon[0], static_cast<int>(polygon.size()), moveX, moveY,
+			&otherPolygon[0], static_cast<int>(otherPolygon.size()), otherMoveX, otherMoveY, timeOfImpact);
+
+		// The polygons are given where they end up, so step them back along the move
+		float firstTouch = -1.f;
+		for (int step = 0; step <= kNumSteps && firstTouch < 0.f; step++)
+		{
+			const float time = static_cast<float>(step) / kNumSteps;
+			if ( Overlap(Moved(polygon, (time - 1.f) * moveX, (time - 1.f) * moveY),
+						 Moved(otherPolygon, (time - 1.f) * otherMoveX, (time - 1.f) * otherMoveY)) )
+			{
+				firstTouch = time;
+			}
+		}
+
+		// Sampling can miss grazing contacts, but never finds one the sweep doesn't
+		if (firstTouch >= 0.f)
+		{
+			CHECK_2D( hit && timeOfImpact <= firstTouch + 1e-5f );
+		}
+		if (hit)
+		{
+			CHECK_2D( timeOfImpact >= 0.f && timeOfImpact <= 1.f );
+		}
+	}
+}
+
+TEST_2D(Collision2D_PointDistanceAndRaycast)
+{
+	TestRandom2D random(11);
+	const int kNumSamples = 400;
+
+	for (int test = 0; test < 3000; test++)
+	{
+		std::vector<Vertex2D> polygon;
+		MakeRandomHull(random, 0.f, 0.f, 5.f, polygon);
+		if (random.NextBool())
+		{
+			std::reverse(polygon.begin(), polygon.end());
+		}
+		const int numVertices = static_cast<int>(polygon.size());
+
+		const float x = random.NextFloat(-8, 8);
+		const float y = random.NextFloat(-8, 8);
+		const float distance = ConvexPolygonPointDistance2D(&polygon[0], numVertices, x, y);
+
+		// Closest point on the edges, sampled
+		float closest = 1e9f;
+		bool inside = true;
+		for (int vertex = 0; vertex < numVertices; vertex++)
+		{
+			const Vertex2D &start = polygon[vertex];
+			const Vertex2D &end = polygon[(vertex + 1) % numVertices];
+			for (int sample = 0; sample <= kNumSamples; sample++)
+			{
+				const float along = static_cast<float>(sample) / kNumSamples;
+				const float offsetX = start.x + (end.x - start.x) * along - x;
+				const float offsetY = start.y + (end.y - start.y) * along - y;
+				closest = std::min(closest, sqrtf(offsetX * offsetX + offsetY * offsetY));
+			}
+
+			const Vertex2D &next = polygon[(vertex + 2) % numVertices];
+			const float side = (end.x - start.x) * (y - start.y) - (end.y - start.y) * (x - start.x);
+			const float winding = (end.x - start.x) * (next.y - start.y) - (end.y - start.y) * (next.x - start.x);
+			inside = inside && (side * winding >= 0.f);
+		}
+		CHECK_CLOSE_2D( distance, inside ? 0.f : closest, 0.05 );
+
+		const float endX = random.NextFloat(-8, 8);
+		const float endY = random.NextFloat(-8, 8);
+		float fraction = -1.f;
+		const bool hit = RaycastConvexPolygon2D(&polygon[0], numVertices, x, y, endX, endY, fraction);
+
+		float firstInside = -1.f;
+		for (int sample = 0; sample <= kNumSamples && firstInside < 0.f; sample++)
+		{
+			const float along = static_cast<float>(sample) / kNumSamples;
+			if (ConvexPolygonPointDistance2D(&polygon[0], numVertices, x + (endX - x) * along, y + (endY - y) * along) == 0.f)
+			{
+				firstInside = along;
+			}
+		}
+
+		if (firstInside >= 0.f)
+		{
+			CHECK_2D( hit );
+			CHECK_CLOSE_2D( fraction, firstInside, 1.0 / kNumSamples + 1e-4 );
+		}
+	}
+}
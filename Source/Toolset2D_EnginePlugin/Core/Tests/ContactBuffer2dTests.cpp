@@ -0,0 +1,114 @@
+//=======
+//
+// Purpose: Tests of the begin, stay and end events of the contact buffer
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "ContactBuffer2d.hpp"
+
+#include <map>
+#include <set>
+#include <utility>
+
+namespace
+{
+	typedef std::pair<long long, long long> Pair;
+}
+
+TEST_2D(ContactBuffer2D_EventsMatchReference)
+{
+	TestRandom2D random(5);
+	ContactBuffer2D buffer;
+	std::set<Pair> previous;
+
+	for (int frame = 0; frame < 500; frame++)
+	{
+		buffer.BeginFrame();
+
+		std::set<Pair> current;
+		const int numContacts = random.NextInt(30);
+		for (int contact = 0; contact < numContacts; contact++)
+		{
+			const long long id = random.NextInt(8);
+			const long long otherId = random.NextInt(8);
+			if (id == otherId)
+			{
+				continue;
+			}
+
+			// Pairs found more than once, either way around, are reported once
+			buffer.AddContact(id, static_cast<int>(id * 10), otherId, static_cast<int>(otherId * 10));
+			if (random.NextInt(3) == 0)
+			{
+				buffer.AddContact(otherId, static_cast<int>(otherId * 10), id, static_cast<int>(id * 10));
+			}
+			current.insert(Pair(std::min(id, otherId), std::max(id, otherId)));
+		}
+
+		buffer.EndFrame();
+
+		std::map<Pair, ContactState2D> expected;
+		for (std::set<Pair>::const_iterator it = current.begin(); it != current.end(); ++it)
+		{
+			expected[*it] = previous.count(*it) ? CONTACT_STAY : CONTACT_BEGIN;
+		}
+		for (std::set<Pair>::const_iterator it = previous.begin(); it != previous.end(); ++it)
+		{
+			if (current.count(*it) == 0)
+			{
+				expected[*it] = CONTACT_END;
+			}
+		}
+
+		CHECK_2D( buffer.GetNumEvents() == static_cast<int>(expected.size()) );
+		if (buffer.GetNumEvents() != static_cast<int>(expected.size()))
+		{
+			return;
+		}
+
+		int index = 0;
+		for (std::map<Pair, ContactState2D>::const_iterator it = expected.begin(); it != expected.end(); ++it, index++)
+		{
+			const Contact2D &event = buffer.GetEvent(index);
+			CHECK_2D( event.idA == it->first.first && event.idB == it->first.second );
+			CHECK_2D( event.state == it->second );
+			CHECK_2D( event.proxyA == event.idA * 10 && event.proxyB == event.idB * 10 );
+		}
+
+		previous.swap(current);
+	}
+}
+
+TEST_2D(ContactBuffer2D_EndedContactsKeepTheirTime)
+{
+	ContactBuffer2D buffer;
+
+	buffer.BeginFrame();
+	buffer.AddContact(7, 1, 3, 2, 0.25f);
+	buffer.EndFrame();
+	CHECK_2D( buffer.GetNumEvents() == 1 );
+	CHECK_2D( buffer.GetEvent(0).idA == 3 && buffer.GetEvent(0).proxyA == 2 );
+	CHECK_2D( buffer.GetEvent(0).state == CONTACT_BEGIN );
+	CHECK_2D( buffer.GetEvent(0).time == 0.25f );
+
+	buffer.BeginFrame();
+	buffer.EndFrame();
+	CHECK_2D( buffer.GetNumEvents() == 1 );
+	CHECK_2D( buffer.GetEvent(0).state == CONTACT_END );
+	CHECK_2D( buffer.GetEvent(0).time == 0.25f );
+
+	buffer.BeginFrame();
+	buffer.EndFrame();
+	CHECK_2D( buffer.GetNumEvents() == 0 );
+
+	// Cleared contacts don't end
+	buffer.BeginFrame();
+	buffer.AddContact(1, 0, 2, 0);
+	buffer.EndFrame();
+	buffer.Clear();
+	buffer.BeginFrame();
+	buffer.EndFrame();
+	CHECK_2D( buffer.GetNumEvents() == 0 );
+}
@@ -0,0 +1,180 @@
+//=======
+//
+// Purpose: Tests of the per frame timings and counters of the 2D pipeline
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "FrameStats2d.hpp"
+
+#include <string>
+
+namespace
+{
+	// One frame with 'milliseconds' of sprite time and 'count' sprites
+	void AddFrame(FrameStats2D &stats, float milliseconds, unsigned int count)
+	{
+		stats.BeginFrame();
+		stats.AddTime(FRAME_TIMER_SPRITES, milliseconds);
+		stats.AddCount(FRAME_COUNTER_SPRITES, count);
+		stats.EndFrame();
+	}
+
+	int CountChar(const std::string &text, char c)
+	{
+		int count = 0;
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			count += (text[i] == c) ? 1 : 0;
+		}
+		return count;
+	}
+}
+
+TEST_2D(FrameStats2D_BeginAndEndFrame)
+{
+	FrameStats2D stats(4);
+	CHECK_2D( stats.GetHistorySize() == 4 );
+	CHECK_2D( stats.GetNumFrames() == 0 );
+	CHECK_2D( !stats.EndFrame() );
+
+	// Added outside of a frame, ends up in the next one
+	stats.AddCount(FRAME_COUNTER_HITS, 2);
+	stats.BeginFrame();
+	stats.AddCount(FRAME_COUNTER_HITS);
+	stats.AddTime(FRAME_TIMER_RENDER, 1.5f);
+	stats.AddTime(FRAME_TIMER_RENDER, 0.5f);
+	CHECK_2D( stats.EndFrame() );
+	CHECK_2D( !stats.EndFrame() );
+
+	CHECK_2D( stats.GetNumFrames() == 1 );
+	CHECK_2D( stats.GetFrame(0).counters[FRAME_COUNTER_HITS] == 3 );
+	CHECK_CLOSE_2D( stats.GetFrame(0).milliseconds[FRAME_TIMER_RENDER], 2.f, 1e-6f );
+	CHECK_2D( stats.GetFrame(0).counters[FRAME_COUNTER_SPRITES] == 0 );
+
+	// Beginning a frame ends the open one
+	stats.BeginFrame();
+	stats.AddCount(FRAME_COUNTER_DRAW_CALLS, 7);
+	stats.BeginFrame();
+	CHECK_2D( stats.GetNumFrames() == 2 );
+	CHECK_2D( stats.GetFrame(0).counters[FRAME_COUNTER_DRAW_CALLS] == 7 );
+	CHECK_2D( stats.GetFrame(0).counters[FRAME_COUNTER_HITS] == 0 );
+	CHECK_2D( stats.EndFrame() );
+	CHECK_2D( stats.GetNumFrames() == 3 );
+	CHECK_2D( stats.GetFrame(0).counters[FRAME_COUNTER_DRAW_CALLS] == 0 );
+}
+
+TEST_2D(FrameStats2D_RingBufferWrapsAround)
+{
+	FrameStats2D stats(3);
+	for (unsigned int frame = 0; frame < 8; frame++)
+	{
+		AddFrame(stats, static_cast<float>(frame), frame);
+
+		const int expectedFrames = (frame < 3) ? static_cast<int>(frame) + 1 : 3;
+		CHECK_2D( stats.GetNumFrames() == expectedFrames );
+
+		// Newest first, older frames fall out of the history
+		for (int age = 0; age < stats.GetNumFrames(); age++)
+		{
+			CHECK_2D( stats.GetFrame(age).counters[FRAME_COUNTER_SPRITES] == frame - age );
+			CHECK_2D( stats.GetFrameNumber(age) == frame - age );
+		}
+	}
+
+	// Frame numbers keep counting past the history size
+	CHECK_2D( stats.GetFrameNumber(0) == 7 );
+	CHECK_2D( stats.GetFrameNumber(2) == 5 );
+}
+
+TEST_2D(FrameStats2D_SetHistorySizeDropsFrames)
+{
+	FrameStats2D stats(4);
+	AddFrame(stats, 1.f, 1);
+	AddFrame(stats, 2.f, 2);
+
+	stats.SetHistorySize(6);
+	CHECK_2D( stats.GetHistorySize() == 6 );
+	CHECK_2D( stats.GetNumFrames() == 0 );
+	CHECK_CLOSE_2D( stats.GetAverageTime(FRAME_TIMER_SPRITES), 0.f, 1e-6f );
+
+	// Frame numbers are not reset with the history
+	AddFrame(stats, 3.f, 3);
+	CHECK_2D( stats.GetNumFrames() == 1 );
+	CHECK_2D( stats.GetFrame(0).counters[FRAME_COUNTER_SPRITES] == 3 );
+	CHECK_2D( stats.GetFrameNumber(0) == 2 );
+
+	// At least one frame is kept
+	stats.SetHistorySize(0);
+	CHECK_2D( stats.GetHistorySize() == 1 );
+	AddFrame(stats, 4.f, 4);
+	AddFrame(stats, 5.f, 5);
+	CHECK_2D( stats.GetNumFrames() == 1 );
+	CHECK_2D( stats.GetFrame(0).counters[FRAME_COUNTER_SPRITES] == 5 );
+}
+
+TEST_2D(FrameStats2D_AverageAndMax)
+{
+	FrameStats2D stats(4);
+	CHECK_CLOSE_2D( stats.GetAverageTime(FRAME_TIMER_SPRITES), 0.f, 1e-6f );
+	CHECK_CLOSE_2D( stats.GetMaxTime(FRAME_TIMER_SPRITES), 0.f, 1e-6f );
+	CHECK_CLOSE_2D( stats.GetAverageCount(FRAME_COUNTER_SPRITES), 0.f, 1e-6f );
+
+	AddFrame(stats, 2.f, 10);
+	AddFrame(stats, 6.f, 20);
+	AddFrame(stats, 1.f, 30);
+	CHECK_CLOSE_2D( stats.GetAverageTime(FRAME_TIMER_SPRITES), 3.f, 1e-5f );
+	CHECK_CLOSE_2D( stats.GetMaxTime(FRAME_TIMER_SPRITES), 6.f, 1e-6f );
+	CHECK_CLOSE_2D( stats.GetAverageCount(FRAME_COUNTER_SPRITES), 20.f, 1e-5f );
+	CHECK_CLOSE_2D( stats.GetAverageTime(FRAME_TIMER_RENDER), 0.f, 1e-6f );
+
+	// Only over the frames still in the history, 6, 1, 3 and 4
+	AddFrame(stats, 3.f, 40);
+	AddFrame(stats, 4.f, 50);
+	CHECK_CLOSE_2D( stats.GetAverageTime(FRAME_TIMER_SPRITES), 3.5f, 1e-5f );
+	CHECK_CLOSE_2D( stats.GetMaxTime(FRAME_TIMER_SPRITES), 6.f, 1e-6f );
+	CHECK_CLOSE_2D( stats.GetAverageCount(FRAME_COUNTER_SPRITES), 35.f, 1e-5f );
+
+	AddFrame(stats, 0.5f, 0);
+	CHECK_CLOSE_2D( stats.GetMaxTime(FRAME_TIMER_SPRITES), 4.f, 1e-6f );
+
+	// Byte counts close to the limit of the counters
+	FrameStats2D bytes(2);
+	bytes.BeginFrame();
+	bytes.AddCount(FRAME_COUNTER_BYTES_UPLOADED, 4000000000u);
+	bytes.EndFrame();
+	bytes.BeginFrame();
+	bytes.AddCount(FRAME_COUNTER_BYTES_UPLOADED, 4000000001u);
+	bytes.EndFrame();
+	CHECK_CLOSE_2D( bytes.GetAverageCount(FRAME_COUNTER_BYTES_UPLOADED), 4000000000.f, 1000.f );
+}
+
+TEST_2D(FrameStats2D_CsvFormat)
+{
+	std::string header;
+	FrameStats2D::AppendCsvHeader(header);
+	CHECK_2D( header == "frame,updateMs,animationMs,spritesMs,collisionMs,sortMs,renderMs,"
+		"spritesUpdated,spritesCulled,pairTests,collisionHits,drawCalls,bytesUploaded,sheetLoads\n" );
+	CHECK_2D( CountChar(header, ',') == NUM_FRAME_TIMERS + NUM_FRAME_COUNTERS );
+
+	FrameStats2D stats(4);
+	stats.BeginFrame();
+	stats.AddTime(FRAME_TIMER_UPDATE, 1.25f);
+	stats.AddTime(FRAME_TIMER_RENDER, 0.0006f);
+	stats.AddCount(FRAME_COUNTER_SPRITES, 12);
+	stats.AddCount(FRAME_COUNTER_SHEET_LOADS);
+	stats.EndFrame();
+	AddFrame(stats, 2.f, 3);
+
+	// Appended after what is already there, times with three decimals
+	std::string csv = header;
+	stats.AppendCsvLine(1, csv);
+	stats.AppendCsvLine(0, csv);
+	CHECK_2D( csv == header +
+		"0,1.250,0.000,0.000,0.000,0.000,0.001,12,0,0,0,0,0,1\n"
+		"1,0.000,0.000,2.000,0.000,0.000,0.000,3,0,0,0,0,0,0\n" );
+
+	CHECK_2D( std::string(FrameStats2D::GetTimerName(FRAME_TIMER_COLLISION)) == "collisionMs" );
+	CHECK_2D( std::string(FrameStats2D::GetCounterName(FRAME_COUNTER_PAIR_TESTS)) == "pairTests" );
+}
@@ -0,0 +1,148 @@
+//=======
+//
+// Purpose: Tests of the path hash and the hash index behind the sprite data lookup
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "HashIndex2d.hpp"
+
+namespace
+{
+	// Indices in the chain of 'hash', in chain order
+	std::vector<int> GetChain(const HashIndex2D &hashIndex, unsigned int hash)
+	{
+		std::vector<int> chain;
+		for (int index = hashIndex.First(hash); index != -1; index = hashIndex.Next(index))
+		{
+			chain.push_back(index);
+		}
+		return chain;
+	}
+
+	int Count(const std::vector<int> &chain, int index)
+	{
+		int count = 0;
+		for (size_t i = 0; i < chain.size(); i++)
+		{
+			count += (chain[i] == index) ? 1 : 0;
+		}
+		return count;
+	}
+
+	// Same steps as Toolset2dManager::RemoveSpriteDataAt, the last entry fills the freed slot
+	void RemoveAt(HashIndex2D &hashIndex, std::vector<unsigned int> &hashes, int index)
+	{
+		hashIndex.Remove(hashes[index], index);
+
+		const int lastIndex = static_cast<int>(hashes.size()) - 1;
+		if (index != lastIndex)
+		{
+			hashIndex.Remove(hashes[lastIndex], lastIndex);
+			hashIndex.Add(hashes[lastIndex], index);
+			hashes[index] = hashes[lastIndex];
+		}
+		hashes.pop_back();
+	}
+}
+
+TEST_2D(HashIndex2D_PathHashFoldsCaseAndSlashes)
+{
+	const unsigned int hash = HashPath2D("Textures/SpriteSheets/HeroShip.png");
+	CHECK_2D( HashPath2D("textures/spritesheets/heroship.png") == hash );
+	CHECK_2D( HashPath2D("TEXTURES\\SpriteSheets\\HEROSHIP.PNG") == hash );
+	CHECK_2D( HashPath2D("Textures\\SpriteSheets/HeroShip.png") == hash );
+
+	CHECK_2D( HashPath2D("Textures/SpriteSheets/HeroShip.xml") != hash );
+	CHECK_2D( HashPath2D("Textures/SpriteSheets/EnemyShip.png") != hash );
+
+	// A missing path leaves the hash as it is
+	CHECK_2D( HashPath2D(NULL) == kPathHashSeed2D );
+	CHECK_2D( HashPath2D(NULL, hash) == hash );
+}
+
+TEST_2D(HashIndex2D_ChainedPathsStayApart)
+{
+	CHECK_2D( HashPath2D("bc", HashPath2D("a")) != HashPath2D("c", HashPath2D("ab")) );
+	CHECK_2D( HashPath2D("", HashPath2D("ab")) != HashPath2D("ab") );
+	CHECK_2D( HashPath2D("Sheet.xml", HashPath2D("Sheet.png")) != HashPath2D("Sheet.png", HashPath2D("Sheet.xml")) );
+
+	CHECK_2D( HashPath2D("A\\B.xml", HashPath2D("A\\B.png")) == HashPath2D("a/b.xml", HashPath2D("a/b.png")) );
+}
+
+TEST_2D(HashIndex2D_CollidingHashes)
+{
+	// Four buckets, so 1, 5 and 9 share one
+	HashIndex2D hashIndex(3);
+	hashIndex.Add(1, 0);
+	hashIndex.Add(5, 1);
+	hashIndex.Add(9, 2);
+	hashIndex.Add(2, 3);
+
+	std::vector<int> chain = GetChain(hashIndex, 5);
+	CHECK_2D( chain.size() == 3 );
+	CHECK_2D( Count(chain, 0) == 1 && Count(chain, 1) == 1 && Count(chain, 2) == 1 );
+	CHECK_2D( GetChain(hashIndex, 1) == chain );
+	CHECK_2D( GetChain(hashIndex, 2).size() == 1 && hashIndex.First(2) == 3 );
+	CHECK_2D( hashIndex.First(3) == -1 );
+
+	// From the middle of the chain, its head and its tail
+	hashIndex.Remove(5, 1);
+	chain = GetChain(hashIndex, 1);
+	CHECK_2D( chain.size() == 2 && Count(chain, 0) == 1 && Count(chain, 2) == 1 );
+
+	hashIndex.Remove(9, 2);
+	hashIndex.Remove(1, 0);
+	CHECK_2D( hashIndex.First(1) == -1 );
+
+	// Removing what isn't in the bucket of the hash changes nothing
+	hashIndex.Remove(2, 0);
+	hashIndex.Remove(3, 3);
+	CHECK_2D( hashIndex.First(2) == 3 && hashIndex.Next(3) == -1 );
+
+	// A removed index can be added again under another hash
+	hashIndex.Add(13, 1);
+	CHECK_2D( hashIndex.First(1) == 1 && hashIndex.Next(1) == -1 );
+
+	hashIndex.Clear();
+	CHECK_2D( hashIndex.First(1) == -1 && hashIndex.First(2) == -1 );
+}
+
+TEST_2D(HashIndex2D_SwapIntoFreedSlot)
+{
+	TestRandom2D random(13);
+
+	// Few buckets and few distinct hashes, so that most chains hold several entries. The
+	// entries grow to a hundred and then go up and down around that.
+	HashIndex2D hashIndex(8);
+	std::vector<unsigned int> hashes;
+
+	for (int step = 0; step < 5000; step++)
+	{
+		if (hashes.empty() || (hashes.size() < 100 && random.NextInt(5) < 3))
+		{
+			const unsigned int hash = static_cast<unsigned int>(random.NextInt(40)) * 2654435761u;
+			hashIndex.Add(hash, static_cast<int>(hashes.size()));
+			hashes.push_back(hash);
+		}
+		else
+		{
+			RemoveAt(hashIndex, hashes, random.NextInt(static_cast<int>(hashes.size())));
+		}
+
+		// Every entry is in the chain of its hash exactly once, and chains only hold live
+		// entries that share the bucket
+		for (size_t i = 0; i < hashes.size(); i++)
+		{
+			const std::vector<int> chain = GetChain(hashIndex, hashes[i]);
+			CHECK_2D( Count(chain, static_cast<int>(i)) == 1 );
+
+			for (size_t link = 0; link < chain.size(); link++)
+			{
+				CHECK_2D( chain[link] >= 0 && chain[link] < static_cast<int>(hashes.size()) );
+				CHECK_2D( chain[link] < 0 || (hashes[chain[link]] & 7u) == (hashes[i] & 7u) );
+			}
+		}
+	}
+}
@@ -0,0 +1,133 @@
+//=======
+//
+// Purpose: Benchmark of the grid broadphase against testing every pair of sprites
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "SpatialHash2d.hpp"
+
+#include <stdio.h>
+
+namespace
+{
+	// Sprites of the old loop were separate objects reached through the manager's list
+	struct BenchSprite
+	{
+		Aabb2D box;
+		float velocityX;
+		float velocityY;
+		int proxy;
+	};
+
+	const float kFrameTime = 1.f / 60.f;
+
+	// Moves every sprite on by one frame, wrapping around at the edges of the world
+	void MoveSprites(std::vector<BenchSprite*> &sprites, float worldSize)
+	{
+		for (size_t i = 0; i < sprites.size(); i++)
+		{
+			BenchSprite &sprite = *sprites[i];
+			float moveX = sprite.velocityX * kFrameTime;
+			float moveY = sprite.velocityY * kFrameTime;
+			if (sprite.box.minX + moveX < 0.f || sprite.box.maxX + moveX > worldSize)
+			{
+				sprite.velocityX = -sprite.velocityX;
+				moveX = -moveX;
+			}
+			if (sprite.box.minY + moveY < 0.f || sprite.box.maxY + moveY > worldSize)
+			{
+				sprite.velocityY = -sprite.velocityY;
+				moveY = -moveY;
+			}
+			sprite.box.minX += moveX;
+			sprite.box.maxX += moveX;
+			sprite.box.minY += moveY;
+			sprite.box.maxY += moveY;
+		}
+	}
+
+	// Every sprite against every one after it, as the manager used to do it
+	int FindPairsAllAgainstAll(const std::vector<BenchSprite*> &sprites)
+	{
+		int numPairs = 0;
+		for (size_t i = 0; i < sprites.size(); i++)
+		{
+			for (size_t j = i + 1; j < sprites.size(); j++)
+			{
+				numPairs += sprites[i]->box.Overlaps(sprites[j]->box) ? 1 : 0;
+			}
+		}
+		return numPairs;
+	}
+
+	void RunBroadphase(int numSprites, int numGridFrames, int numAllAgainstAllFrames)
+	{
+		// About one sprite per 100x100 units whatever the count, so the number of pairs grows linearly
+		const float worldSize = 100.f * sqrtf(static_cast<float>(numSprites));
+
+		TestRandom2D random(static_cast<unsigned int>(numSprites));
+		std::vector<BenchSprite> storage(numSprites);
+		std::vector<BenchSprite*> sprites(numSprites);
+		for (int i = 0; i < numSprites; i++)
+		{
+			// Spread out in memory the way separately allocated entities end up
+			BenchSprite &sprite = storage[(static_cast<long long>(i) * 7919) % numSprites];
+			const float width = random.NextFloat(16.f, 64.f);
+			const float height = random.NextFloat(16.f, 64.f);
+			sprite.box.minX = random.NextFloat(0.f, worldSize - width);
+			sprite.box.minY = random.NextFloat(0.f, worldSize - height);
+			sprite.box.maxX = sprite.box.minX + width;
+			sprite.box.maxY = sprite.box.minY + height;
+			sprite.velocityX = random.NextFloat(-200.f, 200.f);
+			sprite.velocityY = random.NextFloat(-200.f, 200.f);
+			sprites[i] = &sprite;
+		}
+
+		SpatialHash2D broadphase;
+		for (int i = 0; i < numSprites; i++)
+		{
+			sprites[i]->proxy = broadphase.CreateProxy(sprites[i]->box, sprites[i]);
+		}
+
+		std::vector<SpatialHash2D::Pair> pairs;
+		size_t numGridPairs = 0;
+		const double gridStart = GetTestSeconds2D();
+		for (int frame = 0; frame < numGridFrames; frame++)
+		{
+			MoveSprites(sprites, worldSize);
+			for (int i = 0; i < numSprites; i++)
+			{
+				broadphase.UpdateProxy(sprites[i]->proxy, sprites[i]->box);
+			}
+			broadphase.FindPairs(pairs);
+			numGridPairs += pairs.size();
+		}
+		const double gridSeconds = (GetTestSeconds2D() - gridStart) / numGridFrames;
+
+		long long numAllPairs = 0;
+		const double allStart = GetTestSeconds2D();
+		for (int frame = 0; frame < numAllAgainstAllFrames; frame++)
+		{
+			MoveSprites(sprites, worldSize);
+			numAllPairs += FindPairsAllAgainstAll(sprites);
+		}
+		const double allSeconds = (GetTestSeconds2D() - allStart) / numAllAgainstAllFrames;
+
+		const double numPairTests = 0.5 * numSprites * (numSprites - 1.0);
+		printf("  %6d sprites: grid %8.3f ms/frame (%.0f pairs), all against all %9.3f ms/frame (%.0f pair tests, %.0f pairs), %.0fx\n",
+			numSprites,
+			gridSeconds * 1000.0, static_cast<double>(numGridPairs) / numGridFrames,
+			allSeconds * 1000.0, numPairTests, static_cast<double>(numAllPairs) / numAllAgainstAllFrames,
+			allSeconds / gridSeconds);
+	}
+}
+
+BENCH_2D(SpatialHash2D_FindPairs)
+{
+	// Grid time includes moving and updating every proxy, the loop only moves the sprites
+	RunBroadphase(1000, 200, 50);
+	RunBroadphase(10000, 50, 3);
+	RunBroadphase(50000, 20, 1);
+}
@@ -0,0 +1,320 @@
+//=======
+//
+// Purpose: Tests of the grid broadphase against brute force
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "SpatialHash2d.hpp"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace
+{
+	typedef std::set< std::pair<int, int> > PairSet;
+
+	Aabb2D MakeBox(float x, float y, float width, float height)
+	{
+		Aabb2D box;
+		box.minX = x;
+		box.minY = y;
+		box.maxX = x + width;
+		box.maxY = y + height;
+		return box;
+	}
+
+	std::pair<int, int> MakePair(int proxyA, int proxyB)
+	{
+		return (proxyA < proxyB) ? std::make_pair(proxyA, proxyB) : std::make_pair(proxyB, proxyA);
+	}
+
+	// A world of boxes mirrored outside of the broadphase, destroyed ones have a proxy of -1
+	struct World
+	{
+		SpatialHash2D broadphase;
+		std::vector<Aabb2D> boxes;
+		std::vector<unsigned int> layers;
+		std::vector<unsigned int> masks;
+		std::vector<int> proxies;
+		std::vector<int> userData;
+
+		PairSet FindPairs() const
+		{
+			std::vector<SpatialHash2D::Pair> pairs;
+			broadphase.FindPairs(pairs);
+
+			PairSet found;
+			for (size_t i = 0; i < pairs.size(); i++)
+			{
+				// Every pair only once
+				CHECK_2D( found.insert(MakePair(pairs[i].proxyA, pairs[i].proxyB)).second );
+			}
+			return found;
+		}
+
+		PairSet FindPairsBruteForce() const
+		{
+			PairSet found;
+			for (size_t i = 0; i < boxes.size(); i++)
+			{
+				for (size_t j = i + 1; j < boxes.size(); j++)
+				{
+					if (proxies[i] != -1 && proxies[j] != -1 &&
+						boxes[i].Overlaps(boxes[j]) &&
+						SpatialHash2D::ShouldCollide(layers[i], masks[i], layers[j], masks[j]))
+					{
+						found.insert(MakePair(proxies[i], proxies[j]));
+					}
+				}
+			}
+			return found;
+		}
+	};
+}
+
+TEST_2D(SpatialHash2D_FindPairsMatchesBruteForce)
+{
+	TestRandom2D random(1);
+
+	const int numBoxes = 800;
+	World world;
+	world.broadphase.SetCellSize(64.0f);
+	world.userData.resize(numBoxes);
+
+	for (int i = 0; i < numBoxes; i++)
+	{
+		const float size = random.NextFloat(10.0f, 50.0f);
+		Aabb2D box = MakeBox(random.NextFloat(0.0f, 4000.0f), random.NextFloat(0.0f, 4000.0f), size, size);
+
+		// A few boxes are big enough to be kept out of the grid
+		if (i % 97 == 0)
+		{
+			box.maxX += 3000.0f;
+			box.maxY += 2000.0f;
+		}
+
+		const unsigned int layer = 1u << random.NextInt(3);
+		const unsigned int mask = (random.NextInt(4) == 0) ? 0xFFFFFFFFu : ((1u << random.NextInt(3)) | (1u << random.NextInt(3)));
+
+		world.boxes.push_back(box);
+		world.layers.push_back(layer);
+		world.masks.push_back(mask);
+		world.proxies.push_back( world.broadphase.CreateProxy(box, &world.userData[i], layer, mask) );
+	}
+
+	for (int frame = 0; frame < 6; frame++)
+	{
+		for (int i = 0; i < numBoxes; i++)
+		{
+			const float moveX = random.NextFloat(-10.0f, 10.0f);
+			const float moveY = random.NextFloat(-10.0f, 10.0f);
+			world.boxes[i].minX += moveX;
+			world.boxes[i].maxX += moveX;
+			world.boxes[i].minY += moveY;
+			world.boxes[i].maxY += moveY;
+
+			if (world.proxies[i] != -1)
+			{
+				world.broadphase.UpdateProxy(world.proxies[i], world.boxes[i]);
+			}
+		}
+
+		if (frame == 2)
+		{
+			for (int i = 0; i < numBoxes; i += 3)
+			{
+				world.broadphase.DestroyProxy(world.proxies[i]);
+				CHECK_2D( world.broadphase.GetUserData(world.proxies[i]) == NULL );
+				world.proxies[i] = -1;
+			}
+		}
+		else if (frame == 3)
+		{
+			world.broadphase.SetCellSize(100.0f);
+		}
+		else if (frame == 1 || frame == 4)
+		{
+			for (int i = 1; i < numBoxes; i += 5)
+			{
+				world.layers[i] = 1u << random.NextInt(4);
+				world.masks[i] = (1u << random.NextInt(4)) | 1u;
+				if (world.proxies[i] != -1)
+				{
+					world.broadphase.SetProxyFilter(world.proxies[i], world.layers[i], world.masks[i]);
+				}
+			}
+		}
+
+		CHECK_2D( world.FindPairs() == world.FindPairsBruteForce() );
+	}
+}
+
+TEST_2D(SpatialHash2D_ProxiesAreRecycled)
+{
+	SpatialHash2D broadphase(32.0f);
+	int userData[3];
+
+	const int first = broadphase.CreateProxy(MakeBox(0, 0, 10, 10), &userData[0]);
+	const int second = broadphase.CreateProxy(MakeBox(5, 5, 10, 10), &userData[1]);
+	CHECK_2D( broadphase.GetNumProxies() == 2 );
+	CHECK_2D( broadphase.GetUserData(second) == &userData[1] );
+
+	broadphase.DestroyProxy(first);
+	CHECK_2D( broadphase.GetNumProxies() == 1 );
+	CHECK_2D( broadphase.GetUserData(first) == NULL );
+
+	// Destroying twice or out of range does nothing
+	broadphase.DestroyProxy(first);
+	broadphase.DestroyProxy(1000);
+	CHECK_2D( broadphase.GetNumProxies() == 1 );
+
+	const int third = broadphase.CreateProxy(MakeBox(0, 0, 10, 10), &userData[2]);
+	CHECK_2D( third == first );
+
+	std::vector<SpatialHash2D::Pair> pairs;
+	broadphase.FindPairs(pairs);
+	CHECK_2D( pairs.size() == 1 );
+
+	broadphase.Clear();
+	CHECK_2D( broadphase.GetNumProxies() == 0 );
+	broadphase.FindPairs(pairs);
+	CHECK_2D( pairs.empty() );
+}
+
+TEST_2D(SpatialHash2D_LayersAndMasks)
+{
+	CHECK_2D( SpatialHash2D::ShouldCollide(1, 2, 2, 1) );
+	CHECK_2D( !SpatialHash2D::ShouldCollide(1, 1, 2, 2) );
+	CHECK_2D( !SpatialHash2D::ShouldCollide(1, 2, 2, 2) );
+	CHECK_2D( SpatialHash2D::ShouldCollide(4, 0xFFFFFFFF, 8, 0xFFFFFFFF) );
+
+	SpatialHash2D broadphase(64.0f);
+	int userData[3];
+	broadphase.CreateProxy(MakeBox(0, 0, 10, 10), &userData[0], 1, 2);
+	broadphase.CreateProxy(MakeBox(0, 0, 10, 10), &userData[1], 1, 2);
+	const int other = broadphase.CreateProxy(MakeBox(0, 0, 10, 10), &userData[2], 2, 1);
+
+	// Only the two pairs between the groups, not the one within the first group
+	std::vector<SpatialHash2D::Pair> pairs;
+	broadphase.FindPairs(pairs);
+	CHECK_2D( pairs.size() == 2 );
+
+	broadphase.SetProxyFilter(other, 4, 1);
+	broadphase.FindPairs(pairs);
+	CHECK_2D( pairs.empty() );
+}
+
+TEST_2D(SpatialHash2D_QueriesMatchBruteForce)
+{
+	TestRandom2D random(7);
+
+	for (int worldIndex = 0; worldIndex < 60; worldIndex++)
+	{
+		World world;
+		world.broadphase.SetCellSize(random.NextFloat(8.0f, 128.0f));
+
+		const int numBoxes = 1 + random.NextInt(300);
+		world.userData.resize(numBoxes);
+
+		for (int i = 0; i < numBoxes; i++)
+		{
+			const float maxWidth = (worldIndex % 5 == 0) ? 3000.0f : 120.0f;
+			const Aabb2D box = MakeBox(random.NextFloat(-1000.0f, 1000.0f), random.NextFloat(-1000.0f, 1000.0f),
+				random.NextFloat(0.0f, maxWidth), random.NextFloat(0.0f, 120.0f));
+			const unsigned int layer = 1u << random.NextInt(4);
+
+			world.boxes.push_back(box);
+			world.layers.push_back(layer);
+			world.masks.push_back(0xF);
+			world.proxies.push_back( world.broadphase.CreateProxy(box, &world.userData[i], layer, 0xF) );
+		}
+
+		for (int i = 0; i < numBoxes / 5; i++)
+		{
+			const int index = random.NextInt(numBoxes);
+			if (world.proxies[index] != -1)
+			{
+				world.broadphase.DestroyProxy(world.proxies[index]);
+				world.proxies[index] = -1;
+			}
+		}
+
+		for (int query = 0; query < 100; query++)
+		{
+			const unsigned int layerMask = static_cast<unsigned int>(random.NextInt(16));
+			std::vector<int> found;
+			std::vector<int> expected;
+
+			if (query % 2 == 0)
+			{
+				const float maxWidth = (query % 7 == 0) ? 2500.0f : 200.0f;
+				const Aabb2D box = MakeBox(random.NextFloat(-1200.0f, 1200.0f), random.NextFloat(-1200.0f, 1200.0f),
+					random.NextFloat(0.0f, maxWidth), random.NextFloat(0.0f, 200.0f));
+
+				world.broadphase.QueryBox(box, layerMask, found);
+				for (int i = 0; i < numBoxes; i++)
+				{
+					if (world.proxies[i] != -1 && (world.layers[i] & layerMask) != 0 && world.boxes[i].Overlaps(box))
+					{
+						expected.push_back(world.proxies[i]);
+					}
+				}
+			}
+			else
+			{
+				const float reach = (query % 5 == 0) ? 3000.0f : 300.0f;
+				const float startX = random.NextFloat(-1200.0f, 1200.0f);
+				const float startY = random.NextFloat(-1200.0f, 1200.0f);
+				const float endX = (query % 11 == 1) ? startX : startX + random.NextFloat(-reach, reach);
+				const float endY = (query % 13 == 1) ? startY : startY + random.NextFloat(-300.0f, 300.0f);
+
+				world.broadphase.QuerySegment(startX, startY, endX, endY, layerMask, found);
+				for (int i = 0; i < numBoxes; i++)
+				{
+					if (world.proxies[i] != -1 && (world.layers[i] & layerMask) != 0 &&
+						world.boxes[i].OverlapsSegment(startX, startY, endX - startX, endY - startY))
+					{
+						expected.push_back(world.proxies[i]);
+					}
+				}
+			}
+
+			std::sort(found.begin(), found.end());
+			std::sort(expected.begin(), expected.end());
+			CHECK_2D( std::adjacent_find(found.begin(), found.end()) == found.end() );
+			CHECK_2D( found == expected );
+		}
+	}
+}
+
+TEST_2D(SpatialHash2D_QueriesOnEmptyGrid)
+{
+	SpatialHash2D broadphase(32.0f);
+	std::vector<int> found;
+
+	broadphase.QueryBox(MakeBox(0, 0, 10, 10), 0xFFFFFFFF, found);
+	broadphase.QuerySegment(0, 0, 100, 50, 0xFFFFFFFF, found);
+	CHECK_2D( found.empty() );
+
+	// Filters stay around after their last proxy is gone
+	int userData;
+	broadphase.DestroyProxy( broadphase.CreateProxy(MakeBox(0, 0, 10, 10), &userData) );
+	broadphase.QueryBox(MakeBox(0, 0, 10, 10), 0xFFFFFFFF, found);
+	broadphase.QuerySegment(0, 0, 100, 50, 0xFFFFFFFF, found);
+	CHECK_2D( found.empty() );
+}
+
+TEST_2D(SpatialHash2D_SegmentTouchesBox)
+{
+	const Aabb2D box = MakeBox(0, 0, 10, 10);
+
+	CHECK_2D( box.OverlapsSegment(-5, 5, 20, 0) );
+	CHECK_2D( box.OverlapsSegment(5, 5, 0, 0) );
+	CHECK_2D( box.OverlapsSegment(-5, -5, 5, 5) );
+	CHECK_2D( !box.OverlapsSegment(-5, 5, 4, 0) );
+	CHECK_2D( !box.OverlapsSegment(-5, 11, 20, 0) );
+	CHECK_2D( !box.OverlapsSegment(20, 0, 0, 10) );
+}
@@ -0,0 +1,135 @@
+//=======
+//
+// Purpose: Benchmark of ticking sprite animations in one batch against once per sprite
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "SpriteAnimations2d.hpp"
+
+#include <stdio.h>
+
+namespace
+{
+	const float kUniformEndTimes[8] = { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f };
+	const float kUnevenEndTimes[3] = { 0.05f, 0.25f, 0.3f };
+
+	const AnimationTimeline2D kUniformTimeline = { kUniformEndTimes, 8, 0.1f, 0.8f };
+	const AnimationTimeline2D kUnevenTimeline = { kUnevenEndTimes, 3, 0.f, 0.3f };
+
+	// Every sprite used to be an entity of its own, ticking its animation from a virtual think
+	class BenchEntity
+	{
+	public:
+		virtual ~BenchEntity()
+		{
+		}
+
+		virtual void Think(float deltaTime) = 0;
+	};
+
+	class BenchSprite : public BenchEntity
+	{
+	public:
+		virtual void Think(float deltaTime)
+		{
+			scrollOffsetX += scrollSpeedX * deltaTime;
+			if (scrollSpeedX > 0.f && scrollOffsetX > 1.f)
+			{
+				scrollOffsetX -= 1.f;
+			}
+
+			numLoops += AdvanceAnimation2D(timeline, deltaTime, frame, frameTime);
+		}
+
+		AnimationTimeline2D timeline;
+		int frame;
+		float frameTime;
+		float scrollSpeedX;
+		float scrollOffsetX;
+		int numLoops;
+	};
+}
+
+BENCH_2D(SpriteAnimations2D_Advance)
+{
+	const int kNumSprites = 10000;
+	const int kNumTicks = 2000;
+	const float kTickTime = 1.f / 60.f;
+
+	std::vector<BenchSprite*> allocated(kNumSprites);
+	SpriteAnimations2D animations;
+	SpriteAnimations2D scalarAnimations;
+	for (int i = 0; i < kNumSprites; i++)
+	{
+		BenchSprite *sprite = new BenchSprite();
+		sprite->timeline = (i % 3 != 0) ? kUniformTimeline : kUnevenTimeline;
+		sprite->frame = 0;
+		sprite->frameTime = 0.f;
+		sprite->scrollSpeedX = (i % 4 == 0) ? 0.25f : 0.f;
+		sprite->scrollOffsetX = 0.f;
+		sprite->numLoops = 0;
+		allocated[i] = sprite;
+
+		const int handle = animations.CreateAnimation(sprite);
+		animations.SetEnabled(handle, true);
+		animations.SetTimeline(handle, &sprite->timeline);
+		animations.SetScrollSpeed(handle, sprite->scrollSpeedX, 0.f);
+
+		const int scalarHandle = scalarAnimations.CreateAnimation(sprite);
+		scalarAnimations.SetEnabled(scalarHandle, true);
+		scalarAnimations.SetTimeline(scalarHandle, &sprite->timeline);
+		scalarAnimations.SetScrollSpeed(scalarHandle, sprite->scrollSpeedX, 0.f);
+	}
+
+	// Entities are visited in list order, which isn't their order in memory
+	std::vector<BenchEntity*> entities(kNumSprites);
+	for (int i = 0; i < kNumSprites; i++)
+	{
+		entities[i] = allocated[(i * 7919) % kNumSprites];
+	}
+
+	double start = GetTestSeconds2D();
+	for (int tick = 0; tick < kNumTicks; tick++)
+	{
+		for (int i = 0; i < kNumSprites; i++)
+		{
+			entities[i]->Think(kTickTime);
+		}
+	}
+	const double perSpriteMicroseconds = (GetTestSeconds2D() - start) * 1e6 / kNumTicks;
+
+	std::vector<AnimationEvent2D> events;
+	size_t numEvents = 0;
+	start = GetTestSeconds2D();
+	for (int tick = 0; tick < kNumTicks; tick++)
+	{
+		events.clear();
+		animations.Advance(kTickTime, events);
+		numEvents += events.size();
+	}
+	const double batchedMicroseconds = (GetTestSeconds2D() - start) * 1e6 / kNumTicks;
+
+	size_t numScalarEvents = 0;
+	start = GetTestSeconds2D();
+	for (int tick = 0; tick < kNumTicks; tick++)
+	{
+		events.clear();
+		scalarAnimations.AdvanceScalar(kTickTime, events);
+		numScalarEvents += events.size();
+	}
+	const double scalarMicroseconds = (GetTestSeconds2D() - start) * 1e6 / kNumTicks;
+
+	long long numLoops = 0;
+	for (int i = 0; i < kNumSprites; i++)
+	{
+		numLoops += allocated[i]->numLoops;
+		delete allocated[i];
+	}
+
+	printf("  %d sprites: per sprite think %.1f us/tick (%lld loops), %s %.1f us/tick (%d loop events), scalar %.1f us/tick (%d loop events)\n",
+		kNumSprites, perSpriteMicroseconds, numLoops,
+		SPRITE_ANIMATIONS_2D_USE_SSE ? "SSE" : "batched", batchedMicroseconds, static_cast<int>(numEvents),
+		scalarMicroseconds, static_cast<int>(numScalarEvents));
+}
@@ -0,0 +1,255 @@
+//=======
+//
+// Purpose: Tests of the frame timing and the batched sprite animations
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "SpriteAnimations2d.hpp"
+
+namespace
+{
+	const float kUniformEndTimes[8] = { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f };
+	const float kUnevenEndTimes[3] = { 0.05f, 0.25f, 0.3f };
+
+	const AnimationTimeline2D kUniformTimeline = { kUniformEndTimes, 8, 0.1f, 0.8f };
+	const AnimationTimeline2D kUnevenTimeline = { kUnevenEndTimes, 3, 0.f, 0.3f };
+	const AnimationTimeline2D kSingleFrameTimeline = { kUniformEndTimes, 1, 0.1f, 0.1f };
+}
+
+TEST_2D(Animation2D_BuildFrameEndTimes)
+{
+	const float durations[4] = { 0.5f, 0.f, 0.25f, -1.f };
+	float endTimes[4];
+	CHECK_2D( BuildFrameEndTimes2D(durations, 4, 10.f, endTimes) == 0.f );
+	CHECK_CLOSE_2D( endTimes[0], 0.5, 1e-6 );
+	CHECK_CLOSE_2D( endTimes[1], 0.6, 1e-6 );
+	CHECK_CLOSE_2D( endTimes[2], 0.85, 1e-6 );
+	CHECK_CLOSE_2D( endTimes[3], 0.95, 1e-6 );
+
+	const float noDurations[3] = { 0.f, 0.f, 0.f };
+	CHECK_CLOSE_2D( BuildFrameEndTimes2D(noDurations, 3, 20.f, endTimes), 0.05, 1e-6 );
+	CHECK_CLOSE_2D( endTimes[2], 0.15, 1e-6 );
+}
+
+TEST_2D(Animation2D_AdvanceAcrossLoops)
+{
+	int frame = 0;
+	float frameTime = 0.f;
+
+	CHECK_2D( AdvanceAnimation2D(kUnevenTimeline, 0.04f, frame, frameTime) == 0 );
+	CHECK_2D( frame == 0 );
+
+	CHECK_2D( AdvanceAnimation2D(kUnevenTimeline, 0.02f, frame, frameTime) == 0 );
+	CHECK_2D( frame == 1 );
+	CHECK_CLOSE_2D( frameTime, 0.01, 1e-5 );
+
+	// From 0.06 into the loop to 0.21 into the third loop after it
+	CHECK_2D( AdvanceAnimation2D(kUnevenTimeline, 0.75f, frame, frameTime) == 2 );
+	CHECK_2D( frame == 1 );
+	CHECK_CLOSE_2D( frameTime, 0.16, 1e-4 );
+
+	frame = 0;
+	frameTime = 0.f;
+	CHECK_2D( AdvanceAnimation2D(kUniformTimeline, 1.75f, frame, frameTime) == 2 );
+	CHECK_2D( frame == 1 );
+	CHECK_CLOSE_2D( frameTime, 0.05, 1e-4 );
+}
+
+TEST_2D(SpriteAnimations2D_HandlesSurviveDestruction)
+{
+	SpriteAnimations2D animations;
+	int handles[10];
+	int tags[10];
+	for (int i = 0; i < 10; i++)
+	{
+		handles[i] = animations.CreateAnimation(&tags[i]);
+		animations.SetEnabled(handles[i], true);
+	}
+
+	animations.DestroyAnimation(handles[3]);
+	animations.DestroyAnimation(handles[0]);
+	CHECK_2D( animations.GetUserData(handles[3]) == NULL );
+	CHECK_2D( animations.GetUserData(handles[9]) == &tags[9] );
+	CHECK_2D( animations.GetNumAnimations() == 8 );
+
+	// Destroyed handles are handed out again, as new animations
+	const int handle = animations.CreateAnimation(&tags[0]);
+	CHECK_2D( handle == handles[0] );
+	CHECK_2D( animations.GetFrame(handle) == -1 );
+	CHECK_2D( animations.IsPlaying(handle) && !animations.IsEnabled(handle) );
+
+	animations.SetTimeline(handles[5], &kUniformTimeline);
+	CHECK_2D( animations.GetFrame(handles[5]) == 0 );
+	animations.SetFrame(handles[5], 99);
+	CHECK_2D( animations.GetFrame(handles[5]) == 7 );
+}
+
+TEST_2D(SpriteAnimations2D_PlayOnceStopsOnLastFrame)
+{
+	SpriteAnimations2D animations;
+	int tag;
+	const int handle = animations.CreateAnimation(&tag);
+	animations.SetEnabled(handle, true);
+	animations.SetTimeline(handle, &kUniformTimeline);
+	animations.SetPlayOnce(handle, true);
+
+	std::vector<AnimationEvent2D> events;
+	animations.Advance(5.f, events);
+	CHECK_2D( events.size() == 1 );
+	CHECK_2D( !events.empty() && events[0].numLoops == 1 && events[0].userData == &tag );
+	CHECK_2D( animations.GetFrame(handle) == 7 );
+	CHECK_2D( !animations.IsPlaying(handle) );
+
+	events.clear();
+	animations.Advance(5.f, events);
+	CHECK_2D( events.empty() );
+}
+
+TEST_2D(SpriteAnimations2D_StoppedAnimationsStandStill)
+{
+	SpriteAnimations2D animations;
+	int tag;
+
+	const int disabled = animations.CreateAnimation(&tag);
+	animations.SetTimeline(disabled, &kUniformTimeline);
+	animations.SetScrollSpeed(disabled, 1.f, 1.f);
+
+	const int paused = animations.CreateAnimation(&tag);
+	animations.SetEnabled(paused, true);
+	animations.SetTimeline(paused, &kUniformTimeline);
+	animations.SetPlaying(paused, false);
+
+	// Single frames don't animate but still scroll
+	const int single = animations.CreateAnimation(&tag);
+	animations.SetEnabled(single, true);
+	animations.SetTimeline(single, &kSingleFrameTimeline);
+	animations.SetScrollSpeed(single, 0.3f, -0.3f);
+
+	std::vector<AnimationEvent2D> events;
+	for (int tick = 0; tick < 10; tick++)
+	{
+		animations.Advance(0.5f, events);
+	}
+
+	CHECK_2D( events.empty() );
+	CHECK_2D( animations.GetFrame(disabled) == 0 && animations.GetScrollOffsetX(disabled) == 0.f );
+	CHECK_2D( animations.GetFrame(paused) == 0 );
+	CHECK_2D( animations.GetFrame(single) == 0 );
+	CHECK_CLOSE_2D( animations.GetScrollOffsetX(single), 0.5, 1e-4 );
+	CHECK_CLOSE_2D( animations.GetScrollOffsetY(single), 0.5, 1e-4 );
+}
+
+namespace
+{
+	// How each sprite used to tick its own animation from its think function
+	struct PerSpriteAnimation
+	{
+		void Tick(float deltaTime)
+		{
+			if (paused)
+			{
+				return;
+			}
+
+			scrollOffsetX += scrollSpeedX * deltaTime;
+			if (scrollSpeedX > 0.f && scrollOffsetX > 1.f)
+			{
+				scrollOffsetX -= 1.f;
+			}
+			else if (scrollSpeedX < 0.f && scrollOffsetX < 0.f)
+			{
+				scrollOffsetX += 1.f;
+			}
+
+			if (timeline.numFrames > 1)
+			{
+				numLoops += AdvanceAnimation2D(timeline, deltaTime, frame, frameTime);
+			}
+		}
+
+		AnimationTimeline2D timeline;
+		int frame;
+		float frameTime;
+		float scrollSpeedX;
+		float scrollOffsetX;
+		bool paused;
+		int numLoops;
+	};
+
+	// Ticks the batch either with Advance or with AdvanceScalar and compares every sprite
+	void CheckBatchedMatchesPerSprite(bool scalar)
+	{
+		const int kNumSprites = 1003;
+
+		std::vector<PerSpriteAnimation> sprites(kNumSprites);
+		SpriteAnimations2D animations;
+		std::vector<int> handles(kNumSprites);
+		for (int i = 0; i < kNumSprites; i++)
+		{
+			PerSpriteAnimation &sprite = sprites[i];
+			sprite.timeline = (i % 3 == 0) ? kUnevenTimeline : ((i % 7 == 0) ? kSingleFrameTimeline : kUniformTimeline);
+			sprite.frame = 0;
+			sprite.frameTime = 0.f;
+			sprite.scrollSpeedX = (i % 5 == 0) ? 0.37f : ((i % 5 == 1) ? -0.21f : 0.f);
+			sprite.scrollOffsetX = 0.f;
+			sprite.paused = (i % 11 == 0);
+			sprite.numLoops = 0;
+
+			handles[i] = animations.CreateAnimation(&sprites[i]);
+			animations.SetEnabled(handles[i], true);
+			animations.SetTimeline(handles[i], &sprite.timeline);
+			animations.SetPlaying(handles[i], !sprite.paused);
+			animations.SetScrollSpeed(handles[i], sprite.scrollSpeedX, 0.f);
+		}
+
+		std::vector<AnimationEvent2D> events;
+		std::vector<int> numLoops(kNumSprites, 0);
+		for (int tick = 0; tick < 2000; tick++)
+		{
+			// Now and then a long frame that skips across several animation frames
+			const float deltaTime = (tick % 97 == 0) ? 0.7f : 1.f / 60.f;
+			for (int i = 0; i < kNumSprites; i++)
+			{
+				sprites[i].Tick(deltaTime);
+			}
+
+			events.clear();
+			if (scalar)
+			{
+				animations.AdvanceScalar(deltaTime, events);
+			}
+			else
+			{
+				animations.Advance(deltaTime, events);
+			}
+
+			for (size_t event = 0; event < events.size(); event++)
+			{
+				numLoops[static_cast<PerSpriteAnimation*>(events[event].userData) - &sprites[0]] += events[event].numLoops;
+			}
+		}
+
+		for (int i = 0; i < kNumSprites; i++)
+		{
+			CHECK_2D( animations.GetFrame(handles[i]) == sprites[i].frame );
+			CHECK_2D( numLoops[i] == sprites[i].numLoops );
+			CHECK_CLOSE_2D( animations.GetScrollOffsetX(handles[i]), sprites[i].scrollOffsetX, 1e-3 );
+			if (sprites[i].timeline.numFrames > 1)
+			{
+				CHECK_CLOSE_2D( animations.GetFrameTime(handles[i]), sprites[i].frameTime, 1e-3 );
+			}
+		}
+	}
+}
+
+TEST_2D(SpriteAnimations2D_BatchedMatchesPerSprite)
+{
+	CheckBatchedMatchesPerSprite(false);
+}
+
+TEST_2D(SpriteAnimations2D_ScalarMatchesPerSprite)
+{
+	CheckBatchedMatchesPerSprite(true);
+}
@@ -0,0 +1,264 @@
+//=======
+//
+// Purpose: Benchmark of the per frame quad update against the old per sprite matrices
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "SpriteQuads2d.hpp"
+
+#include <stdio.h>
+
+namespace
+{
+	// Just enough of hkvMat3 and hkvVec3 for the old corner math
+	struct BenchVec3
+	{
+		float x;
+		float y;
+		float z;
+	};
+
+	struct BenchMat3
+	{
+		// Angle in degrees, like hkvMat3::setRotationMatrixZ
+		void SetRotationMatrixZ(float degrees)
+		{
+			const float radians = degrees * (3.14159265f / 180.f);
+			const float c = cosf(radians);
+			const float s = sinf(radians);
+			m[0][0] = c;
+			m[0][1] = -s;
+			m[0][2] = 0.f;
+			m[1][0] = s;
+			m[1][1] = c;
+			m[1][2] = 0.f;
+			m[2][0] = 0.f;
+			m[2][1] = 0.f;
+			m[2][2] = 1.f;
+		}
+
+		BenchVec3 operator*(const BenchVec3 &v) const
+		{
+			BenchVec3 result;
+			result.x = m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z;
+			result.y = m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z;
+			result.z = m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z;
+			return result;
+		}
+
+		float m[3][3];
+	};
+
+	// Sprite entities are allocated one by one and carry what both paths need
+	class BenchSprite
+	{
+	public:
+		virtual ~BenchSprite()
+		{
+		}
+
+		// What Sprite::Update used to do for every sprite, every frame: build a rotation
+		// matrix from the orientation and push each corner through it
+		virtual void Update()
+		{
+			BenchMat3 rotation;
+			rotation.SetRotationMatrixZ(orientation);
+
+			const float halfWidth = originalWidth * 0.5f;
+			const float halfHeight = originalHeight * 0.5f;
+			const float left = pivotX - halfWidth;
+			const float top = pivotY - halfHeight;
+			const float right = left + width;
+			const float bottom = top + height;
+
+			const float cornersX[QUAD_NUM_CORNERS] = { left, right, left, right };
+			const float cornersY[QUAD_NUM_CORNERS] = { top, top, bottom, bottom };
+			for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+			{
+				BenchVec3 point = { cornersX[corner] * scaleX, cornersY[corner] * scaleY, 0.f };
+				point = rotation * point;
+				verticesX[corner] = point.x + positionX + halfWidth;
+				verticesY[corner] = point.y + positionY + halfHeight;
+			}
+		}
+
+		// Same as Sprite::BuildQuad, which only takes the sine and cosine once the
+		// orientation changes
+		void BuildQuad(SpriteQuad2D &quad)
+		{
+			if (orientation != rotationDegrees)
+			{
+				const float radians = orientation * (3.14159265f / 180.f);
+				rotationDegrees = orientation;
+				cosRotation = cosf(radians);
+				sinRotation = sinf(radians);
+			}
+
+			quad.positionX = positionX;
+			quad.positionY = positionY;
+			quad.centerX = originalWidth * 0.5f;
+			quad.centerY = originalHeight * 0.5f;
+			quad.offsetX = pivotX - quad.centerX;
+			quad.offsetY = pivotY - quad.centerY;
+			quad.width = width;
+			quad.height = height;
+			quad.scaleX = scaleX;
+			quad.scaleY = scaleY;
+			quad.cosRotation = cosRotation;
+			quad.sinRotation = sinRotation;
+			quad.u0 = 0.f;
+			quad.v0 = 0.f;
+			quad.u1 = 1.f;
+			quad.v1 = 1.f;
+		}
+
+		// Same as Sprite::SetCorners
+		void SetCorners(const float *cornersX, const float *cornersY)
+		{
+			for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+			{
+				verticesX[corner] = cornersX[corner];
+				verticesY[corner] = cornersY[corner];
+			}
+		}
+
+		float positionX;
+		float positionY;
+		float orientation;
+		float scaleX;
+		float scaleY;
+		float pivotX;
+		float pivotY;
+		float width;
+		float height;
+		float originalWidth;
+		float originalHeight;
+
+		float rotationDegrees;
+		float cosRotation;
+		float sinRotation;
+
+		float verticesX[QUAD_NUM_CORNERS];
+		float verticesY[QUAD_NUM_CORNERS];
+	};
+
+	void RunQuads(int numSprites, int numFrames)
+	{
+		TestRandom2D random(static_cast<unsigned int>(numSprites));
+
+		std::vector<BenchSprite*> allocated(numSprites);
+		for (int i = 0; i < numSprites; i++)
+		{
+			BenchSprite *sprite = new BenchSprite();
+			sprite->positionX = random.NextFloat(0.f, 2000.f);
+			sprite->positionY = random.NextFloat(0.f, 2000.f);
+			sprite->orientation = random.NextFloat(0.f, 360.f);
+			sprite->scaleX = random.NextFloat(0.5f, 2.f);
+			sprite->scaleY = random.NextFloat(0.5f, 2.f);
+			sprite->originalWidth = 256.f;
+			sprite->originalHeight = 256.f;
+			sprite->width = random.NextFloat(200.f, 256.f);
+			sprite->height = random.NextFloat(200.f, 256.f);
+			sprite->pivotX = random.NextFloat(0.f, 256.f - sprite->width);
+			sprite->pivotY = random.NextFloat(0.f, 256.f - sprite->height);
+			sprite->rotationDegrees = 0.f;
+			sprite->cosRotation = 1.f;
+			sprite->sinRotation = 0.f;
+			allocated[i] = sprite;
+		}
+
+		// Entities are visited in list order, which isn't their order in memory
+		std::vector<BenchSprite*> sprites(numSprites);
+		for (int i = 0; i < numSprites; i++)
+		{
+			sprites[i] = allocated[(static_cast<long long>(i) * 7919) % numSprites];
+		}
+
+		// One in a hundred sprites turns every frame, the rest keep their orientation
+		const int numTurning = (numSprites + 99) / 100;
+
+		const double scale = 1e9 / (static_cast<double>(numSprites) * numFrames);
+
+		double start = GetTestSeconds2D();
+		for (int frame = 0; frame < numFrames; frame++)
+		{
+			for (int i = 0; i < numTurning; i++)
+			{
+				sprites[i * 100 % numSprites]->orientation += 1.f;
+			}
+			for (int i = 0; i < numSprites; i++)
+			{
+				sprites[i]->Update();
+			}
+		}
+		const double oldNanoseconds = (GetTestSeconds2D() - start) * scale;
+
+		// Everything Toolset2dManager::UpdateSpriteRange does per frame: gather the quads
+		// from the sprites, compute the corners and hand them back
+		SpriteQuads2D quads;
+		quads.Resize(numSprites);
+		double cornersSeconds = 0.0;
+		start = GetTestSeconds2D();
+		for (int frame = 0; frame < numFrames; frame++)
+		{
+			for (int i = 0; i < numTurning; i++)
+			{
+				sprites[i * 100 % numSprites]->orientation += 1.f;
+			}
+			for (int i = 0; i < numSprites; i++)
+			{
+				SpriteQuad2D quad;
+				sprites[i]->BuildQuad(quad);
+				quads.SetQuad(i, quad);
+			}
+
+			const double cornersStart = GetTestSeconds2D();
+			quads.ComputeCorners(0, numSprites);
+			cornersSeconds += GetTestSeconds2D() - cornersStart;
+
+			for (int i = 0; i < numSprites; i++)
+			{
+				float cornersX[QUAD_NUM_CORNERS];
+				float cornersY[QUAD_NUM_CORNERS];
+				quads.GetCorners(i, cornersX, cornersY);
+				sprites[i]->SetCorners(cornersX, cornersY);
+			}
+		}
+		const double batchedNanoseconds = (GetTestSeconds2D() - start) * scale;
+		const double cornersNanoseconds = cornersSeconds * scale;
+
+		// The corners alone without SSE, on the quads of the last frame
+		start = GetTestSeconds2D();
+		for (int frame = 0; frame < numFrames; frame++)
+		{
+			quads.ComputeCornersScalar(0, numSprites);
+		}
+		const double scalarNanoseconds = (GetTestSeconds2D() - start) * scale;
+
+		// Something of every result has to be used or the loops could go away
+		float checksum = 0.f;
+		float cornersX[QUAD_NUM_CORNERS];
+		float cornersY[QUAD_NUM_CORNERS];
+		quads.GetCorners(numSprites - 1, cornersX, cornersY);
+		checksum += cornersX[QUAD_BOTTOM_RIGHT] + sprites[0]->verticesX[QUAD_BOTTOM_RIGHT];
+
+		printf("  %6d sprites: per sprite matrices %.2f ns/sprite, gathered quads %.2f ns/sprite "
+			"(corners alone %s %.2f, scalar %.2f) (%g)\n",
+			numSprites, oldNanoseconds, batchedNanoseconds, SPRITE_QUADS_2D_USE_SSE ? "SSE" : "batched",
+			cornersNanoseconds, scalarNanoseconds, checksum);
+
+		for (int i = 0; i < numSprites; i++)
+		{
+			delete allocated[i];
+		}
+	}
+}
+
+BENCH_2D(SpriteQuads2D_ComputeCorners)
+{
+	RunQuads(1000, 2000);
+	RunQuads(10000, 200);
+	RunQuads(100000, 20);
+}
@@ -0,0 +1,137 @@
+//=======
+//
+// Purpose: Tests of the batched quad corners against the single quad math
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "SpriteQuads2d.hpp"
+
+namespace
+{
+	SpriteQuad2D MakeRandomQuad(TestRandom2D &random)
+	{
+		SpriteQuad2D quad;
+		quad.positionX = random.NextFloat(-1000.f, 1000.f);
+		quad.positionY = random.NextFloat(-1000.f, 1000.f);
+		quad.centerX = random.NextFloat(0.f, 128.f);
+		quad.centerY = random.NextFloat(0.f, 128.f);
+		quad.offsetX = random.NextFloat(-128.f, 0.f);
+		quad.offsetY = random.NextFloat(-128.f, 0.f);
+		quad.width = random.NextFloat(1.f, 256.f);
+		quad.height = random.NextFloat(1.f, 256.f);
+		quad.scaleX = random.NextFloat(-3.f, 3.f);
+		quad.scaleY = random.NextFloat(-3.f, 3.f);
+
+		const float rotation = random.NextFloat(0.f, 6.283f);
+		quad.cosRotation = cosf(rotation);
+		quad.sinRotation = sinf(rotation);
+
+		quad.u0 = random.NextFloat(0.f, 0.5f);
+		quad.v0 = random.NextFloat(0.f, 0.5f);
+		quad.u1 = random.NextFloat(0.5f, 1.f);
+		quad.v1 = random.NextFloat(0.5f, 1.f);
+		return quad;
+	}
+
+	// The SSE path may round differently, relative to the size of the coordinates
+	bool IsClose(float value, float expected)
+	{
+		return fabs(value - expected) <= 1e-5 * (1.0 + fabs(expected));
+	}
+
+	bool CornersMatch(const SpriteQuads2D &quads, int index, const SpriteQuad2D &quad)
+	{
+		float cornersX[QUAD_NUM_CORNERS];
+		float cornersY[QUAD_NUM_CORNERS];
+		float expectedX[QUAD_NUM_CORNERS];
+		float expectedY[QUAD_NUM_CORNERS];
+		quads.GetCorners(index, cornersX, cornersY);
+		SpriteQuads2D::ComputeCorners(quad, expectedX, expectedY);
+
+		bool match = true;
+		for (int corner = 0; corner < QUAD_NUM_CORNERS; corner++)
+		{
+			match = match && IsClose(cornersX[corner], expectedX[corner]) && IsClose(cornersY[corner], expectedY[corner]);
+		}
+		return match;
+	}
+}
+
+TEST_2D(SpriteQuads2D_BatchedMatchesSingleQuad)
+{
+	TestRandom2D random(6);
+
+	// Counts around the groups of four and the initial capacity
+	const int counts[] = { 0, 1, 3, 4, 5, 63, 64, 65, 1000 };
+	for (size_t countIndex = 0; countIndex < sizeof(counts) / sizeof(counts[0]); countIndex++)
+	{
+		const int count = counts[countIndex];
+
+		SpriteQuads2D quads;
+		SpriteQuads2D scalarQuads;
+		quads.Resize(count / 2);
+		quads.Resize(count);
+		scalarQuads.Resize(count);
+		CHECK_2D( quads.GetCount() == count );
+
+		std::vector<SpriteQuad2D> source(count);
+		for (int index = 0; index < count; index++)
+		{
+			source[index] = MakeRandomQuad(random);
+			quads.SetQuad(index, source[index]);
+			scalarQuads.SetQuad(index, source[index]);
+		}
+
+		quads.ComputeCorners();
+		scalarQuads.ComputeCornersScalar(0, count);
+
+		for (int index = 0; index < count; index++)
+		{
+			CHECK_2D( CornersMatch(quads, index, source[index]) );
+			CHECK_2D( CornersMatch(scalarQuads, index, source[index]) );
+
+			float cornersX[QUAD_NUM_CORNERS];
+			float cornersY[QUAD_NUM_CORNERS];
+			quads.GetCorners(index, cornersX, cornersY);
+
+			QuadVertex2D vertices[6];
+			quads.WriteVertices(index, vertices);
+			CHECK_2D( vertices[0].x == cornersX[QUAD_TOP_LEFT] && vertices[0].u == source[index].u0 );
+			CHECK_2D( vertices[1].y == cornersY[QUAD_BOTTOM_LEFT] && vertices[1].v == source[index].v1 );
+			CHECK_2D( vertices[2].x == cornersX[QUAD_TOP_RIGHT] && vertices[2].u == source[index].u1 );
+			CHECK_2D( vertices[5].x == cornersX[QUAD_BOTTOM_RIGHT] && vertices[5].y == cornersY[QUAD_BOTTOM_RIGHT] );
+		}
+	}
+}
+
+TEST_2D(SpriteQuads2D_RangesOnlyTouchTheirQuads)
+{
+	TestRandom2D random(8);
+	const int kCount = 37;
+
+	SpriteQuads2D quads;
+	quads.Resize(kCount);
+	std::vector<SpriteQuad2D> source(kCount);
+	for (int index = 0; index < kCount; index++)
+	{
+		source[index] = MakeRandomQuad(random);
+		quads.SetQuad(index, source[index]);
+	}
+
+	// Ranges starting and ending off the groups of four
+	quads.ComputeCorners(0, kCount);
+	const SpriteQuad2D moved = MakeRandomQuad(random);
+	for (int index = 0; index < kCount; index++)
+	{
+		quads.SetQuad(index, moved);
+	}
+	quads.ComputeCorners(5, 30);
+
+	for (int index = 0; index < kCount; index++)
+	{
+		const bool inRange = (index >= 5 && index < 30);
+		CHECK_2D( CornersMatch(quads, index, inRange ? moved : source[index]) );
+	}
+}
@@ -0,0 +1,272 @@
+//=======
+//
+// Purpose: Benchmark of loading a sprite sheet from its binary file and from its XML
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "AlphaMask2d.hpp"
+#include "CellName2d.hpp"
+#include "Collision2d.hpp"
+#include "SpriteSheetBinary2d.hpp"
+
+#include <stdio.h>
+
+#include <map>
+#include <string>
+
+#if defined(TOOLSET2D_HAVE_TINYXML)
+#include <tinyxml.h>
+#endif
+
+namespace
+{
+	// Stand-ins for SpriteCell and SpriteState, filled in the same way as SpriteData does
+	struct BenchCell
+	{
+		std::string name;
+		float offsetX;
+		float offsetY;
+		float pivotX;
+		float pivotY;
+		float width;
+		float height;
+		float originalWidth;
+		float originalHeight;
+		int index;
+		float duration;
+		std::vector<Vertex2D> hullVertices;
+		AlphaMask2D alphaMask;
+	};
+
+	struct BenchState
+	{
+		std::string name;
+		float framerate;
+		std::vector<int> cells;
+	};
+
+	struct BenchSheet
+	{
+		float sourceWidth;
+		float sourceHeight;
+		std::vector<BenchCell> cells;
+		std::vector<BenchState> states;
+		std::map<std::string, int> stateNameToIndex;
+	};
+
+	const int kNumLoads = 2000;
+
+	// Same steps as SpriteData::LoadBinary once the file is read
+	bool LoadBinary(const std::vector<unsigned int> &words, size_t size, BenchSheet &result)
+	{
+		SpriteSheetBinary2D sheet;
+		if (!sheet.Load(&words[0], size))
+		{
+			return false;
+		}
+
+		result.sourceWidth = sheet.GetSourceWidth();
+		result.sourceHeight = sheet.GetSourceHeight();
+
+		for (int cellIndex = 0; cellIndex < sheet.GetNumCells(); cellIndex++)
+		{
+			const SheetCell2D &sheetCell = sheet.GetCell(cellIndex);
+
+			result.cells.push_back(BenchCell());
+			BenchCell &cell = result.cells.back();
+			cell.name = sheet.GetCellName(cellIndex);
+			cell.offsetX = sheetCell.offsetX;
+			cell.offsetY = sheetCell.offsetY;
+			cell.pivotX = sheetCell.pivotX;
+			cell.pivotY = sheetCell.pivotY;
+			cell.width = sheetCell.width;
+			cell.height = sheetCell.height;
+			cell.originalWidth = sheetCell.originalWidth;
+			cell.originalHeight = sheetCell.originalHeight;
+			cell.index = sheetCell.index;
+			cell.duration = sheetCell.duration;
+
+			const SheetVertex2D *hullVertices = sheet.GetCellHullVertices(cellIndex);
+			for (unsigned int vertexIndex = 0; vertexIndex < sheetCell.numHullVertices; vertexIndex++)
+			{
+				const Vertex2D vertex = { hullVertices[vertexIndex].x, hullVertices[vertexIndex].y };
+				cell.hullVertices.push_back(vertex);
+			}
+
+			if (sheetCell.maskWidth > 0)
+			{
+				cell.alphaMask.Create(static_cast<int>(sheetCell.maskWidth), static_cast<int>(sheetCell.maskHeight));
+
+				const unsigned int *maskWords = sheet.GetCellMaskWords(cellIndex);
+				for (int y = 0; y < cell.alphaMask.GetHeight(); y++)
+				{
+					unsigned long long *row = cell.alphaMask.GetRow(y);
+					for (int word = 0; word < cell.alphaMask.GetWordsPerRow(); word++)
+					{
+						row[word] = maskWords[0] | (static_cast<unsigned long long>(maskWords[1]) << 32);
+						maskWords += 2;
+					}
+				}
+			}
+		}
+
+		for (int stateIndex = 0; stateIndex < sheet.GetNumStates(); stateIndex++)
+		{
+			const SheetState2D &sheetState = sheet.GetState(stateIndex);
+
+			result.states.push_back(BenchState());
+			BenchState &state = result.states.back();
+			state.name = sheet.GetStateName(stateIndex);
+			state.framerate = sheetState.framerate;
+
+			const unsigned int *stateCells = sheet.GetStateCells(stateIndex);
+			state.cells.assign(stateCells, stateCells + sheetState.numStateCells);
+
+			result.stateNameToIndex[state.name] = stateIndex;
+		}
+
+		return true;
+	}
+
+#if defined(TOOLSET2D_HAVE_TINYXML)
+	// Same steps as SpriteData::LoadXml, parsing from memory rather than the file
+	bool LoadXml(const std::string &text, BenchSheet &result)
+	{
+		TiXmlDocument xmlDocument;
+		xmlDocument.Parse(text.c_str());
+		TiXmlElement *rootElement = xmlDocument.RootElement();
+		if (xmlDocument.Error() || rootElement == NULL)
+		{
+			return false;
+		}
+
+		rootElement->QueryFloatAttribute("width", &result.sourceWidth);
+		rootElement->QueryFloatAttribute("height", &result.sourceHeight);
+
+		for (TiXmlElement *node = rootElement->FirstChildElement("SubTexture");
+			node != NULL;
+			node = node->NextSiblingElement("SubTexture"))
+		{
+			const char *name = node->Attribute("name");
+
+			int x = 0;
+			int y = 0;
+			int width = 0;
+			int height = 0;
+			int originalWidth = 0;
+			int originalHeight = 0;
+			int ox = 0;
+			int oy = 0;
+
+			node->QueryIntAttribute("x", &x);
+			node->QueryIntAttribute("y", &y);
+			node->QueryIntAttribute("width", &width);
+			node->QueryIntAttribute("height", &height);
+			node->QueryIntAttribute("original_width", &originalWidth);
+			node->QueryIntAttribute("original_height", &originalHeight);
+			node->QueryIntAttribute("ox", &ox);
+			node->QueryIntAttribute("oy", &oy);
+
+			const int cellIndex = static_cast<int>(result.cells.size());
+			result.cells.push_back(BenchCell());
+			BenchCell &cell = result.cells.back();
+			cell.name = (name != NULL) ? name : "";
+			cell.offsetX = static_cast<float>(x);
+			cell.offsetY = static_cast<float>(y);
+			cell.pivotX = static_cast<float>(ox);
+			cell.pivotY = static_cast<float>(oy);
+			cell.width = static_cast<float>(width);
+			cell.height = static_cast<float>(height);
+			cell.originalWidth = static_cast<float>(originalWidth);
+			cell.originalHeight = static_cast<float>(originalHeight);
+			cell.index = 0;
+			cell.duration = 0.f;
+			node->QueryFloatAttribute("duration", &cell.duration);
+
+			std::string stateName;
+			const bool animated = ParseCellName2D(cell.name.c_str(), stateName, cell.index);
+
+			std::map<std::string, int>::const_iterator found = result.stateNameToIndex.find(stateName);
+			int stateIndex = (animated && found != result.stateNameToIndex.end()) ? found->second : -1;
+			if (stateIndex == -1)
+			{
+				stateIndex = static_cast<int>(result.states.size());
+				result.states.push_back(BenchState());
+				result.states.back().name = stateName;
+				result.states.back().framerate = animated ? kAnimatedFramerate2D : kSingleCellFramerate2D;
+				result.stateNameToIndex[stateName] = stateIndex;
+			}
+
+			result.states[stateIndex].cells.push_back(cellIndex);
+		}
+
+		return true;
+	}
+#endif // TOOLSET2D_HAVE_TINYXML
+
+	void RunSheet(const char *name)
+	{
+		const std::string path = std::string("Textures/SpriteSheets/") + name;
+
+		std::vector<unsigned int> words;
+		size_t size;
+		if (!ReadAssetFile2D((path + ".sheet").c_str(), words, size))
+		{
+			printf("  %s: no .sheet file, skipped\n", name);
+			return;
+		}
+
+		// Files are read up front, only turning them into cells and states is timed
+		size_t numCells = 0;
+		double start = GetTestSeconds2D();
+		for (int load = 0; load < kNumLoads; load++)
+		{
+			BenchSheet sheet;
+			if (LoadBinary(words, size, sheet))
+			{
+				numCells += sheet.cells.size();
+			}
+		}
+		const double binaryMicroseconds = (GetTestSeconds2D() - start) * 1e6 / kNumLoads;
+		printf("  %s: binary %.2f us per load (%d cells, %d bytes)\n", name, binaryMicroseconds,
+			static_cast<int>(numCells / kNumLoads), static_cast<int>(size));
+
+#if defined(TOOLSET2D_HAVE_TINYXML)
+		std::vector<unsigned int> xmlWords;
+		size_t xmlSize;
+		if (!ReadAssetFile2D((path + ".xml").c_str(), xmlWords, xmlSize))
+		{
+			printf("  %s: no .xml file, skipped\n", name);
+			return;
+		}
+		const std::string text(reinterpret_cast<const char*>(&xmlWords[0]), xmlSize);
+
+		numCells = 0;
+		start = GetTestSeconds2D();
+		for (int load = 0; load < kNumLoads; load++)
+		{
+			BenchSheet sheet;
+			if (LoadXml(text, sheet))
+			{
+				numCells += sheet.cells.size();
+			}
+		}
+		const double xmlMicroseconds = (GetTestSeconds2D() - start) * 1e6 / kNumLoads;
+		printf("  %s: XML %.2f us per load (%d cells, %d bytes), %.1fx the binary\n", name, xmlMicroseconds,
+			static_cast<int>(numCells / kNumLoads), static_cast<int>(xmlSize), xmlMicroseconds / binaryMicroseconds);
+#endif // TOOLSET2D_HAVE_TINYXML
+	}
+}
+
+BENCH_2D(SpriteSheetBinary2D_Load)
+{
+#if !defined(TOOLSET2D_HAVE_TINYXML)
+	printf("  built without TinyXML, only timing the binary sheets\n");
+#endif
+
+	RunSheet("Explosion_v2");
+	RunSheet("Explosion_v1");
+	RunSheet("HeroShip");
+}
@@ -0,0 +1,198 @@
+//=======
+//
+// Purpose: Tests of loading and validating precompiled sprite sheets
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include "SpriteSheetBinary2d.hpp"
+
+#include <string.h>
+
+namespace
+{
+	const char kStrings[] = "walk_01\0walk_02\0walk";
+	const unsigned int kStateNameOffset = 16;
+
+	void Append(std::vector<unsigned int> &words, const void *data, size_t size)
+	{
+		const size_t first = words.size();
+		words.resize(first + size / sizeof(unsigned int));
+		memcpy(&words[first], data, size);
+	}
+
+	// Two cells in a single state, a hull on the first cell and a mask on the second
+	size_t BuildSheet(std::vector<unsigned int> &words)
+	{
+		SheetHeader2D header;
+		memset(&header, 0, sizeof(header));
+		header.magic = kSpriteSheetBinaryMagic;
+		header.version = kSpriteSheetBinaryVersion;
+		header.sourceWidth = 256.f;
+		header.sourceHeight = 128.f;
+		header.numCells = 2;
+		header.numStates = 1;
+		header.numStateCells = 2;
+		header.numHullVertices = 3;
+		header.numMaskWords = 4;
+		header.stringTableSize = sizeof(kStrings) + 3;
+
+		SheetCell2D cells[2];
+		memset(cells, 0, sizeof(cells));
+		cells[0].width = 32.f;
+		cells[0].height = 16.f;
+		cells[0].index = 1;
+		cells[0].numHullVertices = 3;
+		cells[1].width = 3.f;
+		cells[1].height = 2.f;
+		cells[1].index = 2;
+		cells[1].nameOffset = 8;
+		cells[1].duration = 0.5f;
+		cells[1].maskWidth = 3;
+		cells[1].maskHeight = 2;
+
+		SheetState2D state;
+		state.nameOffset = kStateNameOffset;
+		state.framerate = 12.f;
+		state.firstStateCell = 0;
+		state.numStateCells = 2;
+
+		const unsigned int stateCells[2] = { 1, 0 };
+		const SheetVertex2D hull[3] = { { -16.f, -8.f }, { 16.f, -8.f }, { 0.f, 8.f } };
+		const unsigned int maskWords[4] = { 0x5, 0, 0x2, 0 };
+
+		// Names padded with zeros to whole words
+		char strings[sizeof(kStrings) + 3];
+		memset(strings, 0, sizeof(strings));
+		memcpy(strings, kStrings, sizeof(kStrings));
+
+		words.clear();
+		Append(words, &header, sizeof(header));
+		Append(words, cells, sizeof(cells));
+		Append(words, &state, sizeof(state));
+		Append(words, stateCells, sizeof(stateCells));
+		Append(words, hull, sizeof(hull));
+		Append(words, maskWords, sizeof(maskWords));
+		Append(words, strings, sizeof(strings));
+		return words.size() * sizeof(unsigned int);
+	}
+
+	SheetHeader2D &GetHeader(std::vector<unsigned int> &words)
+	{
+		return *reinterpret_cast<SheetHeader2D*>(&words[0]);
+	}
+
+	SheetCell2D *GetCells(std::vector<unsigned int> &words)
+	{
+		return reinterpret_cast<SheetCell2D*>(&words[sizeof(SheetHeader2D) / sizeof(unsigned int)]);
+	}
+}
+
+TEST_2D(SpriteSheetBinary2D_Load)
+{
+	std::vector<unsigned int> words;
+	const size_t size = BuildSheet(words);
+
+	SpriteSheetBinary2D sheet;
+	CHECK_2D( sheet.Load(&words[0], size) );
+	CHECK_2D( sheet.GetSourceWidth() == 256.f && sheet.GetSourceHeight() == 128.f );
+	CHECK_2D( sheet.GetNumCells() == 2 && sheet.GetNumStates() == 1 );
+	if (sheet.GetNumCells() != 2 || sheet.GetNumStates() != 1)
+	{
+		return;
+	}
+
+	CHECK_2D( strcmp(sheet.GetCellName(0), "walk_01") == 0 );
+	CHECK_2D( strcmp(sheet.GetCellName(1), "walk_02") == 0 );
+	CHECK_2D( strcmp(sheet.GetStateName(0), "walk") == 0 );
+	CHECK_2D( sheet.GetState(0).framerate == 12.f );
+	CHECK_2D( sheet.GetStateCells(0)[0] == 1 && sheet.GetStateCells(0)[1] == 0 );
+
+	CHECK_2D( sheet.GetCell(0).numHullVertices == 3 );
+	CHECK_2D( sheet.GetCellHullVertices(0)[2].y == 8.f );
+
+	CHECK_2D( sheet.GetCell(1).duration == 0.5f );
+	CHECK_2D( SpriteSheetBinary2D::GetNumMaskWords(sheet.GetCell(1)) == 4 );
+	CHECK_2D( sheet.GetCellMaskWords(1)[0] == 0x5 && sheet.GetCellMaskWords(1)[2] == 0x2 );
+}
+
+TEST_2D(SpriteSheetBinary2D_RejectsBrokenSheets)
+{
+	std::vector<unsigned int> words;
+	const size_t size = BuildSheet(words);
+
+	// Every truncation, and any trailing data
+	SpriteSheetBinary2D sheet;
+	for (size_t truncated = 0; truncated < size; truncated++)
+	{
+		CHECK_2D( !sheet.Load(&words[0], truncated) );
+	}
+	words.push_back(0);
+	CHECK_2D( !sheet.Load(&words[0], size + sizeof(unsigned int)) );
+
+	BuildSheet(words);
+	GetHeader(words).version = kSpriteSheetBinaryVersion - 1;
+	CHECK_2D( !sheet.Load(&words[0], size) );
+	CHECK_2D( sheet.GetNumCells() == 0 && sheet.GetNumStates() == 0 );
+
+	BuildSheet(words);
+	GetHeader(words).magic = 0;
+	CHECK_2D( !sheet.Load(&words[0], size) );
+
+	BuildSheet(words);
+	GetCells(words)[0].nameOffset = sizeof(kStrings) + 3;
+	CHECK_2D( !sheet.Load(&words[0], size) );
+
+	BuildSheet(words);
+	GetCells(words)[0].numHullVertices = 4;
+	CHECK_2D( !sheet.Load(&words[0], size) );
+
+	BuildSheet(words);
+	GetCells(words)[1].maskHeight = 3;
+	CHECK_2D( !sheet.Load(&words[0], size) );
+
+	BuildSheet(words);
+	GetCells(words)[1].maskWidth = 0;
+	CHECK_2D( !sheet.Load(&words[0], size) );
+
+	// A huge count must not wrap the size check around
+	BuildSheet(words);
+	GetHeader(words).numMaskWords = 0x40000001u;
+	CHECK_2D( !sheet.Load(&words[0], size) );
+
+	// Flipping any byte either still loads or is rejected, but never reads out of bounds
+	BuildSheet(words);
+	for (size_t byte = 0; byte < size; byte++)
+	{
+		std::vector<unsigned int> corrupt(words);
+		reinterpret_cast<unsigned char*>(&corrupt[0])[byte] ^= 0xFF;
+		sheet.Load(&corrupt[0], size);
+	}
+}
+
+TEST_2D(SpriteSheetBinary2D_LoadsSampleSheets)
+{
+	const char *const sheets[] =
+	{
+		"Textures/SpriteSheets/EnemyShip.sheet",
+		"Textures/SpriteSheets/EnemyShipV2.sheet",
+		"Textures/SpriteSheets/Explosion_v1.sheet",
+		"Textures/SpriteSheets/Explosion_v2.sheet",
+		"Textures/SpriteSheets/HeroShip.sheet"
+	};
+
+	for (size_t sheetIndex = 0; sheetIndex < sizeof(sheets) / sizeof(sheets[0]); sheetIndex++)
+	{
+		std::vector<unsigned int> words;
+		size_t size;
+		if (!ReadAssetFile2D(sheets[sheetIndex], words, size))
+		{
+			continue;
+		}
+
+		SpriteSheetBinary2D sheet;
+		CHECK_2D( sheet.Load(&words[0], size) );
+		CHECK_2D( sheet.GetNumCells() > 0 && sheet.GetNumStates() > 0 );
+	}
+}
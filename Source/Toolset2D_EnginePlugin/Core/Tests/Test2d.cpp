@@ -0,0 +1,141 @@
+//=======
+//
+// Purpose: Runs the registered headless tests or benchmarks of the Core library
+//
+//=======
+
+#include "Test2d.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace
+{
+	struct RegisteredTest
+	{
+		const char *name;
+		TestFunction2D function;
+	};
+
+	// Tests register themselves from static constructors in other files, so the list is
+	// created on first use rather than relying on the order of initialization
+	std::vector<RegisteredTest> &GetRegisteredTests()
+	{
+		static std::vector<RegisteredTest> tests;
+		return tests;
+	}
+
+	// Only the first few failures of a test are printed, a broken loop would flood the output
+	const int kMaxReportedFailures = 10;
+
+	int g_numFailures = 0;
+}
+
+TestRegistrar2D::TestRegistrar2D(const char *name, TestFunction2D function)
+{
+	RegisteredTest test;
+	test.name = name;
+	test.function = function;
+	GetRegisteredTests().push_back(test);
+}
+
+void ReportTestFailure2D(const char *file, int line, const char *expression)
+{
+	if (g_numFailures < kMaxReportedFailures)
+	{
+		printf("  %s(%d): check failed: %s\n", file, line, expression);
+	}
+	else if (g_numFailures == kMaxReportedFailures)
+	{
+		printf("  (more failures not shown)\n");
+	}
+
+	g_numFailures++;
+}
+
+double GetTestSeconds2D()
+{
+#if defined(_WIN32)
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return static_cast<double>(counter.QuadPart) / static_cast<double>(frequency.QuadPart);
+#else
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+#endif
+}
+
+bool ReadAssetFile2D(const char *relativePath, std::vector<unsigned int> &words, size_t &size)
+{
+#if defined(TOOLSET2D_ASSETS_DIR)
+	const std::string path = std::string(TOOLSET2D_ASSETS_DIR) + "/" + relativePath;
+
+	FILE *file = fopen(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	const long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	size = (length > 0) ? static_cast<size_t>(length) : 0;
+	words.assign((size + 3) / 4, 0);
+
+	const bool read = (size > 0 && fread(&words[0], 1, size, file) == size);
+	fclose(file);
+	return read;
+#else
+	(void)relativePath;
+	(void)words;
+	(void)size;
+	return false;
+#endif
+}
+
+int main(int argc, char **argv)
+{
+	const char *filter = (argc > 1) ? argv[1] : NULL;
+
+	const std::vector<RegisteredTest> &tests = GetRegisteredTests();
+	int numRun = 0;
+	int numFailed = 0;
+
+	for (size_t testIndex = 0; testIndex < tests.size(); testIndex++)
+	{
+		const RegisteredTest &test = tests[testIndex];
+		if (filter != NULL && strstr(test.name, filter) == NULL)
+		{
+			continue;
+		}
+
+		printf("%s\n", test.name);
+		fflush(stdout);
+
+		g_numFailures = 0;
+		const double start = GetTestSeconds2D();
+		test.function();
+		const double milliseconds = (GetTestSeconds2D() - start) * 1000.0;
+
+		printf("  %s (%.1f ms)\n", (g_numFailures == 0) ? "ok" : "FAILED", milliseconds);
+		fflush(stdout);
+
+		numRun++;
+		numFailed += (g_numFailures != 0) ? 1 : 0;
+	}
+
+	printf("%d run, %d failed\n", numRun, numFailed);
+	return (numFailed == 0 && numRun > 0) ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+#ifndef TEST_2D_HPP_INCLUDED
+#define TEST_2D_HPP_INCLUDED
+
+#include <math.h>
+#include <stddef.h>
+
+#include <vector>
+
+// Tiny registry behind the headless tests and benchmarks of Core/. Every TEST_2D or
+// BENCH_2D registers itself, and the executable runs all of them, or only the ones whose
+// name contains the first command line argument. Tests report failed checks and the
+// executable returns non-zero if any of them failed. Benchmarks print their own results.
+
+typedef void (*TestFunction2D)();
+
+struct TestRegistrar2D
+{
+	TestRegistrar2D(const char *name, TestFunction2D function);
+};
+
+void ReportTestFailure2D(const char *file, int line, const char *expression);
+
+#define TEST_2D(name) \
+	static void name(); \
+	static TestRegistrar2D name##Registrar(#name, name); \
+	static void name()
+
+#define BENCH_2D(name) TEST_2D(name)
+
+#define CHECK_2D(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			ReportTestFailure2D(__FILE__, __LINE__, #condition); \
+		} \
+	} while (0)
+
+#define CHECK_CLOSE_2D(value, expected, tolerance) \
+	CHECK_2D( fabs(static_cast<double>(value) - static_cast<double>(expected)) <= (tolerance) )
+
+// Seconds since some point in the past, for timing benchmarks
+double GetTestSeconds2D();
+
+// Reads a file below the Assets folder into 4-byte aligned memory. Returns false if the
+// file isn't there, which tests treat as nothing to check.
+bool ReadAssetFile2D(const char *relativePath, std::vector<unsigned int> &words, size_t &size);
+
+// Same sequence on every platform and compiler, unlike rand(), so a failure seen anywhere
+// can be reproduced from its seed
+class TestRandom2D
+{
+public:
+	explicit TestRandom2D(unsigned int seed)
+	{
+		m_state = (seed * 2654435761u) ^ 0x9E3779B9u;
+		if (m_state == 0)
+		{
+			m_state = 1;
+		}
+	}
+
+	// xorshift32
+	unsigned int Next()
+	{
+		m_state ^= m_state << 13;
+		m_state ^= m_state >> 17;
+		m_state ^= m_state << 5;
+		return m_state;
+	}
+
+	// From zero up to but not including 'count'
+	int NextInt(int count)
+	{
+		return static_cast<int>(Next() % static_cast<unsigned int>(count));
+	}
+
+	// From 'minimum' to 'maximum', both included
+	float NextFloat(float minimum, float maximum)
+	{
+		const float unit = static_cast<float>(Next() >> 8) * (1.0f / 16777215.0f);
+		return minimum + (maximum - minimum) * unit;
+	}
+
+	bool NextBool()
+	{
+		return (Next() & 0x100) != 0;
+	}
+
+private:
+	unsigned int m_state;
+};
+
+#endif // TEST_2D_HPP_INCLUDED
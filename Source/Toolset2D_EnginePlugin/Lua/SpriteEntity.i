@@ -11,6 +11,9 @@ class Sprite : public VisBaseEntity_cl
 {
 public:
 	bool SetState(const char *state);
+	bool SetStateById(int stateId);
+	int GetStateId(const char *state) const;
+	int GetCurrentStateId() const;
 	void SetFramePercent(float percent);
 	void Pause();
 	void Play();
@@ -34,6 +37,17 @@ public:
 	
 	void SetConvexHullCollision(bool enabled);
 	bool IsConvexHullCollision() const;
+
+	void SetPixelCollision(bool enabled);
+	bool IsPixelCollision() const;
+
+	void SetContinuousCollision(bool enabled);
+	bool IsContinuousCollision() const;
+
+	void SetCollisionLayer(unsigned int layer);
+	unsigned int GetCollisionLayer() const;
+	void SetCollisionMask(unsigned int mask);
+	unsigned int GetCollisionMask() const;
 	
 	Sprite *Clone(const hkvVec3 *position = NULL) const;
 
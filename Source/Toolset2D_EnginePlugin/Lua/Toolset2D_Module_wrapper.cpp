@@ -3027,6 +3027,45 @@ SWIGINTERN Camera2D *Camera2D_Cast(VTypedObject *pObject){
 SWIGINTERN Toolset2dManager *Toolset2dManager_Cast(unsigned long *lObject){
     return (Toolset2dManager *) lObject;
   }
+
+SWIGINTERN int Toolset2dManager_GetStats(lua_State *L)
+{
+  SWIG_CONVERT_POINTER(L, 1, Toolset2dManager, pManager)
+
+  const FrameStats2D &stats = pManager->GetStats();
+
+  lua_newtable(L);
+
+  lua_pushstring(L, "frames");
+  lua_pushnumber(L, (lua_Number)stats.GetNumFrames());
+  lua_settable(L, -3);
+
+  for (int timer = 0; timer < NUM_FRAME_TIMERS; timer++)
+  {
+    const FrameTimer2D frameTimer = (FrameTimer2D)timer;
+    const std::string maxName = std::string(FrameStats2D::GetTimerName(frameTimer)) + "Max";
+
+    lua_pushstring(L, FrameStats2D::GetTimerName(frameTimer));
+    lua_pushnumber(L, (lua_Number)stats.GetAverageTime(frameTimer));
+    lua_settable(L, -3);
+
+    lua_pushstring(L, maxName.c_str());
+    lua_pushnumber(L, (lua_Number)stats.GetMaxTime(frameTimer));
+    lua_settable(L, -3);
+  }
+
+  for (int counter = 0; counter < NUM_FRAME_COUNTERS; counter++)
+  {
+    const FrameCounter2D frameCounter = (FrameCounter2D)counter;
+
+    lua_pushstring(L, FrameStats2D::GetCounterName(frameCounter));
+    lua_pushnumber(L, (lua_Number)stats.GetAverageCount(frameCounter));
+    lua_settable(L, -3);
+  }
+
+  return 1;
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10978,6 +11017,297 @@ static int _wrap_Sprite_Clone(lua_State* L) {
 }
 
 
+static int _wrap_Sprite_SetCollisionLayer(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  unsigned int arg2 ;
+  
+  SWIG_check_num_args("SetCollisionLayer",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetCollisionLayer",1,"Sprite *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetCollisionLayer",1,"Sprite *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetCollisionLayer",2,"unsigned int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_SetCollisionLayer",1,SWIGTYPE_p_Sprite);
+  }
+  
+  SWIG_contract_assert((lua_tonumber(L,2)>=0),"number must not be negative")
+  arg2 = (unsigned int)lua_tonumber(L, 2);
+  (arg1)->SetCollisionLayer(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_GetCollisionLayer(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  unsigned int result;
+  
+  SWIG_check_num_args("GetCollisionLayer",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetCollisionLayer",1,"Sprite const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetCollisionLayer",1,"Sprite const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_GetCollisionLayer",1,SWIGTYPE_p_Sprite);
+  }
+  
+  result = (unsigned int)((Sprite const *)arg1)->GetCollisionLayer();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_SetCollisionMask(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  unsigned int arg2 ;
+  
+  SWIG_check_num_args("SetCollisionMask",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetCollisionMask",1,"Sprite *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetCollisionMask",1,"Sprite *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetCollisionMask",2,"unsigned int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_SetCollisionMask",1,SWIGTYPE_p_Sprite);
+  }
+  
+  SWIG_contract_assert((lua_tonumber(L,2)>=0),"number must not be negative")
+  arg2 = (unsigned int)lua_tonumber(L, 2);
+  (arg1)->SetCollisionMask(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_GetCollisionMask(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  unsigned int result;
+  
+  SWIG_check_num_args("GetCollisionMask",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetCollisionMask",1,"Sprite const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetCollisionMask",1,"Sprite const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_GetCollisionMask",1,SWIGTYPE_p_Sprite);
+  }
+  
+  result = (unsigned int)((Sprite const *)arg1)->GetCollisionMask();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_SetStateById(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  int arg2 ;
+  bool result;
+  
+  SWIG_check_num_args("SetStateById",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetStateById",1,"Sprite *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetStateById",1,"Sprite *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetStateById",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_SetStateById",1,SWIGTYPE_p_Sprite);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  result = (bool)(arg1)->SetStateById(arg2);
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_GetStateId(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  char *arg2 = (char *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetStateId",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetStateId",1,"Sprite const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetStateId",1,"Sprite const *");
+  if(!SWIG_lua_isnilstring(L,2)) SWIG_fail_arg("GetStateId",2,"char const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_GetStateId",1,SWIGTYPE_p_Sprite);
+  }
+  
+  arg2 = (char *)lua_tostring(L, 2);
+  result = (int)((Sprite const *)arg1)->GetStateId((char const *)arg2);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_GetCurrentStateId(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetCurrentStateId",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetCurrentStateId",1,"Sprite const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetCurrentStateId",1,"Sprite const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_GetCurrentStateId",1,SWIGTYPE_p_Sprite);
+  }
+  
+  result = (int)((Sprite const *)arg1)->GetCurrentStateId();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_SetPixelCollision(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  bool arg2 ;
+  
+  SWIG_check_num_args("SetPixelCollision",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetPixelCollision",1,"Sprite *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetPixelCollision",1,"Sprite *");
+  if(!lua_isboolean(L,2)) SWIG_fail_arg("SetPixelCollision",2,"bool");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_SetPixelCollision",1,SWIGTYPE_p_Sprite);
+  }
+  
+  arg2 = (lua_toboolean(L, 2)!=0);
+  (arg1)->SetPixelCollision(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_IsPixelCollision(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsPixelCollision",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsPixelCollision",1,"Sprite const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsPixelCollision",1,"Sprite const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_IsPixelCollision",1,SWIGTYPE_p_Sprite);
+  }
+  
+  result = (bool)((Sprite const *)arg1)->IsPixelCollision();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_SetContinuousCollision(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  bool arg2 ;
+  
+  SWIG_check_num_args("SetContinuousCollision",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetContinuousCollision",1,"Sprite *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetContinuousCollision",1,"Sprite *");
+  if(!lua_isboolean(L,2)) SWIG_fail_arg("SetContinuousCollision",2,"bool");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_SetContinuousCollision",1,SWIGTYPE_p_Sprite);
+  }
+  
+  arg2 = (lua_toboolean(L, 2)!=0);
+  (arg1)->SetContinuousCollision(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Sprite_IsContinuousCollision(lua_State* L) {
+  int SWIG_arg = 0;
+  Sprite *arg1 = (Sprite *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsContinuousCollision",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsContinuousCollision",1,"Sprite const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsContinuousCollision",1,"Sprite const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Sprite_IsContinuousCollision",1,SWIGTYPE_p_Sprite);
+  }
+  
+  result = (bool)((Sprite const *)arg1)->IsContinuousCollision();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
 static int _wrap_Sprite_Cast(lua_State* L) {
   int SWIG_arg = 0;
   VTypedObject *arg1 = (VTypedObject *) 0 ;
@@ -11019,6 +11349,17 @@ static swig_lua_method swig_Sprite_methods[] = {
     {"SetConvexHullCollision", _wrap_Sprite_SetConvexHullCollision}, 
     {"IsConvexHullCollision", _wrap_Sprite_IsConvexHullCollision}, 
     {"Clone", _wrap_Sprite_Clone}, 
+    {"SetCollisionLayer", _wrap_Sprite_SetCollisionLayer}, 
+    {"GetCollisionLayer", _wrap_Sprite_GetCollisionLayer}, 
+    {"SetCollisionMask", _wrap_Sprite_SetCollisionMask}, 
+    {"GetCollisionMask", _wrap_Sprite_GetCollisionMask}, 
+    {"SetStateById", _wrap_Sprite_SetStateById}, 
+    {"GetStateId", _wrap_Sprite_GetStateId}, 
+    {"GetCurrentStateId", _wrap_Sprite_GetCurrentStateId}, 
+    {"SetPixelCollision", _wrap_Sprite_SetPixelCollision}, 
+    {"IsPixelCollision", _wrap_Sprite_IsPixelCollision}, 
+    {"SetContinuousCollision", _wrap_Sprite_SetContinuousCollision}, 
+    {"IsContinuousCollision", _wrap_Sprite_IsContinuousCollision}, 
     {0,0}
 };
 static swig_lua_attribute swig_Sprite_attributes[] = {
@@ -11297,27 +11638,34 @@ static int _wrap_Toolset2dManager_CreateSprite(lua_State* L) {
 }
 
 
-static int _wrap_Toolset2dManager_SetCamera(lua_State* L) {
+static int _wrap_Toolset2dManager_AcquireSprite__SWIG_0(lua_State* L) {
   int SWIG_arg = 0;
   Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
-  Camera2D *arg2 = (Camera2D *) 0 ;
+  hkvVec3 *arg2 = 0 ;
+  char *arg3 = (char *) 0 ;
+  char *arg4 = (char *) 0 ;
+  Sprite *result = 0 ;
   
-  SWIG_check_num_args("SetCamera",2,2)
-  if(lua_isnil(L, 1)) SWIG_fail_arg("SetCamera",1,"Toolset2dManager *");
-  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetCamera",1,"Toolset2dManager *");
-  if(!SWIG_isptrtype(L,2)) SWIG_fail_arg("SetCamera",2,"Camera2D *");
+  SWIG_check_num_args("AcquireSprite",4,4)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("AcquireSprite",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("AcquireSprite",1,"Toolset2dManager *");
+  if(!lua_isuserdata(L,2)) SWIG_fail_arg("AcquireSprite",2,"hkvVec3 const &");
+  if(!SWIG_lua_isnilstring(L,3)) SWIG_fail_arg("AcquireSprite",3,"char const *");
+  if(!SWIG_lua_isnilstring(L,4)) SWIG_fail_arg("AcquireSprite",4,"char const *");
   
   if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
-    SWIG_fail_ptr("Toolset2dManager_SetCamera",1,SWIGTYPE_p_Toolset2dManager);
+    SWIG_fail_ptr("Toolset2dManager_AcquireSprite",1,SWIGTYPE_p_Toolset2dManager);
   }
   
   
-  if (!SWIG_IsOK(SWIG_ConvertPtr(L,2,(void**)&arg2,SWIGTYPE_p_Camera2D,0))){
-    SWIG_fail_ptr("Toolset2dManager_SetCamera",2,SWIGTYPE_p_Camera2D);
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,2,(void**)&arg2,SWIGTYPE_p_hkvVec3,0))){
+    SWIG_fail_ptr("Toolset2dManager_AcquireSprite",2,SWIGTYPE_p_hkvVec3);
   }
   
-  (arg1)->SetCamera(arg2);
-  
+  arg3 = (char *)lua_tostring(L, 3);
+  arg4 = (char *)lua_tostring(L, 4);
+  result = (Sprite *)(arg1)->AcquireSprite((hkvVec3 const &)*arg2,(char const *)arg3,(char const *)arg4);
+  SWIG_NewPointerObj(L,result,SWIGTYPE_p_Sprite,0); SWIG_arg++; 
   return SWIG_arg;
   
   if(0) SWIG_fail;
@@ -11328,10 +11676,155 @@ fail:
 }
 
 
-static int _wrap_Toolset2dManager_GetCamera(lua_State* L) {
+static int _wrap_Toolset2dManager_AcquireSprite__SWIG_1(lua_State* L) {
   int SWIG_arg = 0;
   Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
-  Camera2D *result = 0 ;
+  hkvVec3 *arg2 = 0 ;
+  char *arg3 = (char *) 0 ;
+  Sprite *result = 0 ;
+  
+  SWIG_check_num_args("AcquireSprite",3,3)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("AcquireSprite",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("AcquireSprite",1,"Toolset2dManager *");
+  if(!lua_isuserdata(L,2)) SWIG_fail_arg("AcquireSprite",2,"hkvVec3 const &");
+  if(!SWIG_lua_isnilstring(L,3)) SWIG_fail_arg("AcquireSprite",3,"char const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_AcquireSprite",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,2,(void**)&arg2,SWIGTYPE_p_hkvVec3,0))){
+    SWIG_fail_ptr("Toolset2dManager_AcquireSprite",2,SWIGTYPE_p_hkvVec3);
+  }
+  
+  arg3 = (char *)lua_tostring(L, 3);
+  result = (Sprite *)(arg1)->AcquireSprite((hkvVec3 const &)*arg2,(char const *)arg3);
+  SWIG_NewPointerObj(L,result,SWIGTYPE_p_Sprite,0); SWIG_arg++; 
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_AcquireSprite(lua_State* L) {
+  int argc;
+  int argv[5]={
+    1,2,3,4,5
+  };
+  
+  argc = lua_gettop(L);
+  if (argc == 3) {
+    int _v;
+    {
+      void *ptr;
+      if (SWIG_isptrtype(L,argv[0])==0 || SWIG_ConvertPtr(L,argv[0], (void **) &ptr, SWIGTYPE_p_Toolset2dManager, 0)) {
+        _v = 0;
+      } else {
+        _v = 1;
+      }
+    }
+    if (_v) {
+      {
+        void *ptr;
+        if (lua_isuserdata(L,argv[1])==0 || SWIG_ConvertPtr(L,argv[1], (void **) &ptr, SWIGTYPE_p_hkvVec3, 0)) {
+          _v = 0;
+        } else {
+          _v = 1;
+        }
+      }
+      if (_v) {
+        {
+          _v = SWIG_lua_isnilstring(L,argv[2]);
+        }
+        if (_v) {
+          return _wrap_Toolset2dManager_AcquireSprite__SWIG_1(L);
+        }
+      }
+    }
+  }
+  if (argc == 4) {
+    int _v;
+    {
+      void *ptr;
+      if (SWIG_isptrtype(L,argv[0])==0 || SWIG_ConvertPtr(L,argv[0], (void **) &ptr, SWIGTYPE_p_Toolset2dManager, 0)) {
+        _v = 0;
+      } else {
+        _v = 1;
+      }
+    }
+    if (_v) {
+      {
+        void *ptr;
+        if (lua_isuserdata(L,argv[1])==0 || SWIG_ConvertPtr(L,argv[1], (void **) &ptr, SWIGTYPE_p_hkvVec3, 0)) {
+          _v = 0;
+        } else {
+          _v = 1;
+        }
+      }
+      if (_v) {
+        {
+          _v = SWIG_lua_isnilstring(L,argv[2]);
+        }
+        if (_v) {
+          {
+            _v = SWIG_lua_isnilstring(L,argv[3]);
+          }
+          if (_v) {
+            return _wrap_Toolset2dManager_AcquireSprite__SWIG_0(L);
+          }
+        }
+      }
+    }
+  }
+  
+  lua_pushstring(L,"Wrong arguments for overloaded function 'Toolset2dManager_AcquireSprite'\n"
+    "  Possible C/C++ prototypes are:\n"
+    "    AcquireSprite(Toolset2dManager *,hkvVec3 const &,char const *,char const *)\n"
+    "    AcquireSprite(Toolset2dManager *,hkvVec3 const &,char const *)\n");
+  lua_error(L);return 0;
+}
+
+
+static int _wrap_Toolset2dManager_SetCamera(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  Camera2D *arg2 = (Camera2D *) 0 ;
+  
+  SWIG_check_num_args("SetCamera",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetCamera",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetCamera",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,2)) SWIG_fail_arg("SetCamera",2,"Camera2D *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetCamera",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,2,(void**)&arg2,SWIGTYPE_p_Camera2D,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetCamera",2,SWIGTYPE_p_Camera2D);
+  }
+  
+  (arg1)->SetCamera(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetCamera(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  Camera2D *result = 0 ;
   
   SWIG_check_num_args("GetCamera",1,1)
   if(lua_isnil(L, 1)) SWIG_fail_arg("GetCamera",1,"Toolset2dManager *");
@@ -11353,6 +11846,1377 @@ fail:
 }
 
 
+static int _wrap_Toolset2dManager_SetCollisionCellSize(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float arg2 ;
+  
+  SWIG_check_num_args("SetCollisionCellSize",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetCollisionCellSize",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetCollisionCellSize",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetCollisionCellSize",2,"float");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetCollisionCellSize",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (float)lua_tonumber(L, 2);
+  (arg1)->SetCollisionCellSize(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetCollisionCellSize(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float result;
+  
+  SWIG_check_num_args("GetCollisionCellSize",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetCollisionCellSize",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetCollisionCellSize",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetCollisionCellSize",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (float)((Toolset2dManager const *)arg1)->GetCollisionCellSize();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetNumRenderBatches(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetNumRenderBatches",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetNumRenderBatches",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetNumRenderBatches",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetNumRenderBatches",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetNumRenderBatches();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetNumRenderQuads(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetNumRenderQuads",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetNumRenderQuads",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetNumRenderQuads",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetNumRenderQuads",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetNumRenderQuads();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetNumRenderVertices(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetNumRenderVertices",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetNumRenderVertices",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetNumRenderVertices",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetNumRenderVertices",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetNumRenderVertices();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetTextureAtlasEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool arg2 ;
+  
+  SWIG_check_num_args("SetTextureAtlasEnabled",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetTextureAtlasEnabled",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetTextureAtlasEnabled",1,"Toolset2dManager *");
+  if(!lua_isboolean(L,2)) SWIG_fail_arg("SetTextureAtlasEnabled",2,"bool");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetTextureAtlasEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (lua_toboolean(L, 2)!=0);
+  (arg1)->SetTextureAtlasEnabled(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_IsTextureAtlasEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsTextureAtlasEnabled",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsTextureAtlasEnabled",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsTextureAtlasEnabled",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_IsTextureAtlasEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (bool)((Toolset2dManager const *)arg1)->IsTextureAtlasEnabled();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetTextureAtlasPageSize(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  
+  SWIG_check_num_args("SetTextureAtlasPageSize",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetTextureAtlasPageSize",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetTextureAtlasPageSize",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetTextureAtlasPageSize",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetTextureAtlasPageSize",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  (arg1)->SetTextureAtlasPageSize(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetTextureAtlasPageSize(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetTextureAtlasPageSize",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetTextureAtlasPageSize",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetTextureAtlasPageSize",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetTextureAtlasPageSize",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetTextureAtlasPageSize();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetTextureAtlasPadding(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  
+  SWIG_check_num_args("SetTextureAtlasPadding",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetTextureAtlasPadding",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetTextureAtlasPadding",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetTextureAtlasPadding",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetTextureAtlasPadding",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  (arg1)->SetTextureAtlasPadding(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetTextureAtlasPadding(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetTextureAtlasPadding",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetTextureAtlasPadding",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetTextureAtlasPadding",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetTextureAtlasPadding",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetTextureAtlasPadding();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetUpdateThreadCount(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  
+  SWIG_check_num_args("SetUpdateThreadCount",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetUpdateThreadCount",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetUpdateThreadCount",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetUpdateThreadCount",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetUpdateThreadCount",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  (arg1)->SetUpdateThreadCount(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetUpdateThreadCount(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetUpdateThreadCount",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetUpdateThreadCount",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetUpdateThreadCount",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetUpdateThreadCount",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetUpdateThreadCount();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetCollisionStayEventEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool arg2 ;
+  
+  SWIG_check_num_args("SetCollisionStayEventEnabled",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetCollisionStayEventEnabled",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetCollisionStayEventEnabled",1,"Toolset2dManager *");
+  if(!lua_isboolean(L,2)) SWIG_fail_arg("SetCollisionStayEventEnabled",2,"bool");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetCollisionStayEventEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (lua_toboolean(L, 2)!=0);
+  (arg1)->SetCollisionStayEventEnabled(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_IsCollisionStayEventEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsCollisionStayEventEnabled",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsCollisionStayEventEnabled",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsCollisionStayEventEnabled",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_IsCollisionStayEventEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (bool)((Toolset2dManager const *)arg1)->IsCollisionStayEventEnabled();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetCollisionEventBatchingEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool arg2 ;
+  
+  SWIG_check_num_args("SetCollisionEventBatchingEnabled",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetCollisionEventBatchingEnabled",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetCollisionEventBatchingEnabled",1,"Toolset2dManager *");
+  if(!lua_isboolean(L,2)) SWIG_fail_arg("SetCollisionEventBatchingEnabled",2,"bool");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetCollisionEventBatchingEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (lua_toboolean(L, 2)!=0);
+  (arg1)->SetCollisionEventBatchingEnabled(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_IsCollisionEventBatchingEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsCollisionEventBatchingEnabled",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsCollisionEventBatchingEnabled",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsCollisionEventBatchingEnabled",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_IsCollisionEventBatchingEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (bool)((Toolset2dManager const *)arg1)->IsCollisionEventBatchingEnabled();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetCollisionContact(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  Sprite *result = 0 ;
+  
+  SWIG_check_num_args("GetCollisionContact",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetCollisionContact",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetCollisionContact",1,"Toolset2dManager const *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("GetCollisionContact",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetCollisionContact",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  result = (Sprite *)((Toolset2dManager const *)arg1)->GetCollisionContact(arg2);
+  SWIG_NewPointerObj(L,result,SWIGTYPE_p_Sprite,0); SWIG_arg++; 
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetCollisionContactState(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  char *result = 0 ;
+  
+  SWIG_check_num_args("GetCollisionContactState",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetCollisionContactState",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetCollisionContactState",1,"Toolset2dManager const *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("GetCollisionContactState",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetCollisionContactState",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  result = (char *)((Toolset2dManager const *)arg1)->GetCollisionContactState(arg2);
+  lua_pushstring(L,(const char *)result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_ReleaseSprite(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  Sprite *arg2 = (Sprite *) 0 ;
+  
+  SWIG_check_num_args("ReleaseSprite",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("ReleaseSprite",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("ReleaseSprite",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,2)) SWIG_fail_arg("ReleaseSprite",2,"Sprite *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_ReleaseSprite",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,2,(void**)&arg2,SWIGTYPE_p_Sprite,0))){
+    SWIG_fail_ptr("Toolset2dManager_ReleaseSprite",2,SWIGTYPE_p_Sprite);
+  }
+  
+  (arg1)->ReleaseSprite(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_PrewarmSpritePool(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  char *arg2 = (char *) 0 ;
+  char *arg3 = (char *) 0 ;
+  int arg4 ;
+  
+  SWIG_check_num_args("PrewarmSpritePool",4,4)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("PrewarmSpritePool",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("PrewarmSpritePool",1,"Toolset2dManager *");
+  if(!SWIG_lua_isnilstring(L,2)) SWIG_fail_arg("PrewarmSpritePool",2,"char const *");
+  if(!SWIG_lua_isnilstring(L,3)) SWIG_fail_arg("PrewarmSpritePool",3,"char const *");
+  if(!lua_isnumber(L,4)) SWIG_fail_arg("PrewarmSpritePool",4,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_PrewarmSpritePool",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (char *)lua_tostring(L, 2);
+  arg3 = (char *)lua_tostring(L, 3);
+  arg4 = (int)lua_tonumber(L, 4);
+  (arg1)->PrewarmSpritePool((char const *)arg2,(char const *)arg3,arg4);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetSpritePoolHits(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetSpritePoolHits",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetSpritePoolHits",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetSpritePoolHits",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetSpritePoolHits",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetSpritePoolHits();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetSpritePoolMisses(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetSpritePoolMisses",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetSpritePoolMisses",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetSpritePoolMisses",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetSpritePoolMisses",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetSpritePoolMisses();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetSpritePoolHighWater(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetSpritePoolHighWater",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetSpritePoolHighWater",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetSpritePoolHighWater",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetSpritePoolHighWater",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetSpritePoolHighWater();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetNumPooledSprites(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetNumPooledSprites",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetNumPooledSprites",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetNumPooledSprites",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetNumPooledSprites",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetNumPooledSprites();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_EvictUnusedSpriteData(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("EvictUnusedSpriteData",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("EvictUnusedSpriteData",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("EvictUnusedSpriteData",1,"Toolset2dManager *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_EvictUnusedSpriteData",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)(arg1)->EvictUnusedSpriteData();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetNumSpriteSheets(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetNumSpriteSheets",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetNumSpriteSheets",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetNumSpriteSheets",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetNumSpriteSheets",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetNumSpriteSheets();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetAsyncLoadingEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool arg2 ;
+  
+  SWIG_check_num_args("SetAsyncLoadingEnabled",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetAsyncLoadingEnabled",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetAsyncLoadingEnabled",1,"Toolset2dManager *");
+  if(!lua_isboolean(L,2)) SWIG_fail_arg("SetAsyncLoadingEnabled",2,"bool");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetAsyncLoadingEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (lua_toboolean(L, 2)!=0);
+  (arg1)->SetAsyncLoadingEnabled(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_IsAsyncLoadingEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsAsyncLoadingEnabled",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsAsyncLoadingEnabled",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsAsyncLoadingEnabled",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_IsAsyncLoadingEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (bool)((Toolset2dManager const *)arg1)->IsAsyncLoadingEnabled();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_PreloadSpriteSheet(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  char *arg2 = (char *) 0 ;
+  char *arg3 = (char *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("PreloadSpriteSheet",3,3)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("PreloadSpriteSheet",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("PreloadSpriteSheet",1,"Toolset2dManager *");
+  if(!SWIG_lua_isnilstring(L,2)) SWIG_fail_arg("PreloadSpriteSheet",2,"char const *");
+  if(!SWIG_lua_isnilstring(L,3)) SWIG_fail_arg("PreloadSpriteSheet",3,"char const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_PreloadSpriteSheet",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (char *)lua_tostring(L, 2);
+  arg3 = (char *)lua_tostring(L, 3);
+  result = (bool)(arg1)->PreloadSpriteSheet((char const *)arg2,(char const *)arg3);
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_IsSpriteSheetLoaded(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  char *arg2 = (char *) 0 ;
+  char *arg3 = (char *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsSpriteSheetLoaded",3,3)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsSpriteSheetLoaded",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsSpriteSheetLoaded",1,"Toolset2dManager *");
+  if(!SWIG_lua_isnilstring(L,2)) SWIG_fail_arg("IsSpriteSheetLoaded",2,"char const *");
+  if(!SWIG_lua_isnilstring(L,3)) SWIG_fail_arg("IsSpriteSheetLoaded",3,"char const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_IsSpriteSheetLoaded",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (char *)lua_tostring(L, 2);
+  arg3 = (char *)lua_tostring(L, 3);
+  result = (bool)(arg1)->IsSpriteSheetLoaded((char const *)arg2,(char const *)arg3);
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetNumPendingSpriteSheets(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetNumPendingSpriteSheets",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetNumPendingSpriteSheets",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetNumPendingSpriteSheets",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetNumPendingSpriteSheets",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetNumPendingSpriteSheets();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_LoadSpriteSheetManifest(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  char *arg2 = (char *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("LoadSpriteSheetManifest",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("LoadSpriteSheetManifest",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("LoadSpriteSheetManifest",1,"Toolset2dManager *");
+  if(!SWIG_lua_isnilstring(L,2)) SWIG_fail_arg("LoadSpriteSheetManifest",2,"char const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_LoadSpriteSheetManifest",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (char *)lua_tostring(L, 2);
+  result = (int)(arg1)->LoadSpriteSheetManifest((char const *)arg2);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetSpriteSheetLoadProgress(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float result;
+  
+  SWIG_check_num_args("GetSpriteSheetLoadProgress",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetSpriteSheetLoadProgress",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetSpriteSheetLoadProgress",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetSpriteSheetLoadProgress",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (float)((Toolset2dManager const *)arg1)->GetSpriteSheetLoadProgress();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetTimeToFirstFrame(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float result;
+  
+  SWIG_check_num_args("GetTimeToFirstFrame",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetTimeToFirstFrame",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetTimeToFirstFrame",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetTimeToFirstFrame",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (float)((Toolset2dManager const *)arg1)->GetTimeToFirstFrame();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetStatsHistorySize(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  
+  SWIG_check_num_args("SetStatsHistorySize",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetStatsHistorySize",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetStatsHistorySize",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("SetStatsHistorySize",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetStatsHistorySize",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  (arg1)->SetStatsHistorySize(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetStatsHistorySize(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetStatsHistorySize",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetStatsHistorySize",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetStatsHistorySize",1,"Toolset2dManager *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetStatsHistorySize",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)(arg1)->GetStatsHistorySize();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_SetStatsOverlayEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool arg2 ;
+  
+  SWIG_check_num_args("SetStatsOverlayEnabled",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("SetStatsOverlayEnabled",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("SetStatsOverlayEnabled",1,"Toolset2dManager *");
+  if(!lua_isboolean(L,2)) SWIG_fail_arg("SetStatsOverlayEnabled",2,"bool");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_SetStatsOverlayEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (lua_toboolean(L, 2)!=0);
+  (arg1)->SetStatsOverlayEnabled(arg2);
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_IsStatsOverlayEnabled(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsStatsOverlayEnabled",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsStatsOverlayEnabled",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsStatsOverlayEnabled",1,"Toolset2dManager *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_IsStatsOverlayEnabled",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (bool)(arg1)->IsStatsOverlayEnabled();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_StartStatsCsv(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  char *arg2 = (char *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("StartStatsCsv",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("StartStatsCsv",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("StartStatsCsv",1,"Toolset2dManager *");
+  if(!SWIG_lua_isnilstring(L,2)) SWIG_fail_arg("StartStatsCsv",2,"char const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_StartStatsCsv",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (char *)lua_tostring(L, 2);
+  result = (bool)(arg1)->StartStatsCsv((char const *)arg2);
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_StopStatsCsv(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  
+  SWIG_check_num_args("StopStatsCsv",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("StopStatsCsv",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("StopStatsCsv",1,"Toolset2dManager *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_StopStatsCsv",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  (arg1)->StopStatsCsv();
+  
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_IsWritingStatsCsv(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  bool result;
+  
+  SWIG_check_num_args("IsWritingStatsCsv",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("IsWritingStatsCsv",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("IsWritingStatsCsv",1,"Toolset2dManager *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_IsWritingStatsCsv",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (bool)(arg1)->IsWritingStatsCsv();
+  lua_pushboolean(L,(int)(result!=0)); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetCollisionContactTime(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  float result;
+  
+  SWIG_check_num_args("GetCollisionContactTime",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetCollisionContactTime",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetCollisionContactTime",1,"Toolset2dManager const *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("GetCollisionContactTime",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetCollisionContactTime",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  result = (float)((Toolset2dManager const *)arg1)->GetCollisionContactTime(arg2);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_QueryPoint(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float arg2 ;
+  float arg3 ;
+  unsigned int arg4 ;
+  int result;
+  
+  SWIG_check_num_args("QueryPoint",4,4)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("QueryPoint",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("QueryPoint",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("QueryPoint",2,"float");
+  if(!lua_isnumber(L,3)) SWIG_fail_arg("QueryPoint",3,"float");
+  if(!lua_isnumber(L,4)) SWIG_fail_arg("QueryPoint",4,"unsigned int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_QueryPoint",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (float)lua_tonumber(L, 2);
+  arg3 = (float)lua_tonumber(L, 3);
+  SWIG_contract_assert((lua_tonumber(L,4)>=0),"number must not be negative")
+  arg4 = (unsigned int)lua_tonumber(L, 4);
+  result = (int)(arg1)->QueryPoint(arg2,arg3,arg4);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_QueryRect(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float arg2 ;
+  float arg3 ;
+  float arg4 ;
+  float arg5 ;
+  unsigned int arg6 ;
+  int result;
+  
+  SWIG_check_num_args("QueryRect",6,6)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("QueryRect",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("QueryRect",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("QueryRect",2,"float");
+  if(!lua_isnumber(L,3)) SWIG_fail_arg("QueryRect",3,"float");
+  if(!lua_isnumber(L,4)) SWIG_fail_arg("QueryRect",4,"float");
+  if(!lua_isnumber(L,5)) SWIG_fail_arg("QueryRect",5,"float");
+  if(!lua_isnumber(L,6)) SWIG_fail_arg("QueryRect",6,"unsigned int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_QueryRect",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (float)lua_tonumber(L, 2);
+  arg3 = (float)lua_tonumber(L, 3);
+  arg4 = (float)lua_tonumber(L, 4);
+  arg5 = (float)lua_tonumber(L, 5);
+  SWIG_contract_assert((lua_tonumber(L,6)>=0),"number must not be negative")
+  arg6 = (unsigned int)lua_tonumber(L, 6);
+  result = (int)(arg1)->QueryRect(arg2,arg3,arg4,arg5,arg6);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_QueryRadius(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float arg2 ;
+  float arg3 ;
+  float arg4 ;
+  unsigned int arg5 ;
+  int result;
+  
+  SWIG_check_num_args("QueryRadius",5,5)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("QueryRadius",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("QueryRadius",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("QueryRadius",2,"float");
+  if(!lua_isnumber(L,3)) SWIG_fail_arg("QueryRadius",3,"float");
+  if(!lua_isnumber(L,4)) SWIG_fail_arg("QueryRadius",4,"float");
+  if(!lua_isnumber(L,5)) SWIG_fail_arg("QueryRadius",5,"unsigned int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_QueryRadius",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (float)lua_tonumber(L, 2);
+  arg3 = (float)lua_tonumber(L, 3);
+  arg4 = (float)lua_tonumber(L, 4);
+  SWIG_contract_assert((lua_tonumber(L,5)>=0),"number must not be negative")
+  arg5 = (unsigned int)lua_tonumber(L, 5);
+  result = (int)(arg1)->QueryRadius(arg2,arg3,arg4,arg5);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_Raycast(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  float arg2 ;
+  float arg3 ;
+  float arg4 ;
+  float arg5 ;
+  unsigned int arg6 ;
+  int result;
+  
+  SWIG_check_num_args("Raycast",6,6)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("Raycast",1,"Toolset2dManager *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("Raycast",1,"Toolset2dManager *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("Raycast",2,"float");
+  if(!lua_isnumber(L,3)) SWIG_fail_arg("Raycast",3,"float");
+  if(!lua_isnumber(L,4)) SWIG_fail_arg("Raycast",4,"float");
+  if(!lua_isnumber(L,5)) SWIG_fail_arg("Raycast",5,"float");
+  if(!lua_isnumber(L,6)) SWIG_fail_arg("Raycast",6,"unsigned int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_Raycast",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (float)lua_tonumber(L, 2);
+  arg3 = (float)lua_tonumber(L, 3);
+  arg4 = (float)lua_tonumber(L, 4);
+  arg5 = (float)lua_tonumber(L, 5);
+  SWIG_contract_assert((lua_tonumber(L,6)>=0),"number must not be negative")
+  arg6 = (unsigned int)lua_tonumber(L, 6);
+  result = (int)(arg1)->Raycast(arg2,arg3,arg4,arg5,arg6);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetNumQueryResults(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int result;
+  
+  SWIG_check_num_args("GetNumQueryResults",1,1)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetNumQueryResults",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetNumQueryResults",1,"Toolset2dManager const *");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetNumQueryResults",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  result = (int)((Toolset2dManager const *)arg1)->GetNumQueryResults();
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetQueryResult(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  Sprite *result = 0 ;
+  
+  SWIG_check_num_args("GetQueryResult",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetQueryResult",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetQueryResult",1,"Toolset2dManager const *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("GetQueryResult",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetQueryResult",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  result = (Sprite *)((Toolset2dManager const *)arg1)->GetQueryResult(arg2);
+  SWIG_NewPointerObj(L,result,SWIGTYPE_p_Sprite,0); SWIG_arg++; 
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
+static int _wrap_Toolset2dManager_GetQueryDistance(lua_State* L) {
+  int SWIG_arg = 0;
+  Toolset2dManager *arg1 = (Toolset2dManager *) 0 ;
+  int arg2 ;
+  float result;
+  
+  SWIG_check_num_args("GetQueryDistance",2,2)
+  if(lua_isnil(L, 1)) SWIG_fail_arg("GetQueryDistance",1,"Toolset2dManager const *");
+  if(!SWIG_isptrtype(L,1)) SWIG_fail_arg("GetQueryDistance",1,"Toolset2dManager const *");
+  if(!lua_isnumber(L,2)) SWIG_fail_arg("GetQueryDistance",2,"int");
+  
+  if (!SWIG_IsOK(SWIG_ConvertPtr(L,1,(void**)&arg1,SWIGTYPE_p_Toolset2dManager,0))){
+    SWIG_fail_ptr("Toolset2dManager_GetQueryDistance",1,SWIGTYPE_p_Toolset2dManager);
+  }
+  
+  arg2 = (int)lua_tonumber(L, 2);
+  result = (float)((Toolset2dManager const *)arg1)->GetQueryDistance(arg2);
+  lua_pushnumber(L, (lua_Number) result); SWIG_arg++;
+  return SWIG_arg;
+  
+  if(0) SWIG_fail;
+  
+fail:
+  lua_error(L);
+  return SWIG_arg;
+}
+
+
 static int _wrap_Toolset2dManager_Cast(lua_State* L) {
   int SWIG_arg = 0;
   unsigned long *arg1 = (unsigned long *) 0 ;
@@ -11401,8 +13265,60 @@ delete arg1;
 static swig_lua_method swig_Toolset2dManager_methods[] = {
     {"GetNumSprites", _wrap_Toolset2dManager_GetNumSprites}, 
     {"CreateSprite", _wrap_Toolset2dManager_CreateSprite}, 
+    {"AcquireSprite", _wrap_Toolset2dManager_AcquireSprite}, 
     {"SetCamera", _wrap_Toolset2dManager_SetCamera}, 
     {"GetCamera", _wrap_Toolset2dManager_GetCamera}, 
+    {"SetCollisionCellSize", _wrap_Toolset2dManager_SetCollisionCellSize}, 
+    {"GetCollisionCellSize", _wrap_Toolset2dManager_GetCollisionCellSize}, 
+    {"GetNumRenderBatches", _wrap_Toolset2dManager_GetNumRenderBatches}, 
+    {"GetNumRenderQuads", _wrap_Toolset2dManager_GetNumRenderQuads}, 
+    {"GetNumRenderVertices", _wrap_Toolset2dManager_GetNumRenderVertices}, 
+    {"SetTextureAtlasEnabled", _wrap_Toolset2dManager_SetTextureAtlasEnabled}, 
+    {"IsTextureAtlasEnabled", _wrap_Toolset2dManager_IsTextureAtlasEnabled}, 
+    {"SetTextureAtlasPageSize", _wrap_Toolset2dManager_SetTextureAtlasPageSize}, 
+    {"GetTextureAtlasPageSize", _wrap_Toolset2dManager_GetTextureAtlasPageSize}, 
+    {"SetTextureAtlasPadding", _wrap_Toolset2dManager_SetTextureAtlasPadding}, 
+    {"GetTextureAtlasPadding", _wrap_Toolset2dManager_GetTextureAtlasPadding}, 
+    {"SetUpdateThreadCount", _wrap_Toolset2dManager_SetUpdateThreadCount}, 
+    {"GetUpdateThreadCount", _wrap_Toolset2dManager_GetUpdateThreadCount}, 
+    {"SetCollisionStayEventEnabled", _wrap_Toolset2dManager_SetCollisionStayEventEnabled}, 
+    {"IsCollisionStayEventEnabled", _wrap_Toolset2dManager_IsCollisionStayEventEnabled}, 
+    {"SetCollisionEventBatchingEnabled", _wrap_Toolset2dManager_SetCollisionEventBatchingEnabled}, 
+    {"IsCollisionEventBatchingEnabled", _wrap_Toolset2dManager_IsCollisionEventBatchingEnabled}, 
+    {"GetCollisionContact", _wrap_Toolset2dManager_GetCollisionContact}, 
+    {"GetCollisionContactState", _wrap_Toolset2dManager_GetCollisionContactState}, 
+    {"ReleaseSprite", _wrap_Toolset2dManager_ReleaseSprite}, 
+    {"PrewarmSpritePool", _wrap_Toolset2dManager_PrewarmSpritePool}, 
+    {"GetSpritePoolHits", _wrap_Toolset2dManager_GetSpritePoolHits}, 
+    {"GetSpritePoolMisses", _wrap_Toolset2dManager_GetSpritePoolMisses}, 
+    {"GetSpritePoolHighWater", _wrap_Toolset2dManager_GetSpritePoolHighWater}, 
+    {"GetNumPooledSprites", _wrap_Toolset2dManager_GetNumPooledSprites}, 
+    {"EvictUnusedSpriteData", _wrap_Toolset2dManager_EvictUnusedSpriteData}, 
+    {"GetNumSpriteSheets", _wrap_Toolset2dManager_GetNumSpriteSheets}, 
+    {"SetAsyncLoadingEnabled", _wrap_Toolset2dManager_SetAsyncLoadingEnabled}, 
+    {"IsAsyncLoadingEnabled", _wrap_Toolset2dManager_IsAsyncLoadingEnabled}, 
+    {"PreloadSpriteSheet", _wrap_Toolset2dManager_PreloadSpriteSheet}, 
+    {"IsSpriteSheetLoaded", _wrap_Toolset2dManager_IsSpriteSheetLoaded}, 
+    {"GetNumPendingSpriteSheets", _wrap_Toolset2dManager_GetNumPendingSpriteSheets}, 
+    {"LoadSpriteSheetManifest", _wrap_Toolset2dManager_LoadSpriteSheetManifest}, 
+    {"GetSpriteSheetLoadProgress", _wrap_Toolset2dManager_GetSpriteSheetLoadProgress}, 
+    {"GetTimeToFirstFrame", _wrap_Toolset2dManager_GetTimeToFirstFrame}, 
+    {"SetStatsHistorySize", _wrap_Toolset2dManager_SetStatsHistorySize}, 
+    {"GetStatsHistorySize", _wrap_Toolset2dManager_GetStatsHistorySize}, 
+    {"SetStatsOverlayEnabled", _wrap_Toolset2dManager_SetStatsOverlayEnabled}, 
+    {"IsStatsOverlayEnabled", _wrap_Toolset2dManager_IsStatsOverlayEnabled}, 
+    {"StartStatsCsv", _wrap_Toolset2dManager_StartStatsCsv}, 
+    {"StopStatsCsv", _wrap_Toolset2dManager_StopStatsCsv}, 
+    {"IsWritingStatsCsv", _wrap_Toolset2dManager_IsWritingStatsCsv}, 
+    { "GetStats",Toolset2dManager_GetStats},
+    {"GetCollisionContactTime", _wrap_Toolset2dManager_GetCollisionContactTime}, 
+    {"QueryPoint", _wrap_Toolset2dManager_QueryPoint}, 
+    {"QueryRect", _wrap_Toolset2dManager_QueryRect}, 
+    {"QueryRadius", _wrap_Toolset2dManager_QueryRadius}, 
+    {"Raycast", _wrap_Toolset2dManager_Raycast}, 
+    {"GetNumQueryResults", _wrap_Toolset2dManager_GetNumQueryResults}, 
+    {"GetQueryResult", _wrap_Toolset2dManager_GetQueryResult}, 
+    {"GetQueryDistance", _wrap_Toolset2dManager_GetQueryDistance}, 
     {0,0}
 };
 static swig_lua_attribute swig_Toolset2dManager_attributes[] = {
@@ -13,11 +13,117 @@ public:
 	int GetNumSprites();
 	Sprite *CreateSprite(const hkvVec3 &position, const char *spriteSheetFilename, const char *xmlDataFilename = "");
 
+	Sprite *AcquireSprite(const hkvVec3 &position, const char *spriteSheetFilename, const char *xmlDataFilename = "");
+	void ReleaseSprite(Sprite *sprite);
+	void PrewarmSpritePool(const char *spriteSheetFilename, const char *xmlDataFilename, int count);
+
+	int GetSpritePoolHits() const;
+	int GetSpritePoolMisses() const;
+	int GetSpritePoolHighWater() const;
+	int GetNumPooledSprites() const;
+
+	int EvictUnusedSpriteData();
+	int GetNumSpriteSheets() const;
+
+	void SetAsyncLoadingEnabled(bool enabled);
+	bool IsAsyncLoadingEnabled() const;
+	bool PreloadSpriteSheet(const char *spriteSheetFilename, const char *xmlDataFilename);
+	bool IsSpriteSheetLoaded(const char *spriteSheetFilename, const char *xmlDataFilename);
+	int GetNumPendingSpriteSheets() const;
+
+	int LoadSpriteSheetManifest(const char *manifestFilename);
+	float GetSpriteSheetLoadProgress() const;
+	float GetTimeToFirstFrame() const;
+
 	void SetCamera(Camera2D *camera);
 	Camera2D *GetCamera();
 
+	void SetCollisionCellSize(float cellSize);
+	float GetCollisionCellSize() const;
+
+	void SetTextureAtlasEnabled(bool enabled);
+	bool IsTextureAtlasEnabled() const;
+	void SetTextureAtlasPageSize(int pageSize);
+	int GetTextureAtlasPageSize() const;
+	void SetTextureAtlasPadding(int padding);
+	int GetTextureAtlasPadding() const;
+
+	void SetCollisionStayEventEnabled(bool enabled);
+	bool IsCollisionStayEventEnabled() const;
+	void SetCollisionEventBatchingEnabled(bool enabled);
+	bool IsCollisionEventBatchingEnabled() const;
+	Sprite *GetCollisionContact(int index) const;
+	const char *GetCollisionContactState(int index) const;
+	float GetCollisionContactTime(int index) const;
+
+	int QueryPoint(float x, float y, unsigned int layerMask);
+	int QueryRect(float minX, float minY, float maxX, float maxY, unsigned int layerMask);
+	int QueryRadius(float x, float y, float radius, unsigned int layerMask);
+	int Raycast(float startX, float startY, float endX, float endY, unsigned int layerMask);
+	int GetNumQueryResults() const;
+	Sprite *GetQueryResult(int index) const;
+	float GetQueryDistance(int index) const;
+
+	void SetUpdateThreadCount(int threadCount);
+	int GetUpdateThreadCount() const;
+
+	int GetNumRenderBatches() const;
+	int GetNumRenderQuads() const;
+	int GetNumRenderVertices() const;
+
+	void SetStatsHistorySize(int numFrames);
+	int GetStatsHistorySize() const;
+	void SetStatsOverlayEnabled(bool enabled);
+	bool IsStatsOverlayEnabled() const;
+	bool StartStatsCsv(const char *filename);
+	void StopStatsCsv();
+	bool IsWritingStatsCsv() const;
+
 	%extend
 	{
 		VSWIG_CREATE_CAST_UNSAFE(Toolset2dManager)
+
+		// Returns a table with the number of frames and the average of every timer and counter,
+		// plus the maximum of each timer as '<name>Max'
+		%native(GetStats) int Toolset2dManager_GetStats(lua_State *L);
+		%{
+			SWIGINTERN int Toolset2dManager_GetStats(lua_State *L)
+			{
+				SWIG_CONVERT_POINTER(L, 1, Toolset2dManager, pManager)
+
+				const FrameStats2D &stats = pManager->GetStats();
+
+				lua_newtable(L);
+
+				lua_pushstring(L, "frames");
+				lua_pushnumber(L, (lua_Number)stats.GetNumFrames());
+				lua_settable(L, -3);
+
+				for (int timer = 0; timer < NUM_FRAME_TIMERS; timer++)
+				{
+					const FrameTimer2D frameTimer = (FrameTimer2D)timer;
+					const std::string maxName = std::string(FrameStats2D::GetTimerName(frameTimer)) + "Max";
+
+					lua_pushstring(L, FrameStats2D::GetTimerName(frameTimer));
+					lua_pushnumber(L, (lua_Number)stats.GetAverageTime(frameTimer));
+					lua_settable(L, -3);
+
+					lua_pushstring(L, maxName.c_str());
+					lua_pushnumber(L, (lua_Number)stats.GetMaxTime(frameTimer));
+					lua_settable(L, -3);
+				}
+
+				for (int counter = 0; counter < NUM_FRAME_COUNTERS; counter++)
+				{
+					const FrameCounter2D frameCounter = (FrameCounter2D)counter;
+
+					lua_pushstring(L, FrameStats2D::GetCounterName(frameCounter));
+					lua_pushnumber(L, (lua_Number)stats.GetAverageCount(frameCounter));
+					lua_settable(L, -3);
+				}
+
+				return 1;
+			}
+		%}
 	}
 };
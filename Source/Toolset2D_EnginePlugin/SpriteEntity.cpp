@@ -9,17 +9,19 @@
 
 #include "SpriteEntity.hpp"
 #include "Toolset2dManager.hpp"
+#include "Core/SpriteQuads2d.hpp"
+#include "Core/Collision2d.hpp"
 
 #include <Vision/Runtime/EnginePlugins/EnginePluginsImport.hpp>
+#include <Vision/Runtime/EnginePlugins/VisionEnginePlugin/Scripting/VScriptIncludes.hpp>
 #include <Vision/Runtime/Base/ThirdParty/tinyXML/tinyxml.h>
 
 #if USE_HAVOK_PHYSICS_2D
 #include <Vision/Runtime/EnginePlugins/Havok/HavokPhysicsEnginePlugin/vHavokPhysicsModule.hpp>
-#include <Physics2012/Collide/Query/Collector/BodyPairCollector/hkpAllCdBodyPairCollector.h>
 #include <Physics/Constraint/Data/PointToPlane/hkpPointToPlaneConstraintData.h>
 #endif // USE_HAVOK_PHYSICS_2D
 
-#define CURRENT_SPRITE_VERSION 3
+#define CURRENT_SPRITE_VERSION 6
 
 V_IMPLEMENT_SERIAL(Sprite, VisBaseEntity_cl, 0, &gToolset2D_EngineModule);
 
@@ -29,10 +31,26 @@ const float kGlobalPhysicsScaleInv = 1.0f / kGlobalPhysicsScale;
 
 Sprite::Sprite()
 {
+	m_positionChanged = true;
+	m_broadphaseProxy = -1;
+	m_registryIndex = -1;
+	m_spritePool = -1;
+	m_inSpritePool = false;
+	m_spriteData = NULL;
+	m_pendingSpriteData = NULL;
+	m_centerWhenLoaded = false;
+	m_hasSweepPosition = false;
+	m_sweep.setZero();
+	m_sweeping = false;
+	m_rotationDegrees = 0.0f;
+	m_cosRotation = 1.0f;
+	m_sinRotation = 0.0f;
+	m_animation = Toolset2dManager::Instance()->GetSpriteAnimations().CreateAnimation(this);
 }
 
 Sprite::~Sprite()
 {
+	Toolset2dManager::Instance()->GetSpriteAnimations().DestroyAnimation(m_animation);
 }
 
 // Called by the engine when entity is created. Not when it is de-serialized!
@@ -55,6 +73,9 @@ void Sprite::DeInitFunction()
 // called by our InitFunction and our de-serialization code
 void Sprite::CommonInit()
 {
+	// The manager advances the animation, there is nothing left to think about
+	SetThinkFunctionStatus(FALSE);
+
 	Toolset2dManager::Instance()->AddSprite(this);
 
 	SetSpriteSheetData(m_spriteSheetFilename, m_xmlDataFilename);
@@ -62,10 +83,20 @@ void Sprite::CommonInit()
 
 void Sprite::CommonDeInit()
 { 
+	Toolset2dManager::Instance()->RemoveFromSpritePool(this);
 	Toolset2dManager::Instance()->RemoveSprite(this);
 
 	RemoveShapes();
 
+	if (m_spriteData != NULL)
+	{
+		Toolset2dManager::Instance()->ReleaseSpriteData(m_spriteData);
+	}
+	if (m_pendingSpriteData != NULL)
+	{
+		Toolset2dManager::Instance()->ReleaseSpriteData(m_pendingSpriteData);
+	}
+
 	Clear();
 }
 
@@ -79,20 +110,26 @@ void Sprite::Clear()
 	m_fullscreen = false;
 
 	m_currentState = -1;
-	m_currentFrame = -1;
-	m_frameTime = 0.f;
-	m_paused = false;
 	m_playOnce = false;
 	m_collide = true;
-	m_scrollOffset.setZero();
 	m_convexHullCollision = false;
+	m_pixelCollision = false;
+	m_continuousCollision = false;
+	m_collisionLayer = 1;
+	m_collisionMask = 0xFFFFFFFF;
 	m_simulate = false;
 	m_fixed = false;
 
 	m_spriteData = NULL;
+	m_pendingSpriteData = NULL;
+	m_centerWhenLoaded = false;
 
 	m_spriteSheetFilename = NULL;
 	m_xmlDataFilename = NULL;
+
+	m_pausedScripts.clear();
+
+	Toolset2dManager::Instance()->GetSpriteAnimations().Reset(m_animation);
 }
 
 void Sprite::RemoveShapes()
@@ -120,15 +157,99 @@ void Sprite::RemoveShapes()
 
 void Sprite::UpdateSpriteData()
 {
-	const SpriteData *spriteData = Toolset2dManager::Instance()->GetSpriteData(m_spriteSheetFilename, m_xmlDataFilename);
-	if (spriteData != m_spriteData)
+	Toolset2dManager *manager = Toolset2dManager::Instance();
+
+	const SpriteData *spriteData = manager->IsAsyncLoadingEnabled() ?
+		manager->RequestSpriteData(m_spriteSheetFilename, m_xmlDataFilename) :
+		manager->GetSpriteData(m_spriteSheetFilename, m_xmlDataFilename);
+
+	const SpriteData *currentSpriteData = (m_pendingSpriteData != NULL) ? m_pendingSpriteData : m_spriteData;
+	if (spriteData != currentSpriteData)
 	{
-		m_spriteData = spriteData;
-		if (m_spriteData != NULL)
+		if (spriteData != NULL)
 		{
-			m_currentState = m_currentFrame = (m_spriteData->states.GetSize() > 0) ? 0 : -1;
-			CreateShapeData();
+			manager->AddSpriteDataReference(spriteData);
 		}
+		if (currentSpriteData != NULL)
+		{
+			manager->ReleaseSpriteData(currentSpriteData);
+		}
+
+		m_pendingSpriteData = NULL;
+		m_centerWhenLoaded = false;
+
+		// Data that is still loading can't be looked at yet, the sprite behaves as if it had
+		// none until SyncSpriteData picks it up
+		if (spriteData != NULL && !spriteData->IsLoaded())
+		{
+			m_pendingSpriteData = spriteData;
+			m_spriteData = NULL;
+			SetCurrentState(-1);
+			RemoveShapes();
+		}
+		else
+		{
+			SetSpriteData(spriteData);
+		}
+	}
+}
+
+void Sprite::SetSpriteData(const SpriteData *spriteData)
+{
+	m_spriteData = spriteData;
+	if (m_spriteData != NULL)
+	{
+		SetCurrentState( (m_spriteData->states.GetSize() > 0) ? 0 : -1 );
+		CreateShapeData();
+	}
+}
+
+void Sprite::SetCurrentState(int state)
+{
+	m_currentState = state;
+
+	// Starts the new state from its first frame
+	SpriteAnimations2D &animations = Toolset2dManager::Instance()->GetSpriteAnimations();
+	if (m_spriteData != NULL && m_currentState >= 0)
+	{
+		const AnimationTimeline2D timeline = m_spriteData->states[m_currentState].GetTimeline();
+		animations.SetTimeline(m_animation, &timeline);
+	}
+	else
+	{
+		animations.SetTimeline(m_animation, NULL);
+	}
+}
+
+void Sprite::SyncSpriteData()
+{
+	if (m_pendingSpriteData == NULL || m_pendingSpriteData->loadState == SPRITE_DATA_LOADING)
+	{
+		return;
+	}
+
+	// The reference moves over to the published data, or is dropped if loading failed
+	const SpriteData *spriteData = m_pendingSpriteData;
+	m_pendingSpriteData = NULL;
+
+	const bool center = m_centerWhenLoaded;
+	m_centerWhenLoaded = false;
+
+	if (spriteData->IsLoaded())
+	{
+		SetSpriteData(spriteData);
+
+		// The size wasn't known when the sprite was centered
+		if (center)
+		{
+			const hkvVec3 position = GetPosition();
+			const hkvVec2 dimensions = GetDimensions();
+			SetPosition(position.x - dimensions.x / 2.f, position.y - dimensions.y / 2.f, position.z);
+		}
+	}
+	else
+	{
+		Toolset2dManager::Instance()->ReleaseSpriteData(spriteData);
 	}
 }
 
@@ -136,6 +257,12 @@ void Sprite::CreateShapeData()
 {
 	RemoveShapes();
 
+	// Shapes are created once the sprite has its data
+	if (m_spriteData == NULL)
+	{
+		return;
+	}
+
 #if USE_HAVOK_PHYSICS_2D
 	hkpWorld *world = Toolset2dManager::Instance()->GetPhysicsWorld();
 	world->markForWrite();
@@ -231,6 +358,11 @@ const hkvVec2 *Sprite::GetVertices() const
 	return m_vertices;
 }
 
+const std::vector<Vertex2D> &Sprite::GetHullVertices() const
+{
+	return m_hullVertices;
+}
+
 hkvAlignedBBox Sprite::GetBBox() const
 {
 	// add a depth to the bounding box even though it's 2D in case we want to put it
@@ -239,7 +371,7 @@ hkvAlignedBBox Sprite::GetBBox() const
 
 	hkvAlignedBBox bbox;
 	bbox.m_vMin.set(FLT_MAX, FLT_MAX, -depth);
-	bbox.m_vMax.set(FLT_MIN, FLT_MIN, depth);
+	bbox.m_vMax.set(-FLT_MAX, -FLT_MAX, depth);
 
 	for (int vertexIndex = 0; vertexIndex < 4; vertexIndex++)
 	{
@@ -252,13 +384,44 @@ hkvAlignedBBox Sprite::GetBBox() const
 	return bbox;
 }
 
+void Sprite::UpdateSweep()
+{
+	const hkvVec2 position = GetPosition().getAsVec2();
+
+	m_sweep.setZero();
+	if (m_hasSweepPosition)
+	{
+		m_sweep = position - m_sweepPosition;
+	}
+	m_sweepPosition = position;
+	m_hasSweepPosition = true;
+
+	m_sweeping = false;
+	if (m_continuousCollision)
+	{
+		const hkvAlignedBBox bbox = GetBBox();
+		m_sweeping = ( hkvMath::Abs(m_sweep.x) * 2.0f > bbox.m_vMax.x - bbox.m_vMin.x ||
+					   hkvMath::Abs(m_sweep.y) * 2.0f > bbox.m_vMax.y - bbox.m_vMin.y );
+	}
+}
+
+bool Sprite::IsSweeping() const
+{
+	return m_sweeping;
+}
+
+const hkvVec2 &Sprite::GetSweep() const
+{
+	return m_sweep;
+}
+
 bool Sprite::SetSpriteSheetData(const char *spriteSheetFilename, const char *xmlFilename)
 {
 	bool success = false;
 
 	if (m_spriteSheetFilename == spriteSheetFilename &&
 		m_xmlDataFilename == xmlFilename &&
-		m_spriteData != NULL)
+		(m_spriteData != NULL || m_pendingSpriteData != NULL))
 	{
 		success = true;
 	}
@@ -272,6 +435,16 @@ bool Sprite::SetSpriteSheetData(const char *spriteSheetFilename, const char *xml
 	return success;
 }
 
+const char *Sprite::GetSpriteSheetFilename() const
+{
+	return m_spriteSheetFilename;
+}
+
+const char *Sprite::GetXmlDataFilename() const
+{
+	return m_xmlDataFilename;
+}
+
 const VArray<VString> Sprite::GetStateNames() const
 {
 	VArray<VString> names;
@@ -299,18 +472,16 @@ const SpriteState *Sprite::GetCurrentState() const
 
 int Sprite::GetCurrentFrame() const
 {
-	return m_currentFrame;
+	return Toolset2dManager::Instance()->GetSpriteAnimations().GetFrame(m_animation);
 }
 
 void Sprite::SetCurrentFrame(int currentFrame)
 {
 	if (m_spriteData != NULL && m_currentState >= 0)
 	{
-		m_paused = true;
-
-		const SpriteState *s = &m_spriteData->states[m_currentState];
-		const int numCells = s->cells.GetSize();		
-		m_currentFrame = hkvMath::clamp(currentFrame, 0, numCells - 1);
+		SpriteAnimations2D &animations = Toolset2dManager::Instance()->GetSpriteAnimations();
+		animations.SetPlaying(m_animation, false);
+		animations.SetFrame(m_animation, currentFrame);
 	}
 }
 
@@ -334,114 +505,84 @@ float Sprite::GetOriginalCellHeight() const
 	return ( GetCurrentCell() ? GetCurrentCell()->originalHeight : 0.f );
 }
 
-void Sprite::ThinkFunction()
+void Sprite::OnAnimationEnd(int numLoops)
 {
-	if (m_spriteData != NULL && m_currentState >= 0 && !m_paused)
+	if (m_inSpritePool)
 	{
-		const float dt = Vision::GetTimer()->GetTimeDifference();
-
-		m_frameTime += dt;
-		m_scrollOffset += m_scrollSpeed * dt;
-
-		if (!hkvMath::isFloatEqual(m_scrollSpeed.x, 0.0f))
-		{
-			if (m_scrollSpeed.x > 0 && m_scrollOffset.x > 1.0f)
-			{
-				m_scrollOffset.x -= 1.0f;
-			}
-			else if (m_scrollSpeed.x < 0 && m_scrollOffset.x < 0.0f)
-			{
-				m_scrollOffset.x += 1.0f;
-			}
-		}
-
-		if (!hkvMath::isFloatEqual(m_scrollSpeed.y, 0.0f))
-		{
-			if (m_scrollSpeed.y > 0 && m_scrollOffset.y > 1.0f)
-			{
-				m_scrollOffset.y -= 1.0f;
-			}
-			else if (m_scrollSpeed.y < 0 && m_scrollOffset.y < 0.0f)
-			{
-				m_scrollOffset.y += 1.0f;
-			}
-		}
+		return;
+	}
 
-		const SpriteState *state = &m_spriteData->states[m_currentState];
-		const float inverseFramerate = 1.0f / state->framerate;
-		if (m_frameTime >= inverseFramerate)
-		{
-			const int numCells = state->cells.GetSize();
-			const int lastFrame = m_currentFrame;
+	// Once per completed loop, unless the script switches to another state
+	const int currentState = m_currentState;
+	for (int loop = 0; loop < numLoops && m_currentState == currentState; loop++)
+	{
+		this->TriggerScriptEvent("OnSpriteStateEnd");
+	}
+}
 
-			m_currentFrame = (lastFrame + 1) % numCells;
-			m_frameTime -= dt;
+bool Sprite::SetState(const char *state)
+{
+	return SetStateById( GetStateId(state) );
+}
 
-			if (m_currentFrame < lastFrame)
-			{
-				this->TriggerScriptEvent("OnSpriteStateEnd");
-				if (m_playOnce)
-				{
-					m_currentFrame = numCells - 1;
-					Pause();
-				}
-			}
-		}
+bool Sprite::SetStateById(int stateId)
+{
+	if (m_spriteData == NULL || stateId < 0 || stateId >= m_spriteData->states.GetSize())
+	{
+		return false;
+	}
 
-#if USE_HAVOK_PHYSICS_2D
-		const SpriteCell *cell = GetCurrentCell();
-		if (cell->index < m_shapes.GetSize())
-		{
-			hkpConvexTransformShape *shape = m_shapes[cell->index];
-			shape->setTransform(GetTransform());
-		}
-#endif // USE_HAVOK_PHYSICS_2D
+	if (stateId != m_currentState)
+	{
+		SetCurrentState(stateId);
 	}
+	return true;
 }
 
-bool Sprite::SetState(const char *state)
+int Sprite::GetStateId(const char *state) const
 {
-	int index = -1;
-	if (m_spriteData != NULL)
+	int stateId = -1;
+	if (m_spriteData != NULL && state != NULL)
 	{
-		index = m_spriteData->stateNameToIndex.Find(state);
-		if (index != -1)
-		{
-			m_currentState = index;
-			m_currentFrame = 0;
-			m_frameTime = 0.f;
-		}
-
+		stateId = m_spriteData->stateNameToIndex.Find(state);
 	}
-	return (index != -1);
+	return stateId;
+}
+
+int Sprite::GetCurrentStateId() const
+{
+	return m_currentState;
 }
 
 void Sprite::SetFramePercent(float percent)
 {
 	if (m_spriteData != NULL && m_currentState >= 0)
 	{
-		m_paused = true;
-
 		const SpriteState *s = &m_spriteData->states[m_currentState];
 		const int numCells = s->cells.GetSize();		
-		m_currentFrame = static_cast<int>( hkvMath::clamp(percent, 0.f, 1.f) * static_cast<float>(numCells - 1) );
+
+		SpriteAnimations2D &animations = Toolset2dManager::Instance()->GetSpriteAnimations();
+		animations.SetPlaying(m_animation, false);
+		animations.SetFrame(m_animation, static_cast<int>( hkvMath::clamp(percent, 0.f, 1.f) * static_cast<float>(numCells - 1) ));
 	}
 }
 
 void Sprite::Play()
 {
-	m_paused = false;
+	Toolset2dManager::Instance()->GetSpriteAnimations().SetPlaying(m_animation, true);
 }
 
 void Sprite::Pause()
 {
-	m_frameTime = 0.f;
-	m_paused = true;
+	SpriteAnimations2D &animations = Toolset2dManager::Instance()->GetSpriteAnimations();
+	animations.SetFrameTime(m_animation, 0.f);
+	animations.SetPlaying(m_animation, false);
 }
 
 void Sprite::SetScrollSpeed(hkvVec2 scrollSpeed)
 {
 	m_scrollSpeed = scrollSpeed;
+	Toolset2dManager::Instance()->GetSpriteAnimations().SetScrollSpeed(m_animation, scrollSpeed.x, scrollSpeed.y);
 }
 
 const hkvVec2 &Sprite::GetScrollSpeed() const
@@ -462,6 +603,7 @@ bool Sprite::IsFullscreenMode() const
 void Sprite::SetPlayOnce(bool enabled)
 {
 	m_playOnce = enabled;
+	Toolset2dManager::Instance()->GetSpriteAnimations().SetPlayOnce(m_animation, enabled);
 }
 
 bool Sprite::IsPlayOnce() const
@@ -489,6 +631,51 @@ bool Sprite::IsConvexHullCollision() const
 	return m_convexHullCollision;
 }
 
+void Sprite::SetPixelCollision(bool enabled)
+{
+	m_pixelCollision = enabled;
+}
+
+bool Sprite::IsPixelCollision() const
+{
+	return m_pixelCollision;
+}
+
+void Sprite::SetContinuousCollision(bool enabled)
+{
+	m_continuousCollision = enabled;
+}
+
+bool Sprite::IsContinuousCollision() const
+{
+	return m_continuousCollision;
+}
+
+void Sprite::SetCollisionLayer(unsigned int layer)
+{
+	m_collisionLayer = layer;
+}
+
+unsigned int Sprite::GetCollisionLayer() const
+{
+	return m_collisionLayer;
+}
+
+void Sprite::SetCollisionMask(unsigned int mask)
+{
+	m_collisionMask = mask;
+}
+
+unsigned int Sprite::GetCollisionMask() const
+{
+	return m_collisionMask;
+}
+
+bool Sprite::ShouldCollide(const Sprite *other) const
+{
+	return SpatialHash2D::ShouldCollide(m_collisionLayer, m_collisionMask, other->m_collisionLayer, other->m_collisionMask);
+}
+
 void Sprite::SetSimulate(bool simulate, bool fixed)
 {
 	if (simulate != m_simulate || m_fixed != fixed)
@@ -511,6 +698,9 @@ bool Sprite::IsFixed() const
 
 void Sprite::SetCenterPosition(const hkvVec3 &position)
 {
+	// Without its data the sprite has no size yet, it is moved once it has been loaded
+	m_centerWhenLoaded = (m_pendingSpriteData != NULL);
+
 	const hkvVec2 dimensions = GetDimensions();
 	SetPosition(position.x - dimensions.x / 2.f, position.y - dimensions.y / 2.f, position.z);
 }
@@ -557,7 +747,7 @@ hkvVec2 Sprite::GetDimensions() const
 	if (m_currentState != -1)
 	{
 		const SpriteState *spriteState = &m_spriteData->states[m_currentState];
-		const SpriteCell *cell = &m_spriteData->cells[spriteState->cells[m_currentFrame]];
+		const SpriteCell *cell = &m_spriteData->cells[spriteState->cells[GetCurrentFrame()]];
 		width = static_cast<float>(cell->originalWidth);
 		height = static_cast<float>(cell->originalHeight);
 	}
@@ -578,6 +768,10 @@ Sprite *Sprite::Clone(const hkvVec3 *position) const
 
 	sprite->SetObjectKey( GetObjectKey() );
 	sprite->SetCollision( IsColliding() );
+	sprite->SetCollisionLayer( GetCollisionLayer() );
+	sprite->SetCollisionMask( GetCollisionMask() );
+	sprite->SetPixelCollision( IsPixelCollision() );
+	sprite->SetContinuousCollision( IsContinuousCollision() );
 	sprite->SetPlayOnce( IsPlayOnce() );
 	sprite->SetFullscreenMode( IsFullscreenMode() );
 	sprite->SetWidth( GetWidth() );
@@ -586,12 +780,119 @@ Sprite *Sprite::Clone(const hkvVec3 *position) const
 	return sprite;
 }
 
+void Sprite::ResetToDefaults()
+{
+	// Get rid of any rigid bodies first since they depend on the flags below
+	SetSimulate(false, false);
+
+	m_offscreen = false;
+
+	m_scrollSpeed.setZero();
+	m_fullscreen = false;
+	m_playOnce = false;
+
+	Toolset2dManager::Instance()->GetSpriteAnimations().Reset(m_animation);
+	SetCurrentState( (m_spriteData != NULL && m_spriteData->states.GetSize() > 0) ? 0 : -1 );
+
+	m_collide = true;
+	m_convexHullCollision = false;
+	m_pixelCollision = false;
+	m_continuousCollision = false;
+	m_collisionLayer = 1;
+	m_collisionMask = 0xFFFFFFFF;
+
+	// Pooled sprites are put somewhere else before they show up again
+	m_hasSweepPosition = false;
+	m_sweep.setZero();
+	m_sweeping = false;
+
+	SetObjectKey(NULL);
+	SetVisibleBitmask(VIS_ENTITY_VISIBLE);
+	SetScaling( hkvVec3(1.0f, 1.0f, 1.0f) );
+	SetOrientation(0.0f, 0.0f, 0.0f);
+
+	m_positionChanged = true;
+}
+
+int Sprite::GetBroadphaseProxy() const
+{
+	return m_broadphaseProxy;
+}
+
+void Sprite::SetBroadphaseProxy(int proxy)
+{
+	m_broadphaseProxy = proxy;
+}
+
+int Sprite::GetRegistryIndex() const
+{
+	return m_registryIndex;
+}
+
+void Sprite::SetRegistryIndex(int index)
+{
+	m_registryIndex = index;
+}
+
+int Sprite::GetAnimation() const
+{
+	return m_animation;
+}
+
+int Sprite::GetSpritePool() const
+{
+	return m_spritePool;
+}
+
+bool Sprite::IsInSpritePool() const
+{
+	return m_inSpritePool;
+}
+
+void Sprite::SetSpritePool(int pool, bool inPool)
+{
+	m_spritePool = pool;
+	m_inSpritePool = inPool;
+}
+
+void Sprite::PauseScripts()
+{
+	m_pausedScripts.clear();
+	for (int componentIndex = 0; componentIndex < Components().Count(); componentIndex++)
+	{
+		IVObjectComponent *component = Components().GetPtrs()[componentIndex];
+		if (component->IsOfType(VScriptComponent::GetClassTypeId()))
+		{
+			VScriptComponent *script = static_cast<VScriptComponent *>(component);
+			if (script->GetThinkFunctionStatus())
+			{
+				script->SetThinkFunctionStatus(FALSE);
+				m_pausedScripts.push_back(component);
+			}
+		}
+	}
+}
+
+void Sprite::ResumeScripts()
+{
+	// Scripts removed from the sprite while it was pooled stay as they are
+	for (size_t scriptIndex = 0; scriptIndex < m_pausedScripts.size(); scriptIndex++)
+	{
+		IVObjectComponent *component = m_pausedScripts[scriptIndex];
+		if (component->GetOwner() == this)
+		{
+			static_cast<VScriptComponent *>(component)->SetThinkFunctionStatus(TRUE);
+		}
+	}
+	m_pausedScripts.clear();
+}
+
 const SpriteCell *Sprite::GetCurrentCell() const
 {
 	const SpriteCell *cell = NULL;
 	if (m_spriteData)
 	{
-		cell = &m_spriteData->cells[m_spriteData->states[m_currentState].cells[m_currentFrame]];
+		cell = &m_spriteData->cells[m_spriteData->states[m_currentState].cells[GetCurrentFrame()]];
 	}
 	return cell;
 }
@@ -603,7 +904,7 @@ hkvVec3 Sprite::GetPoint(float x, float y, float z) const
 	if (m_currentState != -1)
 	{
 		const SpriteState *spriteState = &m_spriteData->states[m_currentState];
-		const SpriteCell *cell = &m_spriteData->cells[spriteState->cells[m_currentFrame]];
+		const SpriteCell *cell = &m_spriteData->cells[spriteState->cells[GetCurrentFrame()]];
 		const float width = static_cast<float>(cell->originalWidth);
 		const float height = static_cast<float>(cell->originalHeight);
 
@@ -628,6 +929,23 @@ hkvVec3 Sprite::GetPoint(float x, float y, float z) const
 	return point.getAsVec3(z);
 }
 
+void Sprite::OnObject3DChanged(int iO3DFlags)
+{
+	VisBaseEntity_cl::OnObject3DChanged(iO3DFlags);
+
+	if (iO3DFlags & VIS_OBJECT3D_POSCHANGED)
+	{
+		m_positionChanged = true;
+	}
+}
+
+bool Sprite::ConsumePositionChanged()
+{
+	const bool changed = m_positionChanged;
+	m_positionChanged = false;
+	return changed;
+}
+
 void Sprite::OnVariableValueChanged(VisVariable_cl *pVar, const char *value)
 {
 	if ( !strcmp(pVar->name, "TextureFilename") )
@@ -679,24 +997,49 @@ VTextureObject *Sprite::GetTexture() const
 		{
 			texture = m_spriteData->textureAnimation->GetCurrentFrame();
 		}
+		else if (UsesTextureAtlas())
+		{
+			texture = m_spriteData->atlasTexture;
+		}
 	}
 	return texture;
 }
 
+bool Sprite::UsesTextureAtlas() const
+{
+	// Texture coordinates that wrap around only work with the original texture
+	return ( m_spriteData != NULL &&
+			 m_spriteData->atlasTexture != NULL &&
+			 m_currentState != -1 &&
+			 !IsFullscreenMode() &&
+			 m_scrollSpeed.isZero() &&
+			 Toolset2dManager::Instance()->GetSpriteAnimations().GetScrollOffsetX(m_animation) == 0.f &&
+			 Toolset2dManager::Instance()->GetSpriteAnimations().GetScrollOffsetY(m_animation) == 0.f );
+}
+
 void Sprite::Update(const hkvAlignedBBox *viewportBoundingBox)
 {
-	if (m_spriteData == NULL)
+	SyncPhysics();
+
+	SpriteQuad2D quad;
+	if (BuildQuad(quad))
 	{
-		return;
+		float cornersX[QUAD_NUM_CORNERS];
+		float cornersY[QUAD_NUM_CORNERS];
+		SpriteQuads2D::ComputeCorners(quad, cornersX, cornersY);
+		SetCorners(cornersX, cornersY, viewportBoundingBox);
 	}
+}
 
-	const VTextureObject *texture = GetTexture();
-
-	float width = static_cast<float>(m_spriteData->sourceWidth);
-	float height = static_cast<float>(m_spriteData->sourceHeight);
-
+void Sprite::SyncPhysics()
+{
 #if USE_HAVOK_PHYSICS_2D
 	const SpriteCell *cell = GetCurrentCell();
+	if (cell != NULL && cell->index < m_shapes.GetSize())
+	{
+		m_shapes[cell->index]->setTransform(GetTransform());
+	}
+
 	if (Toolset2dManager::Instance()->InSimulationMode() && m_simulate && cell != NULL)
 	{
 		if (cell->index < m_rigidBodies.GetSize())
@@ -713,132 +1056,142 @@ void Sprite::Update(const hkvAlignedBBox *viewportBoundingBox)
 			physicsRotation.setFromQuaternion(q);
 
 			m_vPosition = physicsPosition.getAsVec3(0.f);
+			m_positionChanged = true;
 			physicsRotation.getAsEulerAngles(m_vOrientation.x, m_vOrientation.y, m_vOrientation.z);
 		}
 	}
 #endif // USE_HAVOK_PHYSICS_2D
+}
 
-	hkvVec2 worldPosition = GetPosition().getAsVec2();
+bool Sprite::BuildQuad(SpriteQuad2D &quad)
+{
+	if (m_spriteData == NULL)
+	{
+		return false;
+	}
 
-	hkvMat3 rotation;
-	rotation.setRotationMatrixZ(m_vOrientation.z);
+	float width = static_cast<float>(m_spriteData->sourceWidth);
+	float height = static_cast<float>(m_spriteData->sourceHeight);
+	const hkvVec2 worldPosition = GetPosition().getAsVec2();
+
+	// Default to an unrotated quad the size of the whole sheet at the origin
+	quad.positionX = 0.0f;
+	quad.positionY = 0.0f;
+	quad.centerX = 0.0f;
+	quad.centerY = 0.0f;
+	quad.offsetX = 0.0f;
+	quad.offsetY = 0.0f;
+	quad.width = width;
+	quad.height = height;
+	quad.scaleX = 1.0f;
+	quad.scaleY = 1.0f;
+	quad.cosRotation = 1.0f;
+	quad.sinRotation = 0.0f;
 
-	hkvVec2 topLeft;
-	hkvVec2 bottomRight;
 	hkvVec2 uvTopLeft(0, 0);
 	hkvVec2 uvBottomRight(1, 1);
 
+	m_hullVertices.clear();
+
 	if (m_currentState != -1)
 	{
 		const SpriteState *spriteState = &m_spriteData->states[m_currentState];
-		const SpriteCell *cell = &m_spriteData->cells[spriteState->cells[m_currentFrame]];
+		const SpriteCell *cell = &m_spriteData->cells[spriteState->cells[GetCurrentFrame()]];
 
 		float w = (float)cell->width / width;
 		float h = (float)cell->height / height;
 		float x = cell->offset.x / width;
 		float y = cell->offset.y / height;
 
-		uvTopLeft.x = x + m_scrollOffset.x;
-		uvTopLeft.y = y + m_scrollOffset.y;
+		const SpriteAnimations2D &animations = Toolset2dManager::Instance()->GetSpriteAnimations();
+		uvTopLeft.x = x + animations.GetScrollOffsetX(m_animation);
+		uvTopLeft.y = y + animations.GetScrollOffsetY(m_animation);
 		uvBottomRight.x = uvTopLeft.x + w;
 		uvBottomRight.y = uvTopLeft.y + h;
 
 		if (IsFullscreenMode())
 		{
-			topLeft.x = 0;
-			topLeft.y = 0;
+			int x, y, w, h;
+			Vision::Contexts.GetMainRenderContext()->GetViewport(x, y, w, h);
 
+			// Stretch it out to make sure it fits the screen
+			if (w - width > h - height)
+			{
+				quad.width = static_cast<float>(w);
+				quad.height = static_cast<float>(w * height) / width;
+			}
+			else
 			{
-				int x, y, w, h;
-				Vision::Contexts.GetMainRenderContext()->GetViewport(x, y, w, h);
-
-				// Stretch it out to make sure it fits the screen
-				if (w - width > h - height)
-				{
-					bottomRight.x = static_cast<float>(w);
-					bottomRight.y = static_cast<float>(w * height) / width;
-				}
-				else
-				{
-					bottomRight.y = static_cast<float>(h);
-					bottomRight.x = static_cast<float>(width * h) / height;
-				}
+				quad.height = static_cast<float>(h);
+				quad.width = static_cast<float>(width * h) / height;
 			}
 
 			uvTopLeft.x += worldPosition.x / width;
 			uvBottomRight.x += worldPosition.x / width;
 			uvTopLeft.y += worldPosition.y / height;
 			uvBottomRight.y += worldPosition.y / height;
-
-			m_vertices[VERTEX_TOP_LEFT] = topLeft;
-			m_vertices[VERTEX_TOP_RIGHT] = hkvVec2(bottomRight.x, topLeft.y);
-			m_vertices[VERTEX_BOTTOM_LEFT] = hkvVec2(topLeft.x, bottomRight.y);
-			m_vertices[VERTEX_BOTTOM_RIGHT] = bottomRight;
 		}
 		else
 		{
-			topLeft = cell->pivot;
-			bottomRight.x = topLeft.x + cell->width;
-			bottomRight.y = topLeft.y + cell->height;
-
-			const float ww = bottomRight.x - topLeft.x;
-			const float hh = bottomRight.y - topLeft.y;
-			hkvVec2 offset(cell->originalWidth / 2.0f, cell->originalHeight / 2.0f);
-
-			// offset it so that we rotate around the center of the shape
-			topLeft -= offset;
-			bottomRight -= offset;
-
-			hkvVec2 topRight = topLeft;
-			topRight.x += ww;
-
-			hkvVec2 bottomLeft = bottomRight;
-			bottomLeft.x -= ww;
-
 			const hkvVec2 &scale = GetScaling().getAsVec2();
 
-			// apply rotation and score on all corners
-			topLeft = (rotation * topLeft.compMul(scale).getAsVec3(0.0f)).getAsVec2();
-			bottomRight = (rotation * bottomRight.compMul(scale).getAsVec3(0.0f)).getAsVec2();
-			topRight = (rotation * topRight.compMul(scale).getAsVec3(0.0f)).getAsVec2();
-			bottomLeft = (rotation * bottomLeft.compMul(scale).getAsVec3(0.0f)).getAsVec2();
-						
-			// offset it back to the corner and final position
-			topLeft += worldPosition + offset;
-			bottomRight += worldPosition + offset;
-			topRight += worldPosition + offset;
-			bottomLeft += worldPosition + offset;
-
-			// save off the final position
-			m_vertices[VERTEX_TOP_LEFT] = topLeft;
-			m_vertices[VERTEX_TOP_RIGHT] = topRight;
-			m_vertices[VERTEX_BOTTOM_LEFT] = bottomLeft;
-			m_vertices[VERTEX_BOTTOM_RIGHT] = bottomRight;
+			// We rotate around the center of the original (untrimmed) cell
+			quad.positionX = worldPosition.x;
+			quad.positionY = worldPosition.y;
+			quad.centerX = cell->originalWidth / 2.0f;
+			quad.centerY = cell->originalHeight / 2.0f;
+			quad.offsetX = cell->pivot.x - quad.centerX;
+			quad.offsetY = cell->pivot.y - quad.centerY;
+			quad.width = static_cast<float>(cell->width);
+			quad.height = static_cast<float>(cell->height);
+			quad.scaleX = scale.x;
+			quad.scaleY = scale.y;
+			if (m_vOrientation.z != m_rotationDegrees)
+			{
+				m_rotationDegrees = m_vOrientation.z;
+				m_cosRotation = hkvMath::cosDeg(m_rotationDegrees);
+				m_sinRotation = hkvMath::sinDeg(m_rotationDegrees);
+			}
+			quad.cosRotation = m_cosRotation;
+			quad.sinRotation = m_sinRotation;
+
+			if (m_convexHullCollision && cell->hullVertices.size() >= 3)
+			{
+				m_hullVertices.resize(cell->hullVertices.size());
+				PlaceHull2D(quad, &cell->hullVertices[0], static_cast<int>(cell->hullVertices.size()), &m_hullVertices[0]);
+			}
 		}
 	}
-	else
-	{
-		bottomRight.x = topLeft.x + width;
-		bottomRight.y = topLeft.y + height;
 
-		m_vertices[VERTEX_TOP_LEFT] = topLeft;
-		m_vertices[VERTEX_TOP_RIGHT] = hkvVec2(bottomRight.x, topLeft.y);
-		m_vertices[VERTEX_BOTTOM_LEFT] = hkvVec2(topLeft.x, bottomRight.y);
-		m_vertices[VERTEX_BOTTOM_RIGHT] = bottomRight;
+	if (UsesTextureAtlas())
+	{
+		uvTopLeft = m_spriteData->atlasUvOffset + uvTopLeft.compMul(m_spriteData->atlasUvScale);
+		uvBottomRight = m_spriteData->atlasUvOffset + uvBottomRight.compMul(m_spriteData->atlasUvScale);
 	}
 
+	quad.u0 = uvTopLeft.x;
+	quad.v0 = uvTopLeft.y;
+	quad.u1 = uvBottomRight.x;
+	quad.v1 = uvBottomRight.y;
+
+	m_collisionQuad = quad;
+
 	m_texCoords[VERTEX_TOP_LEFT] = uvTopLeft;
 	m_texCoords[VERTEX_TOP_RIGHT] = hkvVec2(uvBottomRight.x, uvTopLeft.y);
 	m_texCoords[VERTEX_BOTTOM_LEFT] = hkvVec2(uvTopLeft.x, uvBottomRight.y);
 	m_texCoords[VERTEX_BOTTOM_RIGHT] = uvBottomRight;
 
-	// Setup the render vertices
-	m_renderVertices[0].Set(m_vertices[VERTEX_TOP_LEFT].x, m_vertices[VERTEX_TOP_LEFT].y, m_texCoords[VERTEX_TOP_LEFT].x, m_texCoords[VERTEX_TOP_LEFT].y);
-	m_renderVertices[1].Set(m_vertices[VERTEX_BOTTOM_LEFT].x, m_vertices[VERTEX_BOTTOM_LEFT].y, m_texCoords[VERTEX_BOTTOM_LEFT].x, m_texCoords[VERTEX_BOTTOM_LEFT].y);
-	m_renderVertices[2].Set(m_vertices[VERTEX_TOP_RIGHT].x, m_vertices[VERTEX_TOP_RIGHT].y, m_texCoords[VERTEX_TOP_RIGHT].x, m_texCoords[VERTEX_TOP_RIGHT].y);
-	m_renderVertices[3].Set(m_vertices[VERTEX_TOP_RIGHT].x, m_vertices[VERTEX_TOP_RIGHT].y, m_texCoords[VERTEX_TOP_RIGHT].x, m_texCoords[VERTEX_TOP_RIGHT].y);
-	m_renderVertices[4].Set(m_vertices[VERTEX_BOTTOM_LEFT].x, m_vertices[VERTEX_BOTTOM_LEFT].y, m_texCoords[VERTEX_BOTTOM_LEFT].x, m_texCoords[VERTEX_BOTTOM_LEFT].y);
-	m_renderVertices[5].Set(m_vertices[VERTEX_BOTTOM_RIGHT].x, m_vertices[VERTEX_BOTTOM_RIGHT].y, m_texCoords[VERTEX_BOTTOM_RIGHT].x, m_texCoords[VERTEX_BOTTOM_RIGHT].y);
+	return true;
+}
+
+void Sprite::SetCorners(const float *cornersX, const float *cornersY, const hkvAlignedBBox *viewportBoundingBox)
+{
+	V_COMPILE_ASSERT(VERTEX_NUM_VERTS == QUAD_NUM_CORNERS);
+
+	for (int vertexIndex = 0; vertexIndex < VERTEX_NUM_VERTS; vertexIndex++)
+	{
+		m_vertices[vertexIndex].set(cornersX[vertexIndex], cornersY[vertexIndex]);
+	}
 
 	if ( viewportBoundingBox )
 	{
@@ -848,15 +1201,60 @@ void Sprite::Update(const hkvAlignedBBox *viewportBoundingBox)
 
 void Sprite::Render(IVRender2DInterface *pRender, VSimpleRenderState_t& state)
 {
-	if ( m_spriteData != NULL && (GetVisibleBitmask() & VIS_ENTITY_VISIBLE) && !m_offscreen )
+	if ( IsRenderable() )
+	{
+		Overlay2DVertex_t vertices[6];
+		vertices[0].Set(m_vertices[VERTEX_TOP_LEFT].x, m_vertices[VERTEX_TOP_LEFT].y, m_texCoords[VERTEX_TOP_LEFT].x, m_texCoords[VERTEX_TOP_LEFT].y);
+		vertices[1].Set(m_vertices[VERTEX_BOTTOM_LEFT].x, m_vertices[VERTEX_BOTTOM_LEFT].y, m_texCoords[VERTEX_BOTTOM_LEFT].x, m_texCoords[VERTEX_BOTTOM_LEFT].y);
+		vertices[2].Set(m_vertices[VERTEX_TOP_RIGHT].x, m_vertices[VERTEX_TOP_RIGHT].y, m_texCoords[VERTEX_TOP_RIGHT].x, m_texCoords[VERTEX_TOP_RIGHT].y);
+		vertices[3].Set(m_vertices[VERTEX_TOP_RIGHT].x, m_vertices[VERTEX_TOP_RIGHT].y, m_texCoords[VERTEX_TOP_RIGHT].x, m_texCoords[VERTEX_TOP_RIGHT].y);
+		vertices[4].Set(m_vertices[VERTEX_BOTTOM_LEFT].x, m_vertices[VERTEX_BOTTOM_LEFT].y, m_texCoords[VERTEX_BOTTOM_LEFT].x, m_texCoords[VERTEX_BOTTOM_LEFT].y);
+		vertices[5].Set(m_vertices[VERTEX_BOTTOM_RIGHT].x, m_vertices[VERTEX_BOTTOM_RIGHT].y, m_texCoords[VERTEX_BOTTOM_RIGHT].x, m_texCoords[VERTEX_BOTTOM_RIGHT].y);
+
+		pRender->Draw2DBuffer(6, vertices, GetTexture(), state);
+	}
+}
+
+bool Sprite::IsRenderable() const
+{
+	return ( m_spriteData != NULL && (GetVisibleBitmask() & VIS_ENTITY_VISIBLE) && !m_offscreen );
+}
+
+bool Sprite::IsOffscreen() const
+{
+	return m_offscreen;
+}
+
+void Sprite::OnCollision(Sprite *other, float contactTime)
+{
+	if (!m_inSpritePool)
+	{
+		this->TriggerScriptEvent("OnSpriteCollision", "*of", other, contactTime);
+	}
+}
+
+void Sprite::OnCollisionStay(Sprite *other)
+{
+	if (!m_inSpritePool)
+	{
+		this->TriggerScriptEvent("OnSpriteCollisionStay", "*o", other);
+	}
+}
+
+void Sprite::OnCollisionEnd(Sprite *other)
+{
+	if (!m_inSpritePool)
 	{
-		pRender->Draw2DBuffer(6, m_renderVertices, GetTexture(), state);
+		this->TriggerScriptEvent("OnSpriteCollisionEnd", "*o", other);
 	}
 }
 
-void Sprite::OnCollision(Sprite *other)
+void Sprite::OnCollisions(int numContacts)
 {
-	this->TriggerScriptEvent("OnSpriteCollision", "*o", other);
+	if (!m_inSpritePool)
+	{
+		this->TriggerScriptEvent("OnSpriteCollisions", "*i", numContacts);
+	}
 }
 
 #if USE_HAVOK_PHYSICS_2D
@@ -894,92 +1292,125 @@ hkvVec2 Sprite::TransformVertex(const hkVector4 &vertex) const
 
 bool Sprite::IsOverlapping(Sprite *other) const
 {
-	bool inside = false;
+	return IsShapeOverlapping(other) && IsPixelOverlapping(other);
+}
 
-#if USE_HAVOK_PHYSICS_2D
-	const hkpConvexTransformShape *shapeA = GetShape();
-	const hkpConvexTransformShape *shapeB = other->GetShape();
-#else
-	const void *shapeA = NULL;
-	const void *shapeB = NULL;
-#endif // USE_HAVOK_PHYSICS_2D
+bool Sprite::IsOverlappingSwept(Sprite *other, float &contactTime) const
+{
+	contactTime = 1.0f;
 
-	// if both sprites don't use convex hull collision, then default to simple AABB collision
-	if ( shapeA == NULL || shapeB == NULL ||
-		 (!IsConvexHullCollision() && !other->IsConvexHullCollision()) )
+	if (!m_sweeping && !other->IsSweeping())
 	{
-		const hkvVec2 *otherVertices = other->GetVertices();
+		return IsOverlapping(other);
+	}
 
-		int edges[8] = {0, 1,
-						1, 3,
-						3, 2,
-						2, 0};
+	Vertex2D quad[VERTEX_NUM_VERTS];
+	Vertex2D otherQuad[VERTEX_NUM_VERTS];
+	const Vertex2D *vertices;
+	const Vertex2D *otherVertices;
+	const int numVertices = GetCollisionPolygon(quad, vertices);
+	const int otherNumVertices = other->GetCollisionPolygon(otherQuad, otherVertices);
 
-		// Loop through each vertex and see if any of them are inside all
-		// of the edges
-		for (int vertexIndex = 0; vertexIndex < 4; vertexIndex++)
-		{
-			bool insideEdges = true;
+	float timeOfImpact;
+	if ( !SweepConvexPolygons2D(vertices, numVertices, m_sweep.x, m_sweep.y,
+			otherVertices, otherNumVertices, other->GetSweep().x, other->GetSweep().y, timeOfImpact) )
+	{
+		return false;
+	}
 
-			// Test each edge
-			for (int edgeIndex = 0; edgeIndex < 4; edgeIndex++)
-			{
-				int p1 = edges[edgeIndex * 2 + 0];
-				int p2 = edges[edgeIndex * 2 + 1];
-
-				const hkvVec3 e = (m_vertices[p2] - m_vertices[p1]).getNormalized().getAsVec3(0.f);
-				const hkvVec3 l = (otherVertices[vertexIndex] - m_vertices[p1]).getNormalized().getAsVec3(0.f);
-				const hkvVec3 up = e.cross(l);
-
-				if (up.z < 0)
-				{
-					insideEdges = false;
-					break;
-				}
-			}
+	// Sprites that end up overlapping still have to pass the pixel test, the sweep itself
+	// only knows about the hulls and quads
+	if ( ConvexPolygonsOverlap2D(vertices, numVertices, otherVertices, otherNumVertices) &&
+		 !IsPixelOverlapping(other) )
+	{
+		return false;
+	}
 
-			if (insideEdges)
-			{
-				inside = true;
-				break;
-			}
+	contactTime = timeOfImpact;
+	return true;
+}
+
+bool Sprite::IsShapeOverlapping(const Sprite *other) const
+{
+	// Unless one of the sprites collides with its hull, test the oriented quads
+	if ( m_hullVertices.empty() && other->GetHullVertices().empty() )
+	{
+		const hkvVec2 *otherVertices = other->GetVertices();
+
+		float cornersX[VERTEX_NUM_VERTS];
+		float cornersY[VERTEX_NUM_VERTS];
+		float otherCornersX[VERTEX_NUM_VERTS];
+		float otherCornersY[VERTEX_NUM_VERTS];
+		for (int vertexIndex = 0; vertexIndex < VERTEX_NUM_VERTS; vertexIndex++)
+		{
+			cornersX[vertexIndex] = m_vertices[vertexIndex].x;
+			cornersY[vertexIndex] = m_vertices[vertexIndex].y;
+			otherCornersX[vertexIndex] = otherVertices[vertexIndex].x;
+			otherCornersY[vertexIndex] = otherVertices[vertexIndex].y;
 		}
+
+		return QuadsOverlap2D(cornersX, cornersY, otherCornersX, otherCornersY);
 	}
-#if USE_HAVOK_PHYSICS_2D
-	else
+
+	Vertex2D quad[VERTEX_NUM_VERTS];
+	Vertex2D otherQuad[VERTEX_NUM_VERTS];
+	const Vertex2D *vertices;
+	const Vertex2D *otherVertices;
+	const int numVertices = GetCollisionPolygon(quad, vertices);
+	const int otherNumVertices = other->GetCollisionPolygon(otherQuad, otherVertices);
+
+	return ConvexPolygonsOverlap2D(vertices, numVertices, otherVertices, otherNumVertices);
+}
+
+bool Sprite::IsPixelOverlapping(const Sprite *other) const
+{
+	// A sprite without a mask counts as solid within its quad
+	const AlphaMask2D *pixelMask = GetPixelMask();
+	const AlphaMask2D *otherPixelMask = other->GetPixelMask();
+	if (pixelMask == NULL && otherPixelMask == NULL)
 	{
-		vHavokPhysicsModule* physicsModule = vHavokPhysicsModule::GetInstance();
+		return true;
+	}
 
-		if (physicsModule != HK_NULL &&
-			shapeA != NULL &&
-			shapeB != NULL)
-		{
-			const hkReal collisionTolerance = 0.01;
+	// Resampling isn't exactly symmetric, so always walk the pair in the same order
+	std::vector<unsigned long long> &scratch = Toolset2dManager::Instance()->GetAlphaMaskScratch();
+	if (GetUniqueID() > other->GetUniqueID())
+	{
+		return AlphaMasksOverlap2D(otherPixelMask, other->m_collisionQuad, pixelMask, m_collisionQuad, scratch);
+	}
+	return AlphaMasksOverlap2D(pixelMask, m_collisionQuad, otherPixelMask, other->m_collisionQuad, scratch);
+}
 
-			hkpWorld* physicsWorld = physicsModule->GetPhysicsWorld();
-			hkpAllCdBodyPairCollector collector;
+int Sprite::GetCollisionPolygon(Vertex2D *quad, const Vertex2D *&vertices) const
+{
+	if (!m_hullVertices.empty())
+	{
+		vertices = &m_hullVertices[0];
+		return static_cast<int>(m_hullVertices.size());
+	}
 
-			physicsWorld->markForRead();
-			{
-				hkpCollisionDispatcher *dispatcher = physicsWorld->getCollisionDispatcher();
-				dispatcher->getPenetrations(
-					shapeA,
-					hkTransform::getIdentity(),
-					shapeB,
-					hkTransform::getIdentity(),
-					collisionTolerance, collector);
-			}
-			physicsWorld->unmarkForRead();
+	// A sprite without a hull takes part with its quad, walked around its edges
+	static const int kQuadOutline[VERTEX_NUM_VERTS] = { VERTEX_TOP_LEFT, VERTEX_TOP_RIGHT, VERTEX_BOTTOM_RIGHT, VERTEX_BOTTOM_LEFT };
 
-			if (collector.getHits().getSize() > 0)
-			{
-				inside = true;
-			}
-		}
+	for (int vertexIndex = 0; vertexIndex < VERTEX_NUM_VERTS; vertexIndex++)
+	{
+		quad[vertexIndex].x = m_vertices[kQuadOutline[vertexIndex]].x;
+		quad[vertexIndex].y = m_vertices[kQuadOutline[vertexIndex]].y;
 	}
-#endif // USE_HAVOK_PHYSICS_2D
 
-	return inside;
+	vertices = quad;
+	return VERTEX_NUM_VERTS;
+}
+
+const AlphaMask2D *Sprite::GetPixelMask() const
+{
+	if (!m_pixelCollision || m_spriteData == NULL || m_currentState == -1 || IsFullscreenMode())
+	{
+		return NULL;
+	}
+
+	const SpriteCell *cell = GetCurrentCell();
+	return cell->alphaMask.IsEmpty() ? NULL : &cell->alphaMask;
 }
 
 void Sprite::Serialize(VArchive &ar)
@@ -1002,14 +1433,36 @@ void Sprite::Serialize(VArchive &ar)
 		ar.ReadStringBinary(xmlFilenameBuffer, FS_MAX_PATH);
 		m_xmlDataFilename = xmlFilenameBuffer;
 
-		ar >> m_scrollSpeed.x;
-		ar >> m_scrollSpeed.y;
+		hkvVec2 scrollSpeed;
+		ar >> scrollSpeed.x;
+		ar >> scrollSpeed.y;
+		SetScrollSpeed(scrollSpeed);
+
+		bool playOnce;
 		ar >> m_fullscreen;
-		ar >> m_playOnce;
+		ar >> playOnce;
+		SetPlayOnce(playOnce);
+
 		ar >> m_collide;
 		ar >> m_convexHullCollision;
 		ar >> m_simulate;
 		ar >> m_fixed;
+
+		if (spriteVersion >= 4)
+		{
+			ar >> m_collisionLayer;
+			ar >> m_collisionMask;
+		}
+
+		if (spriteVersion >= 5)
+		{
+			ar >> m_pixelCollision;
+		}
+
+		if (spriteVersion >= 6)
+		{
+			ar >> m_continuousCollision;
+		}
 	} 
 	else
 	{
@@ -1026,6 +1479,10 @@ void Sprite::Serialize(VArchive &ar)
 		ar << m_convexHullCollision;
 		ar << m_simulate;
 		ar << m_fixed;
+		ar << m_collisionLayer;
+		ar << m_collisionMask;
+		ar << m_pixelCollision;
+		ar << m_continuousCollision;
 	}
 }
 
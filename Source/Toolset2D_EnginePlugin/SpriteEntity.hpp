@@ -1,9 +1,13 @@
 #ifndef SPRITE_ENTITY_HPP_INCLUDED
 #define SPRITE_ENTITY_HPP_INCLUDED
 
+#include "Core/Collision2d.hpp"
+#include "Core/AlphaMask2d.hpp"
+
 class SpriteState;
 class SpriteCell;
 class SpriteData;
+struct SpriteQuad2D;
 
 class Sprite : public VisBaseEntity_cl
 {
@@ -27,9 +31,9 @@ public:
 	// Overridden entity functions
 	TOOLSET_2D_IMPEXP VOVERRIDE void InitFunction();
 	TOOLSET_2D_IMPEXP VOVERRIDE void DeInitFunction();
-	TOOLSET_2D_IMPEXP VOVERRIDE void ThinkFunction();
-  
+
 	TOOLSET_2D_IMPEXP VOVERRIDE void OnVariableValueChanged(VisVariable_cl *pVar, const char * value);
+	TOOLSET_2D_IMPEXP VOVERRIDE void OnObject3DChanged(int iO3DFlags);
 
 	// Serialization and type management
 	TOOLSET_2D_IMPEXP VOVERRIDE void Serialize( VArchive &ar );
@@ -40,7 +44,15 @@ public:
 
 	TOOLSET_2D_IMPEXP void Render(IVRender2DInterface *pRender, VSimpleRenderState_t& state);
 
+	// The manager uses these to batch sprites that share a texture into a single draw call
+	TOOLSET_2D_IMPEXP bool IsRenderable() const;
+	TOOLSET_2D_IMPEXP bool IsOffscreen() const;
+	TOOLSET_2D_IMPEXP VTextureObject *GetTexture() const;
+	TOOLSET_2D_IMPEXP bool UsesTextureAtlas() const;
+
 	TOOLSET_2D_IMPEXP bool SetSpriteSheetData(const char *spriteSheetFilename, const char *xmlFilename);
+	TOOLSET_2D_IMPEXP const char *GetSpriteSheetFilename() const;
+	TOOLSET_2D_IMPEXP const char *GetXmlDataFilename() const;
 
 	TOOLSET_2D_IMPEXP const VArray<VString> GetStateNames() const;
 	TOOLSET_2D_IMPEXP const SpriteState *GetCurrentState() const;
@@ -54,20 +66,68 @@ public:
 	TOOLSET_2D_IMPEXP float GetOriginalCellWidth() const;
 	TOOLSET_2D_IMPEXP float GetOriginalCellHeight() const;
 
+	// Gives the same answer either way around, so each pair only needs to be tested once
 	TOOLSET_2D_IMPEXP bool IsOverlapping(Sprite *other) const;
 
+	// Same as IsOverlapping where the sprites are now, unless either one is sweeping. Then
+	// the hulls or quads are also tested along the way from where the sprites were on the
+	// last frame, and 'contactTime' is the fraction of that move at which they first
+	// touched. It is one for sprites that are only tested where they are.
+	TOOLSET_2D_IMPEXP bool IsOverlappingSwept(Sprite *other, float &contactTime) const;
+
 	TOOLSET_2D_IMPEXP void Update(const hkvAlignedBBox *viewportBoundingBox = NULL);
 
+	// Update() split up so that the manager can compute the corners of all sprites in one
+	// batch. Only SyncPhysics has to run on the main thread, the rest only touches the sprite
+	// itself. BuildQuad returns false if there is nothing to place yet.
+	TOOLSET_2D_IMPEXP void SyncPhysics();
+
+	// Picks up sprite data that has finished loading in the background, main thread only
+	TOOLSET_2D_IMPEXP void SyncSpriteData();
+	TOOLSET_2D_IMPEXP bool BuildQuad(SpriteQuad2D &quad);
+	TOOLSET_2D_IMPEXP void SetCorners(const float *cornersX, const float *cornersY, const hkvAlignedBBox *viewportBoundingBox);
+
 	TOOLSET_2D_IMPEXP const hkvVec2 *GetVertices() const;
+
+	// Collision hull of the current cell placed like the quad, empty unless convex hull
+	// collision is enabled and the cell has a hull
+	TOOLSET_2D_IMPEXP const std::vector<Vertex2D> &GetHullVertices() const;
+
+	// Placed hull, or the outline of the quad written to 'quad', returns the vertex count
+	TOOLSET_2D_IMPEXP int GetCollisionPolygon(Vertex2D *quad, const Vertex2D *&vertices) const;
 	TOOLSET_2D_IMPEXP hkvAlignedBBox GetBBox() const;
 
+	// Takes the move since the last call, once the sprite is in place for the frame. The
+	// sprite is sweeping if it has continuous collision and moved further than half its
+	// size, anything slower can't pass through another sprite unnoticed.
+	TOOLSET_2D_IMPEXP void UpdateSweep();
+	TOOLSET_2D_IMPEXP bool IsSweeping() const;
+	TOOLSET_2D_IMPEXP const hkvVec2 &GetSweep() const;
+
 	TOOLSET_2D_IMPEXP const SpriteCell *GetCurrentCell() const;
 	
 	//----- Utility functions exposed to LUA
 
-	TOOLSET_2D_IMPEXP void OnCollision(Sprite *other);
+	// 'contactTime' as reported by IsOverlappingSwept
+	TOOLSET_2D_IMPEXP void OnCollision(Sprite *other, float contactTime);
+	TOOLSET_2D_IMPEXP void OnCollisionStay(Sprite *other);
+	TOOLSET_2D_IMPEXP void OnCollisionEnd(Sprite *other);
+
+	// Sent instead of the above when the manager batches collision events, the contacts
+	// are read back through the manager
+	TOOLSET_2D_IMPEXP void OnCollisions(int numContacts);
 
+	// Sent by the manager once the current state's animation completed one or more loops
+	TOOLSET_2D_IMPEXP void OnAnimationEnd(int numLoops);
+
+	// Switching to the state the sprite is already in does nothing, the animation keeps
+	// going. State IDs are indices into the sprite sheet's states, so they are only valid
+	// for sprites that use the same sheet and -1 until the sheet has been loaded. Looking
+	// the ID up once and using SetStateById skips the name lookup every frame.
 	TOOLSET_2D_IMPEXP bool SetState(const char *state);
+	TOOLSET_2D_IMPEXP bool SetStateById(int stateId);
+	TOOLSET_2D_IMPEXP int GetStateId(const char *state) const;
+	TOOLSET_2D_IMPEXP int GetCurrentStateId() const;
 
 	// Specify a value between 0 and 1 and it will update the frame
 	TOOLSET_2D_IMPEXP void SetFramePercent(float percent);
@@ -90,6 +150,24 @@ public:
 	TOOLSET_2D_IMPEXP void SetConvexHullCollision(bool enabled);
 	TOOLSET_2D_IMPEXP bool IsConvexHullCollision() const;
 
+	// Once the hulls or quads of two sprites overlap, sprites with pixel collision only
+	// collide where the opaque pixels of their cells do. Needs cells with an alpha mask
+	// baked into the sheet, the others keep colliding with their hull or quad.
+	TOOLSET_2D_IMPEXP void SetPixelCollision(bool enabled);
+	TOOLSET_2D_IMPEXP bool IsPixelCollision() const;
+
+	// Fast sprites can jump past another sprite from one frame to the next. With continuous
+	// collision they are swept from their last position to the current one, see UpdateSweep.
+	TOOLSET_2D_IMPEXP void SetContinuousCollision(bool enabled);
+	TOOLSET_2D_IMPEXP bool IsContinuousCollision() const;
+
+	// Sprites only collide if each one's layer bits are set in the other one's mask
+	TOOLSET_2D_IMPEXP void SetCollisionLayer(unsigned int layer);
+	TOOLSET_2D_IMPEXP unsigned int GetCollisionLayer() const;
+	TOOLSET_2D_IMPEXP void SetCollisionMask(unsigned int mask);
+	TOOLSET_2D_IMPEXP unsigned int GetCollisionMask() const;
+	TOOLSET_2D_IMPEXP bool ShouldCollide(const Sprite *other) const;
+
 	TOOLSET_2D_IMPEXP void SetSimulate(bool simulate, bool fixed);
 	TOOLSET_2D_IMPEXP bool IsSimulated() const;
 	TOOLSET_2D_IMPEXP bool IsFixed() const;
@@ -114,6 +192,36 @@ public:
 
 	TOOLSET_2D_IMPEXP Sprite *Clone(const hkvVec3 *position = NULL) const;
 
+	// Puts a sprite that is handed out again by the manager's sprite pool back into the
+	// state of a newly created one. Sheet data and position are kept.
+	TOOLSET_2D_IMPEXP void ResetToDefaults();
+
+	// Returns true once after the position has been changed so the manager can check
+	// whether it needs to re-sort by Z
+	TOOLSET_2D_IMPEXP bool ConsumePositionChanged();
+
+	// Handle into the manager's collision broadphase, -1 if not registered
+	TOOLSET_2D_IMPEXP int GetBroadphaseProxy() const;
+	TOOLSET_2D_IMPEXP void SetBroadphaseProxy(int proxy);
+
+	// Slot in the manager's sprite list, -1 if not registered
+	TOOLSET_2D_IMPEXP int GetRegistryIndex() const;
+	TOOLSET_2D_IMPEXP void SetRegistryIndex(int index);
+
+	// Handle of the sprite's animation in the manager
+	TOOLSET_2D_IMPEXP int GetAnimation() const;
+
+	// Manager pool the sprite belongs to, -1 if none. Sprites waiting in their pool are
+	// neither updated nor rendered.
+	TOOLSET_2D_IMPEXP int GetSpritePool() const;
+	TOOLSET_2D_IMPEXP bool IsInSpritePool() const;
+	TOOLSET_2D_IMPEXP void SetSpritePool(int pool, bool inPool);
+
+	// Stops the think function of the sprite's script components while it waits in its pool,
+	// ResumeScripts turns it back on for the ones that had it on before
+	TOOLSET_2D_IMPEXP void PauseScripts();
+	TOOLSET_2D_IMPEXP void ResumeScripts();
+
 protected:
 	void CommonInit();
 	void CommonDeInit();
@@ -122,26 +230,47 @@ protected:
 	void RemoveShapes();
 
 	void UpdateSpriteData();
+	void SetSpriteData(const SpriteData *spriteData);
+	void SetCurrentState(int state);
 	void CreateShapeData();
 
-	VTextureObject *GetTexture() const;
-
 	hkvVec2 GetDimensions() const;
 
+	// Hulls, or quads of the sprites without one
+	bool IsShapeOverlapping(const Sprite *other) const;
+	bool IsPixelOverlapping(const Sprite *other) const;
+
+	// Alpha mask of the current cell if it takes part in pixel collision, NULL otherwise
+	const AlphaMask2D *GetPixelMask() const;
+
 private:
 	hkvVec2 m_scrollSpeed;
 	bool m_fullscreen;
 	int m_currentState;
-	int m_currentFrame;
-	float m_frameTime;
-	bool m_paused;
 	bool m_playOnce;
 	bool m_collide;
-	hkvVec2 m_scrollOffset;
+
+	// Frame, frame time and scroll offset live in the manager, which advances the
+	// animations of all sprites at once. Valid for as long as the sprite exists.
+	int m_animation;
 
 	// Generate a convex hull for this sprite
 	bool m_convexHullCollision;
 
+	// Test the alpha masks of the cells after the hulls or quads
+	bool m_pixelCollision;
+
+	bool m_continuousCollision;
+
+	// Position when UpdateSweep was last called and the move since then
+	hkvVec2 m_sweepPosition;
+	bool m_hasSweepPosition;
+	hkvVec2 m_sweep;
+	bool m_sweeping;
+
+	unsigned int m_collisionLayer;
+	unsigned int m_collisionMask;
+
 	// Whether or not to simulate this with physics
 	bool m_simulate;
 	// If simulated, is it a fixed body or dynamic
@@ -149,6 +278,10 @@ private:
 
 	const SpriteData *m_spriteData;
 
+	// Set instead of m_spriteData while the sprite sheet is still loading in the background
+	const SpriteData *m_pendingSpriteData;
+	bool m_centerWhenLoaded;
+
 #if USE_HAVOK_PHYSICS_2D
 	VArray<hkpConvexTransformShape *> m_shapes;
 	VArray<hkpRigidBody *> m_rigidBodies;
@@ -156,9 +289,18 @@ private:
 
 	//-- render geometry
 
-	Overlay2DVertex_t m_renderVertices[6];
 	hkvVec2 m_vertices[4];
 	hkvVec2 m_texCoords[4];
+	std::vector<Vertex2D> m_hullVertices;
+
+	// Placement of the current cell as of the last BuildQuad, for pixel collision
+	SpriteQuad2D m_collisionQuad;
+
+	// Orientation the rotation below was taken from, so that BuildQuad only needs the
+	// sine and cosine again once it changes
+	float m_rotationDegrees;
+	float m_cosRotation;
+	float m_sinRotation;
 
 	//-- filenames
 
@@ -168,6 +310,14 @@ private:
 	//-- updated at runtime
 
 	bool m_offscreen;
+	bool m_positionChanged;
+	int m_broadphaseProxy;
+	int m_registryIndex;
+	int m_spritePool;
+	bool m_inSpritePool;
+
+	// Script components paused by PauseScripts that were thinking before
+	std::vector< VSmartPtr<IVObjectComponent> > m_pausedScripts;
 };
 
 #endif // SPRITE_ENTITY_HPP_INCLUDED
\ No newline at end of file
@@ -79,6 +79,29 @@ VEXPORT IVisPlugin_cl* GetEnginePlugin_Toolset2D_EnginePlugin()
 	return &g_Toolset2D_EnginePlugin;
 }
 
+//  Lets the game show how far the sprite sheets of the scene have been loaded without having
+//  to include the manager
+VEXPORT float Toolset2D_GetSpriteSheetLoadProgress()
+{
+	return Toolset2dManager::Instance()->GetSpriteSheetLoadProgress();
+}
+
+VEXPORT int Toolset2D_GetNumPendingSpriteSheets()
+{
+	return Toolset2dManager::Instance()->GetNumPendingSpriteSheets();
+}
+
+//  Writes the frame stats to a CSV file, one line per frame
+VEXPORT bool Toolset2D_StartStatsCsv(const char *filename)
+{
+	return Toolset2dManager::Instance()->StartStatsCsv(filename);
+}
+
+VEXPORT void Toolset2D_StopStatsCsv()
+{
+	Toolset2dManager::Instance()->StopStatsCsv();
+}
+
 #if (defined _DLL) || (defined _WINDLL)
 
 //  The engine uses this to get and initialize the plugin dynamically
@@ -21,6 +21,8 @@
 #include <Vision/Runtime/EnginePlugins/VisionEnginePlugin/Scripting/VScriptIncludes.hpp>
 #include <Vision/Runtime/EnginePlugins/VisionEnginePlugin/Scripting/VLuaHelpers.hpp>
 
+#include <algorithm>
+
 #if USE_HAVOK_PHYSICS_2D
 #include <Common/Base/hkBase.h>
 #include <Common/Base/Config/hkProductFeatures.h>
@@ -40,8 +42,94 @@
 // global function referenced
 extern "C" int luaopen_Toolset2dModule(lua_State *);
 
-// compare two sprites for depth sorting
-static int compareSprites(const void *sprite1, const void *sprite2);
+// Upper bound on the number of vertices submitted with one draw call
+static const int kMaxBatchVertices = 6 * 2048;
+
+// Only textures up to this fraction of an atlas page are packed
+static const int kAtlasMaxTextureFraction = 2;
+
+// With more sprites out of place than this a full sort is cheaper than an insertion sort
+static const int kMaxInsertionSortChanges = 32;
+
+// Sprites are split into a few more chunks than there are threads so that threads that
+// finish early can pick up the rest, but never into chunks smaller than this
+static const int kUpdateTasksPerThread = 4;
+static const int kMinSpritesPerUpdateTask = 256;
+static const int kUpdateTaskPriority = 2;
+
+// Sheets are loaded in the background at a lower priority than the sprite updates
+static const int kLoadTaskPriority = 1;
+
+// Where the stats overlay is printed on screen
+static const int kStatsOverlayX = 10;
+static const int kStatsOverlayY = 40;
+static const int kStatsOverlayLineHeight = 12;
+
+// Adds the time until the end of the scope to one of the frame timers
+class ScopedFrameTimer
+{
+public:
+	ScopedFrameTimer(FrameStats2D &stats, FrameTimer2D timer)
+		: m_stats(stats)
+	{
+		m_timer = timer;
+		m_start = VGLGetTimer();
+	}
+
+	~ScopedFrameTimer()
+	{
+		const uint64 elapsed = VGLGetTimer() - m_start;
+		m_stats.AddTime(m_timer, static_cast<float>( static_cast<double>(elapsed) * 1000.0 / static_cast<double>(VGLGetTimerResolution()) ));
+	}
+
+private:
+	FrameStats2D &m_stats;
+	FrameTimer2D m_timer;
+	uint64 m_start;
+};
+
+// Updates one chunk of sprites on one of the engine's worker threads
+class Toolset2dManager::UpdateTask : public VThreadedTask
+{
+public:
+	UpdateTask()
+	{
+		m_begin = 0;
+		m_end = 0;
+		m_viewportBoundingBox = NULL;
+	}
+
+	VOVERRIDE void Run(VManagedThread *pThread)
+	{
+		Toolset2dManager::Instance()->UpdateSpriteRange(m_begin, m_end, m_viewportBoundingBox);
+	}
+
+	int m_begin;
+	int m_end;
+	const hkvAlignedBBox *m_viewportBoundingBox;
+};
+
+// Reads the description of one sprite sheet on one of the engine's worker threads. The
+// texture is left to the main thread.
+class Toolset2dManager::LoadTask : public VThreadedTask
+{
+public:
+	LoadTask(SpriteData *spriteData)
+	{
+		m_spriteData = spriteData;
+		m_described = false;
+	}
+
+	VOVERRIDE void Run(VManagedThread *pThread)
+	{
+		m_described = m_spriteData->LoadDescription();
+	}
+
+	SpriteData *m_spriteData;
+	bool m_described;
+};
+
+VisCallback_cl Toolset2dManager::OnSpriteSheetLoaded;
 
 #if defined(WIN32)
 TOOLSET_2D_IMPEXP bool convertToAssetPath(const char* absolutePath, hkStringBuf& out_relativePath);
@@ -54,6 +142,7 @@ SpriteCell::SpriteCell()
 	width = originalWidth = 0.f;
 	height = originalHeight = 0.f;
 	index = 0;
+	duration = 0.f;
 
 #if USE_HAVOK_PHYSICS_2D
 	shape = NULL;
@@ -61,10 +150,62 @@ SpriteCell::SpriteCell()
 #endif // USE_HAVOK_PHYSICS_2D
 }
 
+SpriteState::SpriteState()
+{
+	framerate = 0.f;
+	frameDuration = 0.f;
+	loopDuration = 0.f;
+}
+
+void SpriteState::UpdateFrameTimes(const VArray<SpriteCell> &allCells)
+{
+	const int numFrames = cells.GetSize();
+
+	// One extra so there is always a first element to point at
+	std::vector<float> frameDurations(numFrames + 1);
+	std::vector<float> endTimes(numFrames + 1);
+	for (int frame = 0; frame < numFrames; frame++)
+	{
+		frameDurations[frame] = allCells[cells[frame]].duration;
+	}
+
+	frameDuration = BuildFrameEndTimes2D(&frameDurations[0], numFrames, framerate, &endTimes[0]);
+	loopDuration = (numFrames > 0) ? endTimes[numFrames - 1] : 0.f;
+
+	frameEndTimes.RemoveAll();
+	for (int frame = 0; frame < numFrames; frame++)
+	{
+		frameEndTimes.Append(endTimes[frame]);
+	}
+}
+
+AnimationTimeline2D SpriteState::GetTimeline() const
+{
+	AnimationTimeline2D timeline;
+	timeline.frameEndTimes = (frameEndTimes.GetSize() > 0) ? &frameEndTimes[0] : NULL;
+	timeline.numFrames = frameEndTimes.GetSize();
+	timeline.frameDuration = frameDuration;
+	timeline.loopDuration = loopDuration;
+	return timeline;
+}
+
 SpriteData::SpriteData()
 {
+	hash = 0;
+	refCount = 0;
+
+	loadState = SPRITE_DATA_LOADING;
+	invalidBinary = false;
+
+	sourceWidth = 0.f;
+	sourceHeight = 0.f;
+
 	spriteSheetTexture = NULL;
 	textureAnimation = NULL;
+
+	atlasTexture = NULL;
+	atlasUvOffset.setZero();
+	atlasUvScale.set(1.0f, 1.0f);
 }
 
 SpriteData::~SpriteData()
@@ -101,184 +242,365 @@ void SpriteData::Cleanup()
 
 	V_SAFE_RELEASE(textureAnimation);
 	V_SAFE_RELEASE(spriteSheetTexture);
+
+	atlasTexture = NULL;
 }
 
-bool SpriteData::GenerateConvexHull()
+bool SpriteData::IsLoaded() const
+{
+	return (loadState == SPRITE_DATA_LOADED);
+}
+
+bool SpriteData::LoadDescription()
 {
-	if ( spriteSheetTexture == NULL || !spriteSheetTexture->HasDeviceHandle() )
+	return ( LoadBinary( Toolset2dManager::GetSpriteSheetBinaryFilename(xmlDataFilename) ) ||
+			 LoadXml(xmlDataFilename) );
+}
+
+bool SpriteData::LoadBinary(const char *binaryFilename)
+{
+	IVFileInStream *pStream = NULL;
+	if (binaryFilename != NULL && binaryFilename[0] != '\0')
+	{
+		pStream = Vision::File.Open(binaryFilename);
+	}
+
+	if (pStream == NULL)
 	{
 		return false;
 	}
 
-	bool success = false;
+	// Read it in one go into a buffer that is aligned for the sheet's 32-bit values
+	const size_t size = static_cast<size_t>( pStream->GetSize() );
+	std::vector<unsigned int> buffer( (size + 3) / 4 + 1 );
+	const bool read = ( size > 0 && pStream->Read(&buffer[0], size) == size );
+	pStream->Close();
+
+	SpriteSheetBinary2D sheet;
+	if ( !read || !sheet.Load(&buffer[0], size) )
+	{
+		invalidBinary = true;
+		return false;
+	}
+
+	sourceWidth = sheet.GetSourceWidth();
+	sourceHeight = sheet.GetSourceHeight();
+
+	for (int cellIndex = 0; cellIndex < sheet.GetNumCells(); cellIndex++)
+	{
+		const SheetCell2D &sheetCell = sheet.GetCell(cellIndex);
+
+		SpriteCell *cell = &cells[cells.Append(SpriteCell())];
+		cell->name = sheet.GetCellName(cellIndex);
+		cell->offset.set(sheetCell.offsetX, sheetCell.offsetY);
+		cell->pivot.set(sheetCell.pivotX, sheetCell.pivotY);
+		cell->width = sheetCell.width;
+		cell->height = sheetCell.height;
+		cell->originalWidth = sheetCell.originalWidth;
+		cell->originalHeight = sheetCell.originalHeight;
+		cell->index = sheetCell.index;
+		cell->duration = sheetCell.duration;
+
+		const SheetVertex2D *hullVertices = sheet.GetCellHullVertices(cellIndex);
+		for (unsigned int vertexIndex = 0; vertexIndex < sheetCell.numHullVertices; vertexIndex++)
+		{
+			const Vertex2D vertex = { hullVertices[vertexIndex].x, hullVertices[vertexIndex].y };
+			cell->hullVertices.push_back(vertex);
+		}
 
-#if defined(WIN32) && USE_HAVOK_PHYSICS_2D
-	const int bytesPerPixel = spriteSheetTexture->GetBitsPerPixel(spriteSheetTexture->GetTextureFormat()) / 8;
-	IDirect3DTexture9 *pTexture2D = (IDirect3DTexture9 *)spriteSheetTexture->GetD3DInterface();
-	const int iMipLevel = 0;
-	const int iLockFlags = D3DLOCK_READONLY;
+		if (sheetCell.maskWidth > 0)
+		{
+			cell->alphaMask.Create( static_cast<int>(sheetCell.maskWidth), static_cast<int>(sheetCell.maskHeight) );
 
-	D3DSURFACE_DESC surfaceDesc;
-	HRESULT result = pTexture2D->GetLevelDesc(iMipLevel, &surfaceDesc);
+			// Stored as pairs of 32-bit words, low half first
+			const unsigned int *maskWords = sheet.GetCellMaskWords(cellIndex);
+			for (int y = 0; y < cell->alphaMask.GetHeight(); y++)
+			{
+				unsigned long long *row = cell->alphaMask.GetRow(y);
+				for (int word = 0; word < cell->alphaMask.GetWordsPerRow(); word++)
+				{
+					row[word] = maskWords[0] | ( static_cast<unsigned long long>(maskWords[1]) << 32 );
+					maskWords += 2;
+				}
+			}
+		}
+	}
 
-	if (result != S_OK)
+	for (int stateIndex = 0; stateIndex < sheet.GetNumStates(); stateIndex++)
 	{
-		return false;
+		const SheetState2D &sheetState = sheet.GetState(stateIndex);
+
+		SpriteState *state = &states[states.Append(SpriteState())];
+		state->name = sheet.GetStateName(stateIndex);
+		state->framerate = sheetState.framerate;
+
+		const unsigned int *stateCells = sheet.GetStateCells(stateIndex);
+		for (unsigned int cellIndex = 0; cellIndex < sheetState.numStateCells; cellIndex++)
+		{
+			state->cells.Append( static_cast<int>(stateCells[cellIndex]) );
+		}
+
+		stateNameToIndex.Set(state->name, stateIndex);
 	}
 
-	D3DLOCKED_RECT destRect;
-	RECT lockRect = { 0, 0, spriteSheetTexture->GetTextureWidth(), spriteSheetTexture->GetTextureHeight() };
-	result = pTexture2D->LockRect(iMipLevel, &destRect, NULL, spriteSheetTexture->GetD3D9LockFlags(iLockFlags));
+	return true;
+}
+
+bool SpriteData::LoadXml(const char *xmlFilename)
+{
+	TiXmlDocument xmlDocument;
 
-	if (result == S_OK)
+	// If we successfully load the XML, then there is data we can parse about the sprites in the sheet
+	if ( !xmlDocument.LoadFile(xmlFilename) )
 	{
-		const unsigned char thresholdMin = 10;
+		return false;
+	}
+
+	const char *szActionNode = "SubTexture";
+	TiXmlElement *rootElement = xmlDocument.RootElement();
 
-		unsigned char *pDest = (unsigned char *)destRect.pBits;
+	rootElement->QueryFloatAttribute("width", &sourceWidth);
+	rootElement->QueryFloatAttribute("height", &sourceHeight);
 
-		for (int stateIndex = 0; stateIndex < cells.GetLength(); stateIndex++)
+	for (TiXmlElement *pNode = rootElement->FirstChildElement(szActionNode);
+		pNode != NULL;
+		pNode = pNode->NextSiblingElement(szActionNode) )
+	{
+		const char *name = pNode->Attribute("name");
+
+		int x;
+		int y;
+		int width;
+		int height;
+		int originalWidth;
+		int originalHeight;
+		int ox;
+		int oy;
+
+		pNode->QueryIntAttribute("x", &x);
+		pNode->QueryIntAttribute("y", &y);
+		pNode->QueryIntAttribute("width", &width);
+		pNode->QueryIntAttribute("height", &height);
+		pNode->QueryIntAttribute("original_width", &originalWidth);
+		pNode->QueryIntAttribute("original_height", &originalHeight);
+		pNode->QueryIntAttribute("ox", &ox);
+		pNode->QueryIntAttribute("oy", &oy);
+
+		const int newCellIndex = cells.Append(SpriteCell());
+		SpriteCell *currentCell = &cells[newCellIndex];
+		currentCell->name = name;
+		currentCell->offset.x = static_cast<float>(x);
+		currentCell->offset.y = static_cast<float>(y);
+		currentCell->pivot.x = static_cast<float>(ox);
+		currentCell->pivot.y = static_cast<float>(oy);
+		currentCell->width = static_cast<float>(width);
+		currentCell->height = static_cast<float>(height);
+		currentCell->originalWidth = static_cast<float>(originalWidth);
+		currentCell->originalHeight = static_cast<float>(originalHeight);
+		pNode->QueryFloatAttribute("duration", &currentCell->duration);
+
+		std::string cellStateName;
+		const bool animated = ParseCellName2D(name, cellStateName, currentCell->index);
+		const VString stateName = cellStateName.c_str();
+
+		SpriteState *state = NULL;
+		int stateIndex = animated ? stateNameToIndex.Find(stateName) : -1;
+		if (stateIndex == -1)
+		{
+			stateIndex = states.Append(SpriteState());
+			state = &states[stateIndex];
+			state->name = stateName;
+			state->framerate = animated ? kAnimatedFramerate2D : kSingleCellFramerate2D;
+			stateNameToIndex.Set(state->name, stateIndex);
+		}
+		else
 		{
-			SpriteCell &cell = cells[stateIndex];
-			const int width = static_cast<int>(cell.width);
-			const int height = static_cast<int>(cell.height);
+			state = &states[stateIndex];
+		}
 
-			int *mins = new int[height];
-			int *maxs = new int[height];
-			memset(mins, -1, sizeof(int) * height);
-			memset(maxs, -1, sizeof(int) * height);
+		state->cells.Append(newCellIndex);
+	}
 
-			const int startX = static_cast<int>(cell.offset.x);
-			const int endX = startX + width;
-			const int startY = static_cast<int>(cell.offset.y);
-			const int endY = startY + height;
+	return true;
+}
 
-			for (int y = startY; y < endY; y++)
-			{
-				bool findMin = true;
-				const int positionY = y - startY;
+void SpriteData::UpdateFrameTimes()
+{
+	for (int stateIndex = 0; stateIndex < states.GetSize(); stateIndex++)
+	{
+		states[stateIndex].UpdateFrameTimes(cells);
+	}
+}
 
-				for (int x = startX; x < endX; x++)
-				{
-					unsigned char *pixelRaw = &pDest[y * destRect.Pitch + x * bytesPerPixel];
-					unsigned int alpha = 0;
-					
-					// if there's an alpha channel, just worry about that
-					if (bytesPerPixel == 4)
-					{
-						const unsigned int *pixel = reinterpret_cast<unsigned int*>(pixelRaw);
-						alpha = ((*pixel) & 0xff000000) >> 24;
-					}
-					else
-					{
-						for (int offset = 0; offset < bytesPerPixel; offset++)
-						{
-							alpha += pixelRaw[offset];
-						}
-					}
+#if USE_HAVOK_PHYSICS_2D
+// Builds the 2d and 3d collision shapes of a cell from points in cell space
+static bool BuildCellShapes(SpriteCell &cell, const hkArray<hkVector4> &vertices)
+{
+	hkgpConvexHull::BuildConfig	config;
+	config.m_allowLowerDimensions = true;
+	config.m_buildIndices = true;
+	config.m_sortInputs = true;
 
-					const int positionX = x - startX;
-					const bool withinThreshold = (alpha >= thresholdMin);
-					if (findMin && withinThreshold)
-					{
-						mins[positionY] = positionX;
-						findMin = false;
-					}
-					else if (!findMin && !withinThreshold)
-					{
-						maxs[positionY] = positionX;
-						break;
-					}
-				}
+	hkgpConvexHull convexHull;
 
-				if (maxs[positionY] == -1)
-				{
-					maxs[positionY] = width;
-				}
-			}
+	if ( convexHull.build(vertices, config) != -1 )
+	{
+		hkgpConvexHull *result = &convexHull;
 
-			const float hwidth = static_cast<float>(width) / 2.0f;
-			const float hheight = static_cast<float>(height) / 2.0f;
-			hkArray<hkVector4> vertices;
-			for (int y = 0; y < height; y++)
-			{
-				if (mins[y] != -1)
-				{
-					hkReal xx1 = static_cast<hkReal>(mins[y]) - hwidth;
-					hkReal xx2 = static_cast<hkReal>(maxs[y]) - hwidth;
-					hkReal hh = static_cast<hkReal>(y) - hheight;
+		result->generateIndexedFaces(hkgpConvexHull::INTERNAL_VERTICES, cell.verticesPerFace, cell.vertexIndices, true);
+		result->fetchPositions(hkgpConvexHull::INTERNAL_VERTICES, cell.vertexPositions);
 
-					vertices.pushBack( hkVector4(xx1, hh, 0, 0) );
-					vertices.pushBack( hkVector4(xx2, hh, 0, 0) );
+		hkpConvexVerticesShape::BuildConfig config;
+		config.m_convexRadius = 0.0f;
+		config.m_shrinkByConvexRadius = false;
+		config.m_useOptimizedShrinking = false;
 
-					if (y == height - 1)
-					{
-						hkReal hh2 = static_cast<hkReal>(y + 1) - hheight;
-						vertices.pushBack( hkVector4(xx1, hh2, 0, 0) );
-						vertices.pushBack( hkVector4(xx2, hh2, 0, 0) );
-					}
-				}
-			}
+		cell.shape = new hkpConvexVerticesShape(cell.vertexPositions, config);
+
+		const hkReal depth = 100.0f;
 
-			delete [] mins;
-			delete [] maxs;
+		// Generate a 3d
+		hkArray<hkVector4> vertexPositions3d;
+		for (int vertexIndex = 0; vertexIndex < cell.vertexPositions.getSize(); vertexIndex++)
+		{
+			const hkVector4 position = cell.vertexPositions[vertexIndex];
+			vertexPositions3d.pushBack( hkVector4(position(0), position(1), 0.0f, 0.0f) );
+		}
 
-			const bool sortInputs = true;
-			const bool simplify = false;
+		// Get the bounding box of the shape and use the max extent as the depth of the 3d shape
+		hkAabb aabb;
+		cell.shape->getAabb( hkTransform::getIdentity(), 0.f, aabb );
+		const hkReal depthCenter = depth * 1.3f;
+		hkVector4 center;
+		aabb.getCenter(center);
+		vertexPositions3d.pushBack( hkVector4(center(0), center(1), -depthCenter , 0.f) );
+		vertexPositions3d.pushBack( hkVector4(center(0), center(1), depthCenter , 0.f) );
 
-			hkgpConvexHull::BuildConfig	config;
-			config.m_allowLowerDimensions = true;
-			config.m_buildIndices = true;
-			config.m_sortInputs = sortInputs;
+		config.m_convexRadius = 0.05f;
+		config.m_shrinkByConvexRadius = false;
+		cell.shape3d = new hkpConvexVerticesShape(vertexPositions3d, config);
 
-			hkVector4 projectionPlane(0, 0, 1);
+		return true;
+	}
 
-			hkgpConvexHull convexHull;
+	return false;
+}
+#endif // USE_HAVOK_PHYSICS_2D
 
-			if ( convexHull.build(vertices, config) != -1 )
-			{
-				hkgpConvexHull *result = &convexHull;	
+void SpriteData::GenerateHullsFromImage()
+{
+	// Not every platform can read textures back from the GPU, the image file has the same pixels
+	VSmartPtr<VisBitmap_cl> bitmap = VisBitmap_cl::LoadBitmapFromFile(spriteSheetFilename);
+	if (bitmap == NULL || !bitmap->IsLoaded())
+	{
+		return;
+	}
+
+	Vision::Error.Warning("Toolset2D: '%s' has cells without a baked hull, run spritesheetbin.py to bake them",
+		xmlDataFilename.AsChar());
+
+	// Same rule as hullbaker.py, so that a sheet gets the same hulls either way
+	const unsigned char thresholdMin = 10;
+
+	const int imageWidth = bitmap->GetWidth();
+	const int imageHeight = bitmap->GetHeight();
+	const unsigned char *pixels = reinterpret_cast<const unsigned char *>(bitmap->GetDataPtr());
 
-				result->generateIndexedFaces(hkgpConvexHull::INTERNAL_VERTICES, cell.verticesPerFace, cell.vertexIndices, true);					
-				result->fetchPositions(hkgpConvexHull::INTERNAL_VERTICES, cell.vertexPositions);
+	for (int cellIndex = 0; cellIndex < cells.GetLength(); cellIndex++)
+	{
+		SpriteCell &cell = cells[cellIndex];
+		if (cell.hullVertices.size() >= 3)
+		{
+			continue;
+		}
 
-				hkpConvexVerticesShape::BuildConfig config;
-				config.m_convexRadius = 0.0f;
-				config.m_shrinkByConvexRadius = false;
-				config.m_useOptimizedShrinking = false;
+		const int width = static_cast<int>(cell.width);
+		const int height = static_cast<int>(cell.height);
 
-				cell.shape = new hkpConvexVerticesShape(cell.vertexPositions, config);
+		const int startX = hkvMath::clamp(static_cast<int>(cell.offset.x), 0, imageWidth);
+		const int startY = hkvMath::clamp(static_cast<int>(cell.offset.y), 0, imageHeight);
+		const int endX = hkvMath::clamp(startX + width, startX, imageWidth);
+		const int endY = hkvMath::clamp(startY + height, startY, imageHeight);
 
-				const hkReal depth = 100.0f;
+		const float hwidth = static_cast<float>(width) / 2.0f;
+		const float hheight = static_cast<float>(height) / 2.0f;
 
-				// Generate a 3d
-				hkArray<hkVector4> vertexPositions3d;
-				for (int vertexIndex = 0; vertexIndex < cell.vertexPositions.getSize(); vertexIndex++)
+		// Every row adds the outer corners of the span from its first to its last opaque
+		// pixel, gaps in between don't matter for a convex hull
+		std::vector<Vertex2D> points;
+		for (int y = startY; y < endY; y++)
+		{
+			int first = -1;
+			int last = -1;
+			for (int x = startX; x < endX; x++)
+			{
+				// RGBA, one byte per channel
+				if (pixels[(y * imageWidth + x) * 4 + 3] >= thresholdMin)
 				{
-					const hkVector4 position = cell.vertexPositions[vertexIndex];
-					vertexPositions3d.pushBack( hkVector4(position(0), position(1), 0.0f, 0.0f) );
+					if (first == -1)
+					{
+						first = x - startX;
+					}
+					last = x - startX;
 				}
+			}
 
-				// Get the bounding box of the shape and use the max extent as the depth of the 3d shape
-				hkAabb aabb;
-				cell.shape->getAabb( hkTransform::getIdentity(), 0.f, aabb );
-				const hkReal depthCenter = depth * 1.3f;
-				hkVector4 center;
-				aabb.getCenter(center);
-				vertexPositions3d.pushBack( hkVector4(center(0), center(1), -depthCenter , 0.f) );
-				vertexPositions3d.pushBack( hkVector4(center(0), center(1), depthCenter , 0.f) );
-
-				config.m_convexRadius = 0.05f;
-				config.m_shrinkByConvexRadius = false;
-				cell.shape3d = new hkpConvexVerticesShape(vertexPositions3d, config);
+			if (first != -1)
+			{
+				const float left = static_cast<float>(first) - hwidth;
+				const float right = static_cast<float>(last + 1) - hwidth;
+				const float top = static_cast<float>(y - startY) - hheight;
 
-				success = true;
+				const Vertex2D corners[4] = { { left, top }, { right, top }, { left, top + 1.f }, { right, top + 1.f } };
+				points.insert(points.end(), corners, corners + 4);
 			}
 		}
 
-		HRESULT unlockResult = pTexture2D->UnlockRect(iMipLevel);
-		VASSERT(unlockResult == S_OK);
+		BuildConvexHull2D(points, cell.hullVertices);
+	}
+}
+
+bool SpriteData::GenerateConvexHull()
+{
+	// Hulls baked into the precompiled sheet are used as they are, the image only has to
+	// be read again for cells that came without one
+	bool hasMissingHulls = false;
+	for (int cellIndex = 0; cellIndex < cells.GetLength(); cellIndex++)
+	{
+		if (cells[cellIndex].hullVertices.size() < 3)
+		{
+			hasMissingHulls = true;
+			break;
+		}
+	}
+
+	if (hasMissingHulls)
+	{
+		GenerateHullsFromImage();
+	}
+
+	bool success = false;
+	for (int cellIndex = 0; cellIndex < cells.GetLength(); cellIndex++)
+	{
+		SpriteCell &cell = cells[cellIndex];
+		if (cell.hullVertices.size() < 3)
+		{
+			continue;
+		}
+
+#if USE_HAVOK_PHYSICS_2D
+		hkArray<hkVector4> vertices;
+		for (size_t vertexIndex = 0; vertexIndex < cell.hullVertices.size(); vertexIndex++)
+		{
+			const Vertex2D &vertex = cell.hullVertices[vertexIndex];
+			vertices.pushBack( hkVector4(vertex.x, vertex.y, 0, 0) );
+		}
+
+		success = BuildCellShapes(cell, vertices) || success;
+#else
+		success = true;
+#endif // USE_HAVOK_PHYSICS_2D
 	}
-#endif // WIN32
 
 	return success;
 }
@@ -288,11 +610,44 @@ void Toolset2dManager::OneTimeInit()
 	m_camera = NULL;
 	m_gameMode = MODE_STOPPED;
 
+	m_numRemovedSprites = 0;
+	m_numDepthChanges = 0;
+
+	m_numActivePooledSprites = 0;
+	m_numPooledSprites = 0;
+	m_spritePoolHits = 0;
+	m_spritePoolMisses = 0;
+	m_spritePoolHighWater = 0;
+
+	m_numRenderBatches = 0;
+	m_numRenderVertices = 0;
+
+	m_statsOverlayEnabled = false;
+	m_statsCsv = NULL;
+
+	m_textureAtlasEnabled = false;
+	m_textureAtlasPageSize = 1024;
+	m_textureAtlasPadding = 2;
+
+	m_updateThreadCount = 0;
+
+	m_asyncLoadingEnabled = false;
+	m_numBackgroundLoads = 0;
+	m_sceneLoadStartTime = 0;
+	m_timeToFirstFrame = 0.f;
+
+	m_collisionStayEventEnabled = false;
+	m_collisionEventBatchingEnabled = false;
+	m_eventContactsBegin = 0;
+	m_numEventContacts = 0;
+
 	FORCE_LINKDYNCLASS(Sprite);
 	FORCE_LINKDYNCLASS(Camera2D);
 
 	Vision::Callbacks.OnRenderHook += this;
 	Vision::Callbacks.OnUpdateSceneFinished += this;
+	Vision::Callbacks.OnBeforeSceneLoaded += this;
+	Vision::Callbacks.OnAfterSceneLoaded += this;
 	Vision::Callbacks.OnEditorModeChanged += this;
 	Vision::Callbacks.OnAfterSceneUnloaded += this;
 	Vision::Callbacks.OnWorldDeInit += this;
@@ -321,8 +676,12 @@ void Toolset2dManager::OneTimeInit()
 
 void Toolset2dManager::OneTimeDeInit()
 {
+	StopStatsCsv();
+
 	Vision::Callbacks.OnRenderHook -= this;
 	Vision::Callbacks.OnUpdateSceneFinished -= this;
+	Vision::Callbacks.OnBeforeSceneLoaded -= this;
+	Vision::Callbacks.OnAfterSceneLoaded -= this;
 	Vision::Callbacks.OnAfterSceneUnloaded -= this;
 	Vision::Callbacks.OnEditorModeChanged -= this;
 	Vision::Callbacks.OnWorldDeInit -= this;
@@ -338,6 +697,15 @@ void Toolset2dManager::OneTimeDeInit()
 	vHavokVisualDebugger::OnCreatingContexts -= this;
 	vHavokVisualDebugger::OnAddingDefaultViewers -= this;
 #endif // USE_HAVOK_PHYSICS_2D
+
+	CancelSpriteDataLoads();
+
+	// All tasks have been waited on by the end of every update
+	for (int taskIndex = 0; taskIndex < m_updateTasks.GetSize(); taskIndex++)
+	{
+		V_SAFE_DELETE( m_updateTasks[taskIndex] );
+	}
+	m_updateTasks.RemoveAll();
 }
 
 void Toolset2dManager::InitializeHavokPhysics()
@@ -387,7 +755,11 @@ void Toolset2dManager::UnintializeHavokPhysics()
 
 void Toolset2dManager::RemoveSpriteData()
 {
-	VASSERT(m_sprites.GetSize() == 0);
+	// The workers may still be writing into the data
+	CancelSpriteDataLoads();
+
+	CompactSprites();
+	VASSERT(m_sprites.empty());
 
 	for (int spriteDataIndex = 0; spriteDataIndex < m_spriteData.GetSize(); spriteDataIndex++)
 	{
@@ -397,6 +769,97 @@ void Toolset2dManager::RemoveSpriteData()
 	}
 
 	m_spriteData.RemoveAll();
+	m_spriteDataIndex.Clear();
+
+	RemoveTextureAtlas();
+}
+
+bool Toolset2dManager::AddToTextureAtlas(SpriteData *spriteData)
+{
+	// Only loose textures, where the one and only cell covers the whole image, are packed
+	if (spriteData->atlasTexture != NULL ||
+		spriteData->spriteSheetTexture == NULL ||
+		spriteData->textureAnimation != NULL ||
+		spriteData->cells.GetSize() != 1)
+	{
+		return false;
+	}
+
+	const int width = spriteData->spriteSheetTexture->GetTextureWidth();
+	const int height = spriteData->spriteSheetTexture->GetTextureHeight();
+	const int maxTextureSize = m_textureAtlasPageSize / kAtlasMaxTextureFraction;
+	if (width > maxTextureSize || height > maxTextureSize)
+	{
+		return false;
+	}
+
+	// The GPU copy of the texture can't be read back on every platform, so load the pixels again
+	VSmartPtr<VisBitmap_cl> bitmap = VisBitmap_cl::LoadBitmapFromFile(spriteData->spriteSheetFilename);
+	if (bitmap == NULL || !bitmap->IsLoaded() || bitmap->GetWidth() != width || bitmap->GetHeight() != height)
+	{
+		return false;
+	}
+
+	if (m_atlasPages.GetSize() == 0)
+	{
+		m_atlasPacker.SetPageSize(m_textureAtlasPageSize);
+		m_atlasPacker.SetPadding(m_textureAtlasPadding);
+	}
+
+	int page;
+	AtlasRect2D rect;
+	if ( !m_atlasPacker.Insert(width, height, page, rect) )
+	{
+		return false;
+	}
+
+	const int pageSize = m_atlasPacker.GetPageSize();
+	if (page == m_atlasPages.GetSize())
+	{
+		VString pageName;
+		pageName.Format("<Toolset2DAtlas%d>", page);
+
+		VTextureObject *pageTexture = Vision::TextureManager.Create2DTextureObject(pageName, pageSize, pageSize, 1, VTextureLoader::R8G8B8A8);
+		if (pageTexture == NULL)
+		{
+			// The packer already counts this page, so stop packing for the rest of the scene
+			Vision::Error.AddReportEntry(VIS_REPORTENTRY_WARNING, "Toolset2D", "Unable to create texture atlas page, disabling texture atlas", "");
+			m_textureAtlasEnabled = false;
+			return false;
+		}
+
+		pageTexture->AddRef();
+		m_atlasPages.Append(pageTexture);
+	}
+
+	// Repeat the edge pixels into the padding so that filtering doesn't bleed in neighbours
+	const int padding = m_atlasPacker.GetPadding();
+	const int paddedWidth = width + padding * 2;
+	const int paddedHeight = height + padding * 2;
+
+	std::vector<unsigned int> pixels(paddedWidth * paddedHeight);
+	AtlasPacker2D::CopyWithBorder(reinterpret_cast<const unsigned int *>(bitmap->GetDataPtr()), width, height, padding, &pixels[0]);
+	m_atlasPages[page]->UpdateRect(0, rect.x - padding, rect.y - padding, paddedWidth, paddedHeight, paddedWidth * sizeof(unsigned int), &pixels[0], 0);
+
+	float offsetU, offsetV, scaleU, scaleV;
+	m_atlasPacker.GetUvTransform(rect, offsetU, offsetV, scaleU, scaleV);
+
+	spriteData->atlasTexture = m_atlasPages[page];
+	spriteData->atlasUvOffset.set(offsetU, offsetV);
+	spriteData->atlasUvScale.set(scaleU, scaleV);
+
+	return true;
+}
+
+void Toolset2dManager::RemoveTextureAtlas()
+{
+	for (int pageIndex = 0; pageIndex < m_atlasPages.GetSize(); pageIndex++)
+	{
+		V_SAFE_RELEASE(m_atlasPages[pageIndex]);
+	}
+
+	m_atlasPages.RemoveAll();
+	m_atlasPacker.Clear();
 }
 
 void Toolset2dManager::Step( float dt )
@@ -453,7 +916,12 @@ void Toolset2dManager::OnHandleCallback(IVisCallbackDataObject_cl *pData)
 {
 	//-- Scene load events
 
-	if (pData->m_pSender == &Vision::Callbacks.OnAfterSceneLoaded)
+	if (pData->m_pSender == &Vision::Callbacks.OnBeforeSceneLoaded)
+	{
+		VisSceneLoadedDataObject_cl *pSceneData = (VisSceneLoadedDataObject_cl *)pData;
+		BeginSceneLoad(pSceneData->m_szSceneFileName);
+	}
+	else if (pData->m_pSender == &Vision::Callbacks.OnAfterSceneLoaded)
 	{
 		// initialize play-the-game only in this vForge mode (or outside vForge)
 		if ( Vision::Editor.IsPlayingTheGame() )
@@ -464,10 +932,14 @@ void Toolset2dManager::OnHandleCallback(IVisCallbackDataObject_cl *pData)
 	else if (pData->m_pSender == &Vision::Callbacks.OnWorldDeInit)
 	{
 		m_gameMode = MODE_STOPPED;
+		m_contacts.Clear();
+		RemoveSpritePools();
 		RemoveSpriteData();
 	}
 	else if (pData->m_pSender == &Vision::Callbacks.OnAfterSceneUnloaded)
 	{
+		m_contacts.Clear();
+		RemoveSpritePools();
 		RemoveSpriteData();
 	}
 
@@ -497,6 +969,7 @@ void Toolset2dManager::OnHandleCallback(IVisCallbackDataObject_cl *pData)
 		if ( pRenderHookData->m_iEntryConst == VRH_POST_TRANSPARENT_PASS_GEOMETRY)
 		{
 			Render();
+			EndStatsFrame();
 		}
 	}
 	else if (pData->m_pSender == &Vision::Callbacks.OnUpdateSceneFinished)
@@ -600,6 +1073,8 @@ void Toolset2dManager::OnHandleCallback(IVisCallbackDataObject_cl *pData)
 
 void Toolset2dManager::Render()
 {
+	ScopedFrameTimer renderTimer(m_stats, FRAME_TIMER_RENDER);
+
 	IVRender2DInterface *pRender = Vision::RenderLoopHelper.BeginOverlayRendering();	
 
 	pRender->SetDepth(512.f);
@@ -608,7 +1083,7 @@ void Toolset2dManager::Render()
 	VSimpleRenderState_t state(VIS_TRANSP_ALPHA, RENDERSTATEFLAG_ALWAYSVISIBLE | RENDERSTATEFLAG_FILTERING | RENDERSTATEFLAG_DOUBLESIDED);
 
 	// Sort all the sprites by their Z order
-	qsort(m_sprites.GetData(), m_sprites.GetSize(), sizeof(VWeakPtr<VisBaseEntity_cl> *), compareSprites);
+	SortSprites();
 
 	if (m_camera != NULL)
 	{
@@ -616,379 +1091,1734 @@ void Toolset2dManager::Render()
 		pRender->SetTransformation(transform);
 	}
 
-	// Now render all the things
-	for (int spriteIndex = 0; spriteIndex < m_sprites.GetSize(); spriteIndex++)
+	m_numRenderBatches = 0;
+	m_numRenderVertices = 0;
+
+	// Now render all the things. Sprites have to be drawn in Z order, so only neighbouring
+	// sprites that use the same texture end up in the same batch.
+	VTextureObject *batchTexture = NULL;
+	m_batchVertices.clear();
+
+	for (int spriteIndex = 0; spriteIndex < static_cast<int>(m_sprites.size()); spriteIndex++)
 	{
-		Sprite *sprite = static_cast<Sprite*>( m_sprites[spriteIndex]->GetPtr() );
-		if (sprite)
+		const SpriteEntry &entry = m_sprites[spriteIndex];
+		Sprite *sprite = entry.sprite;
+
+		// Sprites added since the last update don't have a quad yet
+		if (sprite && entry.quadIndex != -1 && sprite->IsRenderable())
+		{
+			VTextureObject *texture = sprite->GetTexture();
+			if (texture != batchTexture || static_cast<int>(m_batchVertices.size()) >= kMaxBatchVertices)
+			{
+				FlushRenderBatch(pRender, batchTexture, state);
+				batchTexture = texture;
+			}
+
+			const size_t firstVertex = m_batchVertices.size();
+			m_batchVertices.resize(firstVertex + 6);
+			m_quads.WriteVertices(entry.quadIndex, &m_batchVertices[firstVertex]);
+		}
+		else if (sprite && entry.quadIndex != -1 && sprite->IsOffscreen())
 		{
-			sprite->Render(pRender, state);
+			m_stats.AddCount(FRAME_COUNTER_CULLED);
 		}
 	}
 
+	FlushRenderBatch(pRender, batchTexture, state);
+
 	Vision::RenderLoopHelper.EndOverlayRendering();
+
+	// The first frame only counts once everything the scene loads in the background is there
+	if (m_sceneLoadStartTime != 0 && m_loadTasks.GetSize() == 0)
+	{
+		EndSceneLoad();
+	}
 }
 
-void Toolset2dManager::Update(float deltaTime)
+void Toolset2dManager::FlushRenderBatch(IVRender2DInterface *pRender, VTextureObject *texture, VSimpleRenderState_t &state)
 {
-	hkvAlignedBBox *viewportBoundingBox = NULL;
-	hkvAlignedBBox viewport;
-
-	if ( Vision::IsInitialized() && Vision::Contexts.GetMainRenderContext() )
+	const int numVertices = static_cast<int>(m_batchVertices.size());
+	if (numVertices > 0)
 	{
-		int x, y, w, h;
-		Vision::Contexts.GetMainRenderContext()->GetViewport(x, y, w, h);
+		// The quad store writes vertices in the same layout as the engine's overlay vertices
+		V_COMPILE_ASSERT(sizeof(QuadVertex2D) == sizeof(Overlay2DVertex_t));
+		pRender->Draw2DBuffer(numVertices, reinterpret_cast<Overlay2DVertex_t*>(&m_batchVertices[0]), texture, state);
 
-		viewport.setZero();
-		viewport.expandToInclude( hkvVec3(static_cast<float>(x), static_cast<float>(y), 0) );
-		viewport.expandToInclude( hkvVec3(static_cast<float>(x + w), static_cast<float>(y + h), 0) );
+		m_numRenderBatches++;
+		m_numRenderVertices += numVertices;
 
-		viewportBoundingBox = &viewport;
+		m_stats.AddCount(FRAME_COUNTER_DRAW_CALLS);
+		m_stats.AddCount(FRAME_COUNTER_BYTES_UPLOADED, numVertices * sizeof(QuadVertex2D));
+
+		m_batchVertices.clear();
 	}
+}
 
-	int spriteIndex = 0;
+void Toolset2dManager::SortSprites()
+{
+	ScopedFrameTimer sortTimer(m_stats, FRAME_TIMER_SORT);
 
-	// Remove all dead sprites and update vertices first before checking collision
-	while (spriteIndex < m_sprites.GetSize())
+	if (m_numDepthChanges == 0 || m_sprites.empty())
 	{
-		Sprite *sprite = static_cast<Sprite*>( m_sprites[spriteIndex]->GetPtr() );
-		if (sprite == NULL)
-		{
-			V_SAFE_DELETE( m_sprites[spriteIndex] );
-			m_sprites.RemoveAt(spriteIndex);
-		}
-		else
-		{
-			// Update all the sprites first so we're sure their vertices are up to date
-			sprite->Update(viewportBoundingBox);
+		m_numDepthChanges = 0;
+		return;
+	}
+
+	SpriteEntry *entries = &m_sprites[0];
+	const int numSprites = static_cast<int>(m_sprites.size());
+
+	if (m_numDepthChanges > kMaxInsertionSortChanges)
+	{
+		std::sort(entries, entries + numSprites, IsDrawnBefore);
 
-			spriteIndex++;
+		for (int spriteIndex = 0; spriteIndex < numSprites; spriteIndex++)
+		{
+			if (entries[spriteIndex].sprite != NULL)
+			{
+				entries[spriteIndex].sprite->SetRegistryIndex(spriteIndex);
+			}
 		}
 	}
-	
-	// Check to see if there are any overlaps and report it
-	for (spriteIndex = 0; spriteIndex < m_sprites.GetSize(); spriteIndex++)
+	else
 	{
-		Sprite *sprite = static_cast<Sprite*>( m_sprites[spriteIndex]->GetPtr() );
-
-		// Only worry about sprites that have collision enabled
-		if (sprite->IsColliding())
+		// Only a few sprites are out of place, which an insertion sort handles in close to linear time
+		for (int spriteIndex = 1; spriteIndex < numSprites; spriteIndex++)
 		{
-			// Check this sprite against 
-			for (int otherSpriteIndex = spriteIndex + 1; otherSpriteIndex < m_sprites.GetSize(); otherSpriteIndex++)
+			if ( IsDrawnBefore(entries[spriteIndex], entries[spriteIndex - 1]) )
 			{
-				Sprite *otherSprite = static_cast<Sprite*>( m_sprites[otherSpriteIndex]->GetPtr() );
-				if (otherSprite->IsColliding() &&
-					(sprite->IsOverlapping(otherSprite) || otherSprite->IsOverlapping(sprite)))
+				const SpriteEntry entry = entries[spriteIndex];
+
+				int insertIndex = spriteIndex;
+				do
+				{
+					entries[insertIndex] = entries[insertIndex - 1];
+					if (entries[insertIndex].sprite != NULL)
+					{
+						entries[insertIndex].sprite->SetRegistryIndex(insertIndex);
+					}
+					insertIndex--;
+				}
+				while ( insertIndex > 0 && IsDrawnBefore(entry, entries[insertIndex - 1]) );
+
+				entries[insertIndex] = entry;
+				if (entry.sprite != NULL)
 				{
-					sprite->OnCollision(otherSprite);
-					otherSprite->OnCollision(sprite);
+					entry.sprite->SetRegistryIndex(insertIndex);
 				}
 			}
 		}
 	}
+
+	m_numDepthChanges = 0;
 }
 
-void Toolset2dManager::AddSprite(Sprite *sprite)
+void Toolset2dManager::Update(float deltaTime)
 {
-	if (FindSprite(sprite) == -1)
+	// A frame of stats runs from here to the end of the render
+	m_stats.BeginFrame();
+	if (m_statsOverlayEnabled)
 	{
-		m_sprites.Append( new VWeakPtr<VisBaseEntity_cl>(sprite->GetWeakReference()) );
+		DrawStatsOverlay();
 	}
-}
 
-int Toolset2dManager::FindSprite(Sprite *sprite)
-{
-	int resultIndex = -1;
-	for (int spriteIndex = 0; spriteIndex < m_sprites.GetSize(); spriteIndex++)
+	ScopedFrameTimer updateTimer(m_stats, FRAME_TIMER_UPDATE);
+
+	hkvAlignedBBox *viewportBoundingBox = NULL;
+	hkvAlignedBBox viewport;
+
+	if ( Vision::IsInitialized() && Vision::Contexts.GetMainRenderContext() )
+	{
+		int x, y, w, h;
+		Vision::Contexts.GetMainRenderContext()->GetViewport(x, y, w, h);
+
+		viewport.setZero();
+		viewport.expandToInclude( hkvVec3(static_cast<float>(x), static_cast<float>(y), 0) );
+		viewport.expandToInclude( hkvVec3(static_cast<float>(x + w), static_cast<float>(y + h), 0) );
+
+		viewportBoundingBox = &viewport;
+	}
+
+	// Sheets that finished loading in the background send their events before anything
+	// else, so the scripts can still add and remove sprites
+	PublishSpriteData(false);
+
+	// Scripts hear about finished animations at the point where the sprites used to think,
+	// so they can still add and remove sprites as well
+	if (Vision::Editor.IsAnimatingOrPlaying())
+	{
+		UpdateAnimations(deltaTime);
+	}
+
+	// Close the holes left by removed sprites first. Anything that touches physics or the
+	// scripts has to stay on the main thread.
+	CompactSprites();
+
+	const int numSprites = static_cast<int>(m_sprites.size());
+	m_updateSprites.resize(numSprites);
+	m_stats.AddCount(FRAME_COUNTER_SPRITES, numSprites);
+
+	for (int spriteIndex = 0; spriteIndex < numSprites; spriteIndex++)
+	{
+		Sprite *sprite = m_sprites[spriteIndex].sprite;
+		sprite->SyncSpriteData();
+		sprite->SyncPhysics();
+		m_updateSprites[spriteIndex] = sprite;
+	}
+
+	// Update the vertices of all sprites so we're sure they are up to date before checking
+	// collision
+	m_quads.Resize(numSprites);
+	UpdateSprites(viewportBoundingBox);
+
+	for (int spriteIndex = 0; spriteIndex < numSprites; spriteIndex++)
 	{
-		if (m_sprites[spriteIndex]->GetPtr() == sprite)
+		SpriteEntry &entry = m_sprites[spriteIndex];
+		Sprite *sprite = m_updateSprites[spriteIndex];
+
+		if (sprite->ConsumePositionChanged())
 		{
-			resultIndex = spriteIndex;
-			break;
+			const float depth = sprite->GetPosition().z;
+			if (depth != entry.depth)
+			{
+				entry.depth = depth;
+				m_numDepthChanges++;
+			}
 		}
+
+		sprite->UpdateSweep();
+		UpdateBroadphase(sprite);
 	}
-	return resultIndex;
+
+	UpdateCollisions();
 }
 
-void Toolset2dManager::RemoveSprite(Sprite *sprite)
+void Toolset2dManager::UpdateCollisions()
 {
-	int index = FindSprite(sprite);
-	if (index != -1)
+	ScopedFrameTimer collisionTimer(m_stats, FRAME_TIMER_COLLISION);
+
+	// Check to see if there are any overlaps. The broadphase only hands back colliding
+	// sprites whose bounding boxes overlap. Nothing is reported until all pairs have been
+	// tested so that scripts can't change the scene in the middle of it.
+	m_broadphase.FindPairs(m_broadphasePairs);
+	m_stats.AddCount(FRAME_COUNTER_PAIR_TESTS, static_cast<unsigned int>(m_broadphasePairs.size()));
+
+	m_contacts.BeginFrame();
+
+	for (int pairIndex = 0; pairIndex < static_cast<int>(m_broadphasePairs.size()); pairIndex++)
 	{
-		V_SAFE_DELETE( m_sprites[index] );
-		m_sprites.RemoveAt(index);
+		const SpatialHash2D::Pair &pair = m_broadphasePairs[pairIndex];
+
+		Sprite *sprite = static_cast<Sprite*>( m_broadphase.GetUserData(pair.proxyA) );
+		Sprite *otherSprite = static_cast<Sprite*>( m_broadphase.GetUserData(pair.proxyB) );
+
+		// Sweeping sprites are also tested along their move, see UpdateBroadphase
+		float contactTime;
+		if (sprite->IsOverlappingSwept(otherSprite, contactTime))
+		{
+			m_contacts.AddContact(sprite->GetUniqueID(), pair.proxyA, otherSprite->GetUniqueID(), pair.proxyB, contactTime);
+			m_stats.AddCount(FRAME_COUNTER_HITS);
+		}
 	}
+
+	m_contacts.EndFrame();
+	DispatchCollisionEvents();
 }
 
-int Toolset2dManager::GetNumSprites()
+void Toolset2dManager::DispatchCollisionEvents()
 {
-	return m_sprites.GetLength();
+	if (m_collisionEventBatchingEnabled)
+	{
+		DispatchBatchedCollisionEvents();
+		return;
+	}
+
+	for (int eventIndex = 0; eventIndex < m_contacts.GetNumEvents(); eventIndex++)
+	{
+		const Contact2D &contact = m_contacts.GetEvent(eventIndex);
+		if (contact.state == CONTACT_STAY && !m_collisionStayEventEnabled)
+		{
+			continue;
+		}
+
+		// Look the sprites up before each call since a callback may have removed one of them
+		for (int side = 0; side < 2; side++)
+		{
+			Sprite *sprite = GetContactSprite(contact.proxyA, contact.idA);
+			Sprite *otherSprite = GetContactSprite(contact.proxyB, contact.idB);
+			if (sprite == NULL || otherSprite == NULL)
+			{
+				break;
+			}
+
+			if (side == 1)
+			{
+				std::swap(sprite, otherSprite);
+			}
+
+			switch (contact.state)
+			{
+			case CONTACT_BEGIN:
+				sprite->OnCollision(otherSprite, contact.time);
+				break;
+			case CONTACT_STAY:
+				sprite->OnCollisionStay(otherSprite);
+				break;
+			case CONTACT_END:
+				sprite->OnCollisionEnd(otherSprite);
+				break;
+			}
+		}
+	}
 }
 
-const SpriteData *Toolset2dManager::GetSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename)
+void Toolset2dManager::DispatchBatchedCollisionEvents()
 {
-	for (int spriteDataIndex = 0; spriteDataIndex < m_spriteData.GetSize(); spriteDataIndex++)
+	// Gather both sides of every contact and group them by the sprite that gets the event
+	m_spriteContacts.clear();
+
+	for (int eventIndex = 0; eventIndex < m_contacts.GetNumEvents(); eventIndex++)
 	{
-		const SpriteData *data = m_spriteData[spriteDataIndex];
-		if (data->spriteSheetFilename == spriteSheetFilename &&
-			data->xmlDataFilename == xmlDataFilename)
+		const Contact2D &contact = m_contacts.GetEvent(eventIndex);
+		if (contact.state == CONTACT_STAY && !m_collisionStayEventEnabled)
 		{
-			return data;
+			continue;
 		}
+
+		SpriteContact spriteContact;
+		spriteContact.state = contact.state;
+		spriteContact.time = contact.time;
+
+		spriteContact.uniqueId = contact.idA;
+		spriteContact.proxy = contact.proxyA;
+		spriteContact.otherUniqueId = contact.idB;
+		spriteContact.otherProxy = contact.proxyB;
+		m_spriteContacts.push_back(spriteContact);
+
+		spriteContact.uniqueId = contact.idB;
+		spriteContact.proxy = contact.proxyB;
+		spriteContact.otherUniqueId = contact.idA;
+		spriteContact.otherProxy = contact.proxyA;
+		m_spriteContacts.push_back(spriteContact);
 	}
 
-	SpriteData *spriteData = NULL;
+	std::stable_sort(m_spriteContacts.begin(), m_spriteContacts.end(), IsContactOrderedBefore);
 
-	VTextureObject *spSpriteSheetTexture = Vision::TextureManager.Load2DTexture(spriteSheetFilename);
-	if (spSpriteSheetTexture && spSpriteSheetTexture->GetTextureType() == VTextureLoader::Texture2D)
+	int groupBegin = 0;
+	while (groupBegin < static_cast<int>(m_spriteContacts.size()))
 	{
-		spriteData = new SpriteData();
-		m_spriteData.Append(spriteData);
+		const __int64 uniqueId = m_spriteContacts[groupBegin].uniqueId;
 
-		spriteData->sourceWidth = 0.f;
-		spriteData->sourceHeight = 0.f;
+		int groupEnd = groupBegin + 1;
+		while (groupEnd < static_cast<int>(m_spriteContacts.size()) && m_spriteContacts[groupEnd].uniqueId == uniqueId)
+		{
+			groupEnd++;
+		}
 
-		spriteData->spriteSheetFilename = spriteSheetFilename;
-		spriteData->xmlDataFilename = xmlDataFilename;
+		// A callback may have removed this sprite already
+		Sprite *sprite = GetContactSprite(m_spriteContacts[groupBegin].proxy, uniqueId);
+		if (sprite != NULL)
+		{
+			m_eventContactsBegin = groupBegin;
+			m_numEventContacts = groupEnd - groupBegin;
 
-		// Go ahead and add a reference to this texture
-		spriteData->spriteSheetTexture = spSpriteSheetTexture;
-		spriteData->spriteSheetTexture->AddRef();
+			sprite->OnCollisions(m_numEventContacts);
 
-		// #todo #jve : Perhaps it's a bit weird to have a spritesheet that also has animations on it--all of the cells
-		//              would have to be in the same places for each sheet, which is odd. Probably assert when there is
-		//              XML document AND a texture animation.
-		spriteData->textureAnimation = Vision::TextureManager.GetAnimationInstance(spriteData->spriteSheetTexture);
-		if (spriteData->textureAnimation)
-		{
-			spriteData->textureAnimation->AddRef();
+			m_numEventContacts = 0;
 		}
 
-		TiXmlDocument xmlDocument;
+		groupBegin = groupEnd;
+	}
+}
+
+Sprite *Toolset2dManager::GetContactSprite(int proxy, __int64 uniqueId) const
+{
+	// Proxies get recycled, so make sure it's still the same sprite
+	Sprite *sprite = static_cast<Sprite*>( m_broadphase.GetUserData(proxy) );
+	if (sprite != NULL && sprite->GetUniqueID() != uniqueId)
+	{
+		sprite = NULL;
+	}
+	return sprite;
+}
+
+void Toolset2dManager::UpdateAnimations(float deltaTime)
+{
+	ScopedFrameTimer animationTimer(m_stats, FRAME_TIMER_ANIMATION);
+
+	m_animationEvents.clear();
+	m_animations.Advance(deltaTime, m_animationEvents);
 
-		// If we successfully load the XML, then there is data we can parse about the sprites in the sheet
-		if ( xmlDocument.LoadFile(xmlDataFilename) )
+	// A script may remove any sprite while the events are sent, those don't get theirs
+	for (int eventIndex = 0; eventIndex < static_cast<int>(m_animationEvents.size()); eventIndex++)
+	{
+		const AnimationEvent2D &animationEvent = m_animationEvents[eventIndex];
+		if (m_animations.GetUserData(animationEvent.animation) == animationEvent.userData &&
+			m_animations.IsEnabled(animationEvent.animation))
 		{
-			const char *szActionNode = "SubTexture";
-			TiXmlElement *rootElement = xmlDocument.RootElement();
+			static_cast<Sprite*>(animationEvent.userData)->OnAnimationEnd(animationEvent.numLoops);
+		}
+	}
+}
 
-			rootElement->QueryFloatAttribute("width", &spriteData->sourceWidth);
-			rootElement->QueryFloatAttribute("height", &spriteData->sourceHeight);
+void Toolset2dManager::UpdateSprites(const hkvAlignedBBox *viewportBoundingBox)
+{
+	ScopedFrameTimer spritesTimer(m_stats, FRAME_TIMER_SPRITES);
 
-			for (TiXmlElement *pNode = rootElement->FirstChildElement(szActionNode);
-				pNode != NULL;
-				pNode = pNode->NextSiblingElement(szActionNode) )
-			{
-				const char *name = pNode->Attribute("name");
-
-				int x;
-				int y;
-				int width;
-				int height;
-				int originalWidth;
-				int originalHeight;
-				int ox;
-				int oy;
-
-				pNode->QueryIntAttribute("x", &x);
-				pNode->QueryIntAttribute("y", &y);
-				pNode->QueryIntAttribute("width", &width);
-				pNode->QueryIntAttribute("height", &height);
-				pNode->QueryIntAttribute("original_width", &originalWidth);
-				pNode->QueryIntAttribute("original_height", &originalHeight);
-				pNode->QueryIntAttribute("ox", &ox);
-				pNode->QueryIntAttribute("oy", &oy);
-
-				const int newCellIndex = spriteData->cells.Append(SpriteCell());
-				SpriteCell *currentCell = &spriteData->cells[newCellIndex];
-				currentCell->name = name;
-				currentCell->offset.x = static_cast<float>(x);
-				currentCell->offset.y = static_cast<float>(y);
-				currentCell->pivot.x = static_cast<float>(ox);
-				currentCell->pivot.y = static_cast<float>(oy);
-				currentCell->width = static_cast<float>(width);
-				currentCell->height = static_cast<float>(height);
-				currentCell->originalWidth = static_cast<float>(originalWidth);
-				currentCell->originalHeight = static_cast<float>(originalHeight);
-
-				const char *result = strrchr(name, '_');
-				int index = -1;
-				if (result != NULL)
-				{
-					index = result - name;
-				}
+	const int numSprites = static_cast<int>(m_updateSprites.size());
 
-				SpriteState *state = NULL;
-				int stateIndex = -1;
-				if (index == -1)
-				{
-					const char *extension = strrchr(name, '.');
-					int extensionIndex = -1;
-					if (extension != NULL)
-						extensionIndex = extension - name;
-					VString stateName = VString(name, extensionIndex);
-
-					stateIndex = spriteData->states.Append(SpriteState());
-					state = &spriteData->states[stateIndex];
-					state->name = stateName;
-					state->framerate = 30.0f;
-					spriteData->stateNameToIndex.Set(state->name, stateIndex);
-				}
-				else
-				{
-					VString s = name;
-					VString stateName = VString(name, index);
-					VString last = VString(&name[index + 1], strlen(name) - index);
-					VString number = VString(last.GetChar(), last.Find("."));
-					currentCell->index = atoi(number);
+	int numThreads = m_updateThreadCount;
+	if (numThreads == 0)
+	{
+		// The main thread helps out while it waits for the workers
+		numThreads = Vision::GetThreadManager()->GetThreadCount() + 1;
+	}
 
-					for (int i = 0; i < spriteData->states.GetSize(); i++)
-					{
-						if (spriteData->states[i].name == stateName)
-						{
-							stateIndex = i;
-							state = &spriteData->states[i];
-							break;
-						}
-					}
+	const int numTasks = hkvMath::Min(numThreads * kUpdateTasksPerThread, numSprites / kMinSpritesPerUpdateTask);
+	if (numThreads <= 1 || numTasks <= 1)
+	{
+		UpdateSpriteRange(0, numSprites, viewportBoundingBox);
+		return;
+	}
 
-					if (stateIndex == -1)
-					{
-						stateIndex = spriteData->states.Append(SpriteState());
-						state = &spriteData->states[stateIndex];
-						state->name = stateName;
-						state->framerate = 10.f;
-						spriteData->stateNameToIndex.Set(state->name, stateIndex);
-					}
-				}
+	while (m_updateTasks.GetSize() < numTasks)
+	{
+		m_updateTasks.Append(new UpdateTask());
+	}
 
-				state->cells.Append(newCellIndex);
-			}
-		}
-		// No XML describing the sprite sheet, but we do have a sprite texture, so create a default
-		// state and cell for it
-		else
-		{
-			int stateIndex = spriteData->states.Append(SpriteState());
-			SpriteState *state = &spriteData->states[stateIndex];
-			state->name = spriteData->spriteSheetFilename;
-			state->framerate = 30.0f;
-			state->cells.Add(0);
-			spriteData->stateNameToIndex.Set(state->name, stateIndex);
+	// Chunks are a multiple of four sprites so that the corners are computed with SSE all
+	// the way through
+	const int chunkSize = ((numSprites + numTasks - 1) / numTasks + 3) & ~3;
+
+	int numScheduledTasks = 0;
+	for (int begin = 0; begin < numSprites; begin += chunkSize)
+	{
+		UpdateTask *task = m_updateTasks[numScheduledTasks++];
+		task->m_begin = begin;
+		task->m_end = hkvMath::Min(begin + chunkSize, numSprites);
+		task->m_viewportBoundingBox = viewportBoundingBox;
 
-			const int newCellIndex = spriteData->cells.Append(SpriteCell());
-			SpriteCell *currentCell = &spriteData->cells[newCellIndex];
+		Vision::GetThreadManager()->ScheduleTask(task, kUpdateTaskPriority);
+	}
 
-			char buffer[FS_MAX_PATH];
-			VFileHelper::GetFilenameNoExt(buffer, spriteData->spriteSheetFilename);
-			currentCell->name = buffer;
-			currentCell->offset.x = 0.f;
-			currentCell->offset.y = 0.f;
-			currentCell->pivot.x = 0.f;
-			currentCell->pivot.y = 0.f;
+	for (int taskIndex = 0; taskIndex < numScheduledTasks; taskIndex++)
+	{
+		Vision::GetThreadManager()->WaitForTask(m_updateTasks[taskIndex], true);
+	}
+}
 
-			float textureWidth = static_cast<float>(spriteData->spriteSheetTexture->GetTextureWidth());
-			float textureHeight = static_cast<float>(spriteData->spriteSheetTexture->GetTextureHeight());
+void Toolset2dManager::UpdateSpriteRange(int begin, int end, const hkvAlignedBBox *viewportBoundingBox)
+{
+	// Every sprite only writes to its own slot, so ranges can safely run side by side
+	for (int spriteIndex = begin; spriteIndex < end; spriteIndex++)
+	{
+		SpriteEntry &entry = m_sprites[spriteIndex];
 
-			spriteData->sourceWidth = currentCell->width = currentCell->originalWidth = textureWidth;
-			spriteData->sourceHeight = currentCell->height = currentCell->originalHeight = textureHeight;
+		SpriteQuad2D quad;
+		if (m_updateSprites[spriteIndex]->BuildQuad(quad))
+		{
+			m_quads.SetQuad(spriteIndex, quad);
+			entry.quadIndex = spriteIndex;
+		}
+		else
+		{
+			entry.quadIndex = -1;
 		}
-
-		spriteData->GenerateConvexHull();
 	}
 
-	return spriteData;
+	m_quads.ComputeCorners(begin, end);
+
+	for (int spriteIndex = begin; spriteIndex < end; spriteIndex++)
+	{
+		const SpriteEntry &entry = m_sprites[spriteIndex];
+		if (entry.quadIndex != -1)
+		{
+			float cornersX[QUAD_NUM_CORNERS];
+			float cornersY[QUAD_NUM_CORNERS];
+			m_quads.GetCorners(entry.quadIndex, cornersX, cornersY);
+			m_updateSprites[spriteIndex]->SetCorners(cornersX, cornersY, viewportBoundingBox);
+		}
+	}
 }
 
-void Toolset2dManager::RegisterLua()
+void Toolset2dManager::UpdateBroadphase(Sprite *sprite)
 {
-	IVScriptManager* pSM = Vision::GetScriptManager();
-	if (pSM != NULL)
+	// Sprites without any data don't have valid vertices yet, and sprites with an empty
+	// layer or mask can never collide with anything
+	if (sprite->IsColliding() &&
+		sprite->GetCurrentState() != NULL &&
+		sprite->GetCollisionLayer() != 0 &&
+		sprite->GetCollisionMask() != 0)
 	{
-		lua_State* pLuaState = static_cast<VScriptResourceManager*>(pSM)->GetMasterState();
-		if (pLuaState)
+		const hkvAlignedBBox bbox = sprite->GetBBox();
+
+		Aabb2D box;
+		box.minX = bbox.m_vMin.x;
+		box.minY = bbox.m_vMin.y;
+		box.maxX = bbox.m_vMax.x;
+		box.maxY = bbox.m_vMax.y;
+
+		// The box of a sweeping sprite reaches back to where it was, so that the pairs
+		// include everything it passed on the way
+		if (sprite->IsSweeping())
 		{
-			luaopen_Toolset2dModule(pLuaState);
+			const hkvVec2 &sweep = sprite->GetSweep();
+			box.minX = hkvMath::Min(box.minX, box.minX - sweep.x);
+			box.minY = hkvMath::Min(box.minY, box.minY - sweep.y);
+			box.maxX = hkvMath::Max(box.maxX, box.maxX - sweep.x);
+			box.maxY = hkvMath::Max(box.maxY, box.maxY - sweep.y);
+		}
 
-			int iRetParams = LUA_CallStaticFunction(pLuaState, "Toolset2dModule", "Toolset2dManager", "Cast", "v>v", Toolset2dManager::Instance());
-			if (iRetParams==1)
-			{
-				if(lua_isnil(pLuaState, -1))
-				{
-					lua_pop(pLuaState, iRetParams);
-				}
-				else
-				{
-					lua_setglobal(pLuaState, "Toolset2D");
-				}
-			}
+		if (sprite->GetBroadphaseProxy() == -1)
+		{
+			sprite->SetBroadphaseProxy( m_broadphase.CreateProxy(box, sprite, sprite->GetCollisionLayer(), sprite->GetCollisionMask()) );
 		}
 		else
 		{
-			Vision::Error.AddReportEntry(VIS_REPORTENTRY_WARNING, "Toolset2D", "Unable to create Lua Sprite Module, lua_State is NULL!", "");
+			m_broadphase.UpdateProxy(sprite->GetBroadphaseProxy(), box);
+			m_broadphase.SetProxyFilter(sprite->GetBroadphaseProxy(), sprite->GetCollisionLayer(), sprite->GetCollisionMask());
 		}
 	}
+	else
+	{
+		RemoveFromBroadphase(sprite);
+	}
 }
 
-Sprite *Toolset2dManager::CreateSprite(const hkvVec3 &position, const char *spriteSheetFilename, const char *xmlDataFilename)
+void Toolset2dManager::RemoveFromBroadphase(Sprite *sprite)
 {
-	Sprite *sprite = (Sprite *)Vision::Game.CreateEntity( "Sprite", hkvVec3::ZeroVector() );
-	if (sprite != NULL)
+	if (sprite->GetBroadphaseProxy() != -1)
 	{
-		sprite->SetSpriteSheetData(spriteSheetFilename, xmlDataFilename);
-		sprite->SetCenterPosition(position);
+		m_broadphase.DestroyProxy(sprite->GetBroadphaseProxy());
+		sprite->SetBroadphaseProxy(-1);
 	}
-	return sprite;
 }
 
-void Toolset2dManager::SetCamera(Camera2D *camera)
+void Toolset2dManager::AddSprite(Sprite *sprite)
 {
-	m_camera = camera;
+	if (FindSprite(sprite) == -1)
+	{
+		SpriteEntry entry;
+		entry.sprite = sprite;
+		entry.depth = sprite->GetPosition().z;
+		entry.uniqueId = sprite->GetUniqueID();
+		entry.quadIndex = -1;
+
+		sprite->SetRegistryIndex( static_cast<int>(m_sprites.size()) );
+		m_sprites.push_back(entry);
+		m_numDepthChanges++;
+
+		m_animations.SetEnabled(sprite->GetAnimation(), true);
+	}
 }
 
-Camera2D *Toolset2dManager::GetCamera()
+int Toolset2dManager::FindSprite(Sprite *sprite)
 {
-	return m_camera;
+	const int index = sprite->GetRegistryIndex();
+	if (index >= 0 && index < static_cast<int>(m_sprites.size()) && m_sprites[index].sprite == sprite)
+	{
+		return index;
+	}
+	return -1;
 }
 
-#if USE_HAVOK_PHYSICS_2D
-hkpWorld *Toolset2dManager::GetPhysicsWorld()
+void Toolset2dManager::RemoveSprite(Sprite *sprite)
 {
-	return m_world;
+	RemoveFromBroadphase(sprite);
+
+	const int index = FindSprite(sprite);
+	if (index != -1)
+	{
+		// Leave a hole instead of shifting everything behind it, the next update closes it
+		m_sprites[index].sprite = NULL;
+		m_sprites[index].quadIndex = -1;
+		m_numRemovedSprites++;
+
+		sprite->SetRegistryIndex(-1);
+		m_animations.SetEnabled(sprite->GetAnimation(), false);
+	}
 }
-#endif // USE_HAVOK_PHYSICS_2D
 
-//----- functions
+void Toolset2dManager::CompactSprites()
+{
+	if (m_numRemovedSprites == 0)
+	{
+		return;
+	}
+
+	// Moving the remaining sprites down in a single pass keeps them in depth order
+	int numSprites = 0;
+	for (int spriteIndex = 0; spriteIndex < static_cast<int>(m_sprites.size()); spriteIndex++)
+	{
+		const SpriteEntry &entry = m_sprites[spriteIndex];
+		if (entry.sprite != NULL)
+		{
+			if (numSprites != spriteIndex)
+			{
+				m_sprites[numSprites] = entry;
+				entry.sprite->SetRegistryIndex(numSprites);
+			}
+			numSprites++;
+		}
+	}
+
+	m_sprites.resize(numSprites);
+	m_numRemovedSprites = 0;
+}
 
-static int compareSprites(const void *arg1, const void *arg2)
+int Toolset2dManager::GetNumSprites()
 {
-	VWeakPtr<VisBaseEntity_cl> *pSort1 = *((VWeakPtr<VisBaseEntity_cl> **)arg1);
-	VWeakPtr<VisBaseEntity_cl> *pSort2 = *((VWeakPtr<VisBaseEntity_cl> **)arg2);
+	return static_cast<int>(m_sprites.size()) - m_numRemovedSprites;
+}
 
-	Sprite *pSprite1 = (Sprite *)pSort1->GetPtr();
-	Sprite *pSprite2 = (Sprite *)pSort2->GetPtr();
+const SpriteData *Toolset2dManager::GetSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename)
+{
+	// Every sprite starts out without a sheet, don't bother the texture manager with it
+	if (spriteSheetFilename.IsEmpty())
+	{
+		return NULL;
+	}
 
-	int result = 0;
+	const unsigned int hash = HashPath2D(xmlDataFilename, HashPath2D(spriteSheetFilename));
 
-	if (pSprite1 && pSprite2)
+	const int spriteDataIndex = FindSpriteData(spriteSheetFilename, xmlDataFilename, hash);
+	if (spriteDataIndex != -1)
 	{
-		float a = pSprite1->GetPosition().z;
-		float b = pSprite2->GetPosition().z;
-		
-		if (hkvMath::isFloatEqual(a, b))
-		{
-			__int64 id1 = pSprite1->GetUniqueID();
-			__int64 id2 = pSprite2->GetUniqueID();
-			result = static_cast<int>(id2 - id1);
-		}
-		else
+		SpriteData *data = m_spriteData[spriteDataIndex];
+		if (data->loadState == SPRITE_DATA_LOADING)
 		{
-			result = (b > a) ? -1 : 1;
+			PublishSpriteData(data);
 		}
+		return data->IsLoaded() ? data : NULL;
+	}
+
+	SpriteData *spriteData = CreateSpriteData(spriteSheetFilename, xmlDataFilename, hash);
+	const bool described = spriteData->LoadDescription();
+
+	// Nothing is kept if the texture can't be loaded, so it is tried again next time
+	if ( !FinishSpriteData(spriteData, described) )
+	{
+		RemoveSpriteDataAt( FindSpriteData(spriteData) );
+		return NULL;
+	}
+
+	return spriteData;
+}
+
+const SpriteData *Toolset2dManager::RequestSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename)
+{
+	if (spriteSheetFilename.IsEmpty())
+	{
+		return NULL;
+	}
+
+	const unsigned int hash = HashPath2D(xmlDataFilename, HashPath2D(spriteSheetFilename));
+
+	const int spriteDataIndex = FindSpriteData(spriteSheetFilename, xmlDataFilename, hash);
+	if (spriteDataIndex != -1)
+	{
+		const SpriteData *data = m_spriteData[spriteDataIndex];
+		return (data->loadState != SPRITE_DATA_FAILED) ? data : NULL;
+	}
+
+	SpriteData *spriteData = CreateSpriteData(spriteSheetFilename, xmlDataFilename, hash);
+
+	LoadTask *task = new LoadTask(spriteData);
+	m_loadTasks.Append(task);
+	m_numBackgroundLoads++;
+	Vision::GetThreadManager()->ScheduleTask(task, kLoadTaskPriority);
+
+	return spriteData;
+}
+
+SpriteData *Toolset2dManager::CreateSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename, unsigned int hash)
+{
+	SpriteData *spriteData = new SpriteData();
+	spriteData->hash = hash;
+	spriteData->spriteSheetFilename = spriteSheetFilename;
+	spriteData->xmlDataFilename = xmlDataFilename;
+
+	m_spriteDataIndex.Add( hash, m_spriteData.Append(spriteData) );
+
+	return spriteData;
+}
+
+bool Toolset2dManager::FinishSpriteData(SpriteData *spriteData, bool described)
+{
+	m_stats.AddCount(FRAME_COUNTER_SHEET_LOADS);
+
+	if (spriteData->invalidBinary)
+	{
+		Vision::Error.Warning("Toolset2D: '%s' is not a valid sprite sheet, using the XML instead",
+			GetSpriteSheetBinaryFilename(spriteData->xmlDataFilename).AsChar());
+	}
+
+	VTextureObject *spSpriteSheetTexture = Vision::TextureManager.Load2DTexture(spriteData->spriteSheetFilename);
+	if (!spSpriteSheetTexture || spSpriteSheetTexture->GetTextureType() != VTextureLoader::Texture2D)
+	{
+		spriteData->loadState = SPRITE_DATA_FAILED;
+		return false;
+	}
+
+	// Go ahead and add a reference to this texture
+	spriteData->spriteSheetTexture = spSpriteSheetTexture;
+	spriteData->spriteSheetTexture->AddRef();
+
+	// #todo #jve : Perhaps it's a bit weird to have a spritesheet that also has animations on it--all of the cells
+	//              would have to be in the same places for each sheet, which is odd. Probably assert when there is
+	//              XML document AND a texture animation.
+	spriteData->textureAnimation = Vision::TextureManager.GetAnimationInstance(spriteData->spriteSheetTexture);
+	if (spriteData->textureAnimation)
+	{
+		spriteData->textureAnimation->AddRef();
+	}
+
+	// No data describing the sprite sheet, but we do have a sprite texture, so create a
+	// default state and cell for it
+	if (!described)
+	{
+		int stateIndex = spriteData->states.Append(SpriteState());
+		SpriteState *state = &spriteData->states[stateIndex];
+		state->name = spriteData->spriteSheetFilename;
+		state->framerate = 30.0f;
+		state->cells.Add(0);
+		spriteData->stateNameToIndex.Set(state->name, stateIndex);
+
+		const int newCellIndex = spriteData->cells.Append(SpriteCell());
+		SpriteCell *currentCell = &spriteData->cells[newCellIndex];
+
+		char buffer[FS_MAX_PATH];
+		VFileHelper::GetFilenameNoExt(buffer, spriteData->spriteSheetFilename);
+		currentCell->name = buffer;
+		currentCell->offset.x = 0.f;
+		currentCell->offset.y = 0.f;
+		currentCell->pivot.x = 0.f;
+		currentCell->pivot.y = 0.f;
+
+		float textureWidth = static_cast<float>(spriteData->spriteSheetTexture->GetTextureWidth());
+		float textureHeight = static_cast<float>(spriteData->spriteSheetTexture->GetTextureHeight());
+
+		spriteData->sourceWidth = currentCell->width = currentCell->originalWidth = textureWidth;
+		spriteData->sourceHeight = currentCell->height = currentCell->originalHeight = textureHeight;
+	}
+
+	spriteData->UpdateFrameTimes();
+	spriteData->GenerateConvexHull();
+
+	if (m_textureAtlasEnabled)
+	{
+		AddToTextureAtlas(spriteData);
+	}
+
+	spriteData->loadState = SPRITE_DATA_LOADED;
+	return true;
+}
+
+void Toolset2dManager::BeginSceneLoad(const char *sceneFilename)
+{
+	m_sceneFilename = sceneFilename;
+	m_sceneLoadStartTime = VGLGetTimer();
+	m_timeToFirstFrame = 0.f;
+
+	// Loads that are still running from before count towards this scene
+	m_numBackgroundLoads = m_loadTasks.GetSize();
+
+	LoadSpriteSheetManifest( GetSpriteSheetManifestFilename(m_sceneFilename) );
+}
+
+void Toolset2dManager::EndSceneLoad()
+{
+	const uint64 elapsed = VGLGetTimer() - m_sceneLoadStartTime;
+	m_timeToFirstFrame = static_cast<float>( static_cast<double>(elapsed) * 1000.0 / static_cast<double>(VGLGetTimerResolution()) );
+	m_sceneLoadStartTime = 0;
+
+	Vision::Error.SystemMessage("Toolset2D: first frame of '%s' drawn after %.1f ms, %d sprite sheets loaded in the background",
+		m_sceneFilename.AsChar(), m_timeToFirstFrame, m_numBackgroundLoads);
+}
+
+void Toolset2dManager::PublishSpriteData(bool wait)
+{
+	// Without any worker threads the tasks only run while they are waited on
+	if (Vision::GetThreadManager()->GetThreadCount() == 0)
+	{
+		wait = true;
+	}
+
+	int taskIndex = 0;
+	while (taskIndex < m_loadTasks.GetSize())
+	{
+		LoadTask *task = m_loadTasks[taskIndex];
+		if (wait || task->GetState() == TASKSTATE_FINISHED)
+		{
+			PublishSpriteData(task->m_spriteData);
+		}
+		else
+		{
+			taskIndex++;
+		}
+	}
+
+	SendSpriteSheetLoadedEvents();
+}
+
+void Toolset2dManager::PublishSpriteData(SpriteData *spriteData)
+{
+	LoadTask *task = NULL;
+	for (int taskIndex = 0; taskIndex < m_loadTasks.GetSize(); taskIndex++)
+	{
+		if (m_loadTasks[taskIndex]->m_spriteData == spriteData)
+		{
+			task = m_loadTasks[taskIndex];
+			m_loadTasks.RemoveAt(taskIndex);
+			break;
+		}
+	}
+
+	VASSERT(task != NULL);
+	if (task == NULL)
+	{
+		return;
+	}
+
+	Vision::GetThreadManager()->WaitForTask(task, true);
+	FinishSpriteData(spriteData, task->m_described);
+	V_SAFE_DELETE(task);
+
+	// GetSpriteData can get here from anywhere, so the events wait for the next update.
+	// The reference keeps the data around until then, even if loading failed.
+	AddSpriteDataReference(spriteData);
+	m_publishedSpriteData.Append(spriteData);
+}
+
+void Toolset2dManager::SendSpriteSheetLoadedEvents()
+{
+	IVScriptManager *pScriptManager = Vision::GetScriptManager();
+	IVScriptInstance *pSceneScript = (pScriptManager != NULL) ? pScriptManager->GetSceneScript() : NULL;
+
+	// Sheets that handlers load themselves are sent along in the same pass
+	for (int spriteDataIndex = 0; spriteDataIndex < m_publishedSpriteData.GetSize(); spriteDataIndex++)
+	{
+		const SpriteData *spriteData = m_publishedSpriteData[spriteDataIndex];
+		const bool success = spriteData->IsLoaded();
+
+		SpriteSheetLoadedDataObject data(&OnSpriteSheetLoaded, spriteData, success);
+		OnSpriteSheetLoaded.TriggerCallbacks(&data);
+
+		if (pSceneScript != NULL && pSceneScript->HasFunction("OnSpriteSheetLoaded"))
+		{
+			pSceneScript->ExecuteFunctionArg("OnSpriteSheetLoaded", "ssb",
+				spriteData->spriteSheetFilename.AsChar(), spriteData->xmlDataFilename.AsChar(), success);
+		}
+
+		ReleaseSpriteData(spriteData);
+	}
+	m_publishedSpriteData.RemoveAll();
+}
+
+void Toolset2dManager::CancelSpriteDataLoads()
+{
+	// Nothing is published, the data goes away with the scene
+	for (int taskIndex = 0; taskIndex < m_loadTasks.GetSize(); taskIndex++)
+	{
+		Vision::GetThreadManager()->WaitForTask(m_loadTasks[taskIndex], true);
+		m_loadTasks[taskIndex]->m_spriteData->loadState = SPRITE_DATA_FAILED;
+		V_SAFE_DELETE( m_loadTasks[taskIndex] );
+	}
+	m_loadTasks.RemoveAll();
+	m_publishedSpriteData.RemoveAll();
+}
+
+VString Toolset2dManager::GetSpriteSheetManifestFilename(const VString &sceneFilename)
+{
+	if ( sceneFilename.IsEmpty() )
+	{
+		return VString();
+	}
+
+	// Cut the file name at its first dot so every platform's export shares the manifest
+	const char *path = sceneFilename.AsChar();
+	const char *filename = path;
+	for (const char *character = path; *character != '\0'; character++)
+	{
+		if (*character == '/' || *character == '\\')
+		{
+			filename = character + 1;
+		}
+	}
+
+	const char *extension = strchr(filename, '.');
+	const int baseLength = (extension != NULL) ? static_cast<int>(extension - path) : sceneFilename.GetLen();
+
+	VString manifestFilename = VString(path, baseLength);
+	manifestFilename += ".spritesheets.xml";
+	return manifestFilename;
+}
+
+VString Toolset2dManager::GetSpriteSheetBinaryFilename(const VString &xmlDataFilename)
+{
+	if ( xmlDataFilename.IsEmpty() )
+	{
+		return VString();
+	}
+
+	// Only replace an extension of the file name itself, not a dot in one of the folders
+	const char *filename = xmlDataFilename.AsChar();
+	const char *extension = strrchr(filename, '.');
+	if ( extension != NULL && (strchr(extension, '/') != NULL || strchr(extension, '\\') != NULL) )
+	{
+		extension = NULL;
+	}
+
+	const int baseLength = (extension != NULL) ? static_cast<int>(extension - filename) : xmlDataFilename.GetLen();
+
+	VString binaryFilename = VString(filename, baseLength);
+	binaryFilename += ".sheet";
+	return binaryFilename;
+}
+
+void Toolset2dManager::RegisterLua()
+{
+	IVScriptManager* pSM = Vision::GetScriptManager();
+	if (pSM != NULL)
+	{
+		lua_State* pLuaState = static_cast<VScriptResourceManager*>(pSM)->GetMasterState();
+		if (pLuaState)
+		{
+			luaopen_Toolset2dModule(pLuaState);
+
+			int iRetParams = LUA_CallStaticFunction(pLuaState, "Toolset2dModule", "Toolset2dManager", "Cast", "v>v", Toolset2dManager::Instance());
+			if (iRetParams==1)
+			{
+				if(lua_isnil(pLuaState, -1))
+				{
+					lua_pop(pLuaState, iRetParams);
+				}
+				else
+				{
+					lua_setglobal(pLuaState, "Toolset2D");
+				}
+			}
+		}
+		else
+		{
+			Vision::Error.AddReportEntry(VIS_REPORTENTRY_WARNING, "Toolset2D", "Unable to create Lua Sprite Module, lua_State is NULL!", "");
+		}
+	}
+}
+
+Sprite *Toolset2dManager::CreateSprite(const hkvVec3 &position, const char *spriteSheetFilename, const char *xmlDataFilename)
+{
+	Sprite *sprite = (Sprite *)Vision::Game.CreateEntity( "Sprite", hkvVec3::ZeroVector() );
+	if (sprite != NULL)
+	{
+		sprite->SetSpriteSheetData(spriteSheetFilename, xmlDataFilename);
+		sprite->SetCenterPosition(position);
+	}
+	return sprite;
+}
+
+void Toolset2dManager::AddSpriteDataReference(const SpriteData *spriteData)
+{
+	const int spriteDataIndex = FindSpriteData(spriteData);
+	if (spriteDataIndex != -1)
+	{
+		m_spriteData[spriteDataIndex]->refCount++;
+	}
+}
+
+void Toolset2dManager::ReleaseSpriteData(const SpriteData *spriteData)
+{
+	const int spriteDataIndex = FindSpriteData(spriteData);
+	if (spriteDataIndex != -1)
+	{
+		SpriteData *spriteData = m_spriteData[spriteDataIndex];
+		VASSERT(spriteData->refCount > 0);
+		spriteData->refCount--;
+
+		// Like with GetSpriteData a failed load isn't kept, so it can be requested again
+		if (spriteData->refCount == 0 && spriteData->loadState == SPRITE_DATA_FAILED)
+		{
+			RemoveSpriteDataAt(spriteDataIndex);
+		}
+	}
+}
+
+int Toolset2dManager::EvictUnusedSpriteData()
+{
+	int numEvicted = 0;
+
+	// Walk backwards since the last entry is moved into the freed slot
+	for (int spriteDataIndex = m_spriteData.GetSize() - 1; spriteDataIndex >= 0; spriteDataIndex--)
+	{
+		// Data still being written by a worker has to wait for the next call
+		if (m_spriteData[spriteDataIndex]->refCount == 0 &&
+			m_spriteData[spriteDataIndex]->loadState != SPRITE_DATA_LOADING)
+		{
+			RemoveSpriteDataAt(spriteDataIndex);
+			numEvicted++;
+		}
+	}
+
+	return numEvicted;
+}
+
+int Toolset2dManager::GetNumSpriteSheets() const
+{
+	return m_spriteData.GetSize();
+}
+
+void Toolset2dManager::SetAsyncLoadingEnabled(bool enabled)
+{
+	m_asyncLoadingEnabled = enabled;
+}
+
+bool Toolset2dManager::IsAsyncLoadingEnabled() const
+{
+	return m_asyncLoadingEnabled;
+}
+
+bool Toolset2dManager::PreloadSpriteSheet(const char *spriteSheetFilename, const char *xmlDataFilename)
+{
+	return ( RequestSpriteData(spriteSheetFilename, xmlDataFilename) != NULL );
+}
+
+bool Toolset2dManager::IsSpriteSheetLoaded(const char *spriteSheetFilename, const char *xmlDataFilename)
+{
+	const VString sheet(spriteSheetFilename);
+	const VString xml(xmlDataFilename);
+
+	const int spriteDataIndex = FindSpriteData( sheet, xml, HashPath2D(xml, HashPath2D(sheet)) );
+	return ( spriteDataIndex != -1 && m_spriteData[spriteDataIndex]->IsLoaded() );
+}
+
+int Toolset2dManager::GetNumPendingSpriteSheets() const
+{
+	return m_loadTasks.GetSize();
+}
+
+int Toolset2dManager::LoadSpriteSheetManifest(const char *manifestFilename)
+{
+	TiXmlDocument xmlDocument;
+
+	// Scenes without any sprites don't have a manifest
+	if ( manifestFilename == NULL || manifestFilename[0] == '\0' || !xmlDocument.LoadFile(manifestFilename) )
+	{
+		return 0;
+	}
+
+	TiXmlElement *rootElement = xmlDocument.RootElement();
+	if (rootElement == NULL)
+	{
+		return 0;
+	}
+
+	int numSpriteSheets = 0;
+
+	for (TiXmlElement *pNode = rootElement->FirstChildElement("SpriteSheet");
+		pNode != NULL;
+		pNode = pNode->NextSiblingElement("SpriteSheet") )
+	{
+		const char *spriteSheetFilename = pNode->Attribute("spriteSheetFilename");
+		const char *xmlDataFilename = pNode->Attribute("xmlDataFilename");
+
+		if ( RequestSpriteData(spriteSheetFilename, (xmlDataFilename != NULL) ? xmlDataFilename : "") != NULL )
+		{
+			numSpriteSheets++;
+		}
+	}
+
+	return numSpriteSheets;
+}
+
+float Toolset2dManager::GetSpriteSheetLoadProgress() const
+{
+	if (m_numBackgroundLoads == 0)
+	{
+		return 1.0f;
+	}
+	return static_cast<float>(m_numBackgroundLoads - m_loadTasks.GetSize()) / static_cast<float>(m_numBackgroundLoads);
+}
+
+float Toolset2dManager::GetTimeToFirstFrame() const
+{
+	return m_timeToFirstFrame;
+}
+
+int Toolset2dManager::FindSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename, unsigned int hash) const
+{
+	// Only entries with the same hash are compared, so a hit compares the names just once
+	for (int spriteDataIndex = m_spriteDataIndex.First(hash); spriteDataIndex != -1; spriteDataIndex = m_spriteDataIndex.Next(spriteDataIndex))
+	{
+		const SpriteData *data = m_spriteData[spriteDataIndex];
+		if (data->hash == hash &&
+			data->spriteSheetFilename == spriteSheetFilename &&
+			data->xmlDataFilename == xmlDataFilename)
+		{
+			return spriteDataIndex;
+		}
+	}
+	return -1;
+}
+
+int Toolset2dManager::FindSpriteData(const SpriteData *spriteData) const
+{
+	if (spriteData != NULL)
+	{
+		for (int spriteDataIndex = m_spriteDataIndex.First(spriteData->hash); spriteDataIndex != -1; spriteDataIndex = m_spriteDataIndex.Next(spriteDataIndex))
+		{
+			if (m_spriteData[spriteDataIndex] == spriteData)
+			{
+				return spriteDataIndex;
+			}
+		}
+	}
+	return -1;
+}
+
+void Toolset2dManager::RemoveSpriteDataAt(int spriteDataIndex)
+{
+	SpriteData *spriteData = m_spriteData[spriteDataIndex];
+	m_spriteDataIndex.Remove(spriteData->hash, spriteDataIndex);
+
+	const int lastIndex = m_spriteData.GetSize() - 1;
+	if (spriteDataIndex != lastIndex)
+	{
+		SpriteData *lastSpriteData = m_spriteData[lastIndex];
+		m_spriteDataIndex.Remove(lastSpriteData->hash, lastIndex);
+		m_spriteDataIndex.Add(lastSpriteData->hash, spriteDataIndex);
+		m_spriteData[spriteDataIndex] = lastSpriteData;
+	}
+	m_spriteData.RemoveAt(lastIndex);
+
+	delete spriteData;
+}
+
+Sprite *Toolset2dManager::AcquireSprite(const hkvVec3 &position, const char *spriteSheetFilename, const char *xmlDataFilename)
+{
+	const int poolIndex = FindSpritePool(spriteSheetFilename, xmlDataFilename);
+	SpritePool &pool = m_spritePools[poolIndex];
+
+	Sprite *sprite = NULL;
+	if (!pool.sprites.empty())
+	{
+		sprite = pool.sprites.back();
+		pool.sprites.pop_back();
+		m_numPooledSprites--;
+
+		sprite->ResetToDefaults();
+		AddSprite(sprite);
+		sprite->SetCenterPosition(position);
+		sprite->ResumeScripts();
+
+		m_spritePoolHits++;
+	}
+	else
+	{
+		sprite = CreateSprite(position, spriteSheetFilename, xmlDataFilename);
+		if (sprite == NULL)
+		{
+			return NULL;
+		}
+
+		m_spritePoolMisses++;
+	}
+
+	sprite->SetSpritePool(poolIndex, false);
+	pool.numActive++;
+
+	m_numActivePooledSprites++;
+	m_spritePoolHighWater = hkvMath::Max(m_spritePoolHighWater, m_numActivePooledSprites);
+
+	return sprite;
+}
+
+void Toolset2dManager::ReleaseSprite(Sprite *sprite)
+{
+	if (sprite == NULL || sprite->IsInSpritePool())
+	{
+		return;
+	}
+
+	// The sheet may have changed since the sprite was acquired, so always go by its
+	// current one
+	RemoveFromSpritePool(sprite);
+	const int poolIndex = FindSpritePool(sprite->GetSpriteSheetFilename(), sprite->GetXmlDataFilename());
+
+	// Nothing about the sprite should run while it waits in the pool. Removing it takes
+	// it out of the broadphase and stops its animation, its rigid bodies leave the physics
+	// world, and script events are skipped for as long as it is pooled.
+	RemoveSprite(sprite);
+	sprite->SetSimulate(false, false);
+	sprite->PauseScripts();
+
+	sprite->SetSpritePool(poolIndex, true);
+	m_spritePools[poolIndex].sprites.push_back(sprite);
+	m_numPooledSprites++;
+}
+
+void Toolset2dManager::PrewarmSpritePool(const char *spriteSheetFilename, const char *xmlDataFilename, int count)
+{
+	const int poolIndex = FindSpritePool(spriteSheetFilename, xmlDataFilename);
+	const int numMissing = count - static_cast<int>(m_spritePools[poolIndex].sprites.size());
+
+	for (int spriteIndex = 0; spriteIndex < numMissing; spriteIndex++)
+	{
+		Sprite *sprite = CreateSprite(hkvVec3::ZeroVector(), spriteSheetFilename, xmlDataFilename);
+		if (sprite == NULL)
+		{
+			break;
+		}
+
+		ReleaseSprite(sprite);
+	}
+}
+
+void Toolset2dManager::RemoveFromSpritePool(Sprite *sprite)
+{
+	const int poolIndex = sprite->GetSpritePool();
+	if (poolIndex < 0 || poolIndex >= static_cast<int>(m_spritePools.size()))
+	{
+		return;
+	}
+
+	SpritePool &pool = m_spritePools[poolIndex];
+	if (sprite->IsInSpritePool())
+	{
+		std::vector<Sprite*>::iterator it = std::find(pool.sprites.begin(), pool.sprites.end(), sprite);
+		if (it != pool.sprites.end())
+		{
+			pool.sprites.erase(it);
+			m_numPooledSprites--;
+		}
+	}
+	else
+	{
+		pool.numActive--;
+		m_numActivePooledSprites--;
+	}
+
+	sprite->SetSpritePool(-1, false);
+}
+
+int Toolset2dManager::FindSpritePool(const char *spriteSheetFilename, const char *xmlDataFilename)
+{
+	// Sprites store empty filenames as NULL
+	const char *sheet = (spriteSheetFilename != NULL) ? spriteSheetFilename : "";
+	const char *xml = (xmlDataFilename != NULL) ? xmlDataFilename : "";
+
+	for (int poolIndex = 0; poolIndex < static_cast<int>(m_spritePools.size()); poolIndex++)
+	{
+		const SpritePool &pool = m_spritePools[poolIndex];
+		if (pool.spriteSheetFilename == sheet && pool.xmlDataFilename == xml)
+		{
+			return poolIndex;
+		}
+	}
+
+	SpritePool pool;
+	pool.spriteSheetFilename = sheet;
+	pool.xmlDataFilename = xml;
+	pool.numActive = 0;
+	m_spritePools.push_back(pool);
+
+	return static_cast<int>(m_spritePools.size()) - 1;
+}
+
+void Toolset2dManager::RemoveSpritePools()
+{
+	if (!m_spritePools.empty())
+	{
+		Vision::Error.SystemMessage("Toolset2D: sprite pools had %d hits, %d misses and up to %d sprites in use",
+			m_spritePoolHits, m_spritePoolMisses, m_spritePoolHighWater);
+	}
+
+	// The pooled sprites normally went away with the scene already
+	for (int poolIndex = 0; poolIndex < static_cast<int>(m_spritePools.size()); poolIndex++)
+	{
+		const SpritePool &pool = m_spritePools[poolIndex];
+		for (int spriteIndex = 0; spriteIndex < static_cast<int>(pool.sprites.size()); spriteIndex++)
+		{
+			pool.sprites[spriteIndex]->SetSpritePool(-1, false);
+		}
+	}
+
+	m_spritePools.clear();
+	m_numActivePooledSprites = 0;
+	m_numPooledSprites = 0;
+	m_spritePoolHits = 0;
+	m_spritePoolMisses = 0;
+	m_spritePoolHighWater = 0;
+}
+
+int Toolset2dManager::GetSpritePoolHits() const
+{
+	return m_spritePoolHits;
+}
+
+int Toolset2dManager::GetSpritePoolMisses() const
+{
+	return m_spritePoolMisses;
+}
+
+int Toolset2dManager::GetSpritePoolHighWater() const
+{
+	return m_spritePoolHighWater;
+}
+
+int Toolset2dManager::GetNumPooledSprites() const
+{
+	return m_numPooledSprites;
+}
+
+void Toolset2dManager::SetCamera(Camera2D *camera)
+{
+	m_camera = camera;
+}
+
+Camera2D *Toolset2dManager::GetCamera()
+{
+	return m_camera;
+}
+
+void Toolset2dManager::SetCollisionCellSize(float cellSize)
+{
+	m_broadphase.SetCellSize(cellSize);
+}
+
+float Toolset2dManager::GetCollisionCellSize() const
+{
+	return m_broadphase.GetCellSize();
+}
+
+void Toolset2dManager::SetTextureAtlasEnabled(bool enabled)
+{
+	m_textureAtlasEnabled = enabled;
+
+	if (m_textureAtlasEnabled)
+	{
+		for (int spriteDataIndex = 0; spriteDataIndex < m_spriteData.GetSize() && m_textureAtlasEnabled; spriteDataIndex++)
+		{
+			AddToTextureAtlas(m_spriteData[spriteDataIndex]);
+		}
+	}
+}
+
+bool Toolset2dManager::IsTextureAtlasEnabled() const
+{
+	return m_textureAtlasEnabled;
+}
+
+void Toolset2dManager::SetTextureAtlasPageSize(int pageSize)
+{
+	m_textureAtlasPageSize = pageSize;
+}
+
+int Toolset2dManager::GetTextureAtlasPageSize() const
+{
+	return m_textureAtlasPageSize;
+}
+
+void Toolset2dManager::SetTextureAtlasPadding(int padding)
+{
+	m_textureAtlasPadding = padding;
+}
+
+int Toolset2dManager::GetTextureAtlasPadding() const
+{
+	return m_textureAtlasPadding;
+}
+
+void Toolset2dManager::SetUpdateThreadCount(int threadCount)
+{
+	m_updateThreadCount = hkvMath::Max(threadCount, 0);
+}
+
+int Toolset2dManager::GetUpdateThreadCount() const
+{
+	return m_updateThreadCount;
+}
+
+void Toolset2dManager::SetCollisionStayEventEnabled(bool enabled)
+{
+	m_collisionStayEventEnabled = enabled;
+}
+
+bool Toolset2dManager::IsCollisionStayEventEnabled() const
+{
+	return m_collisionStayEventEnabled;
+}
+
+void Toolset2dManager::SetCollisionEventBatchingEnabled(bool enabled)
+{
+	m_collisionEventBatchingEnabled = enabled;
+}
+
+bool Toolset2dManager::IsCollisionEventBatchingEnabled() const
+{
+	return m_collisionEventBatchingEnabled;
+}
+
+Sprite *Toolset2dManager::GetCollisionContact(int index) const
+{
+	Sprite *sprite = NULL;
+	if (index >= 0 && index < m_numEventContacts)
+	{
+		const SpriteContact &contact = m_spriteContacts[m_eventContactsBegin + index];
+		sprite = GetContactSprite(contact.otherProxy, contact.otherUniqueId);
+	}
+	return sprite;
+}
+
+const char *Toolset2dManager::GetCollisionContactState(int index) const
+{
+	const char *state = "";
+	if (index >= 0 && index < m_numEventContacts)
+	{
+		switch (m_spriteContacts[m_eventContactsBegin + index].state)
+		{
+		case CONTACT_BEGIN:
+			state = "begin";
+			break;
+		case CONTACT_STAY:
+			state = "stay";
+			break;
+		case CONTACT_END:
+			state = "end";
+			break;
+		}
+	}
+	return state;
+}
+
+float Toolset2dManager::GetCollisionContactTime(int index) const
+{
+	float time = 1.0f;
+	if (index >= 0 && index < m_numEventContacts)
+	{
+		time = m_spriteContacts[m_eventContactsBegin + index].time;
+	}
+	return time;
+}
+
+int Toolset2dManager::QueryPoint(float x, float y, unsigned int layerMask)
+{
+	Aabb2D box;
+	box.minX = box.maxX = x;
+	box.minY = box.maxY = y;
+
+	m_queryProxies.clear();
+	m_broadphase.QueryBox(box, layerMask, m_queryProxies);
+
+	m_queryResults.clear();
+	for (size_t i = 0; i < m_queryProxies.size(); i++)
+	{
+		Sprite *sprite = static_cast<Sprite*>( m_broadphase.GetUserData(m_queryProxies[i]) );
+
+		Vertex2D quad[VERTEX_NUM_VERTS];
+		const Vertex2D *vertices;
+		const int numVertices = sprite->GetCollisionPolygon(quad, vertices);
+
+		if (ConvexPolygonPointDistance2D(vertices, numVertices, x, y) == 0.f)
+		{
+			AddQueryResult(m_queryProxies[i], sprite, 0.f);
+		}
+	}
+
+	return FinishQuery();
+}
+
+int Toolset2dManager::QueryRect(float minX, float minY, float maxX, float maxY, unsigned int layerMask)
+{
+	Aabb2D box;
+	box.minX = hkvMath::Min(minX, maxX);
+	box.minY = hkvMath::Min(minY, maxY);
+	box.maxX = hkvMath::Max(minX, maxX);
+	box.maxY = hkvMath::Max(minY, maxY);
+
+	const Vertex2D rectangle[4] =
+	{
+		{ box.minX, box.minY },
+		{ box.maxX, box.minY },
+		{ box.maxX, box.maxY },
+		{ box.minX, box.maxY }
+	};
+
+	const float centerX = (box.minX + box.maxX) * 0.5f;
+	const float centerY = (box.minY + box.maxY) * 0.5f;
+
+	m_queryProxies.clear();
+	m_broadphase.QueryBox(box, layerMask, m_queryProxies);
+
+	m_queryResults.clear();
+	for (size_t i = 0; i < m_queryProxies.size(); i++)
+	{
+		Sprite *sprite = static_cast<Sprite*>( m_broadphase.GetUserData(m_queryProxies[i]) );
+
+		Vertex2D quad[VERTEX_NUM_VERTS];
+		const Vertex2D *vertices;
+		const int numVertices = sprite->GetCollisionPolygon(quad, vertices);
+
+		if (ConvexPolygonsOverlap2D(rectangle, 4, vertices, numVertices))
+		{
+			AddQueryResult(m_queryProxies[i], sprite, ConvexPolygonPointDistance2D(vertices, numVertices, centerX, centerY));
+		}
+	}
+
+	return FinishQuery();
+}
+
+int Toolset2dManager::QueryRadius(float x, float y, float radius, unsigned int layerMask)
+{
+	radius = hkvMath::Max(radius, 0.f);
+
+	Aabb2D box;
+	box.minX = x - radius;
+	box.minY = y - radius;
+	box.maxX = x + radius;
+	box.maxY = y + radius;
+
+	m_queryProxies.clear();
+	m_broadphase.QueryBox(box, layerMask, m_queryProxies);
+
+	m_queryResults.clear();
+	for (size_t i = 0; i < m_queryProxies.size(); i++)
+	{
+		Sprite *sprite = static_cast<Sprite*>( m_broadphase.GetUserData(m_queryProxies[i]) );
+
+		Vertex2D quad[VERTEX_NUM_VERTS];
+		const Vertex2D *vertices;
+		const int numVertices = sprite->GetCollisionPolygon(quad, vertices);
+
+		const float distance = ConvexPolygonPointDistance2D(vertices, numVertices, x, y);
+		if (distance <= radius)
+		{
+			AddQueryResult(m_queryProxies[i], sprite, distance);
+		}
+	}
+
+	return FinishQuery();
+}
+
+int Toolset2dManager::Raycast(float startX, float startY, float endX, float endY, unsigned int layerMask)
+{
+	const float length = hkvVec2(endX - startX, endY - startY).getLength();
+
+	m_queryProxies.clear();
+	m_broadphase.QuerySegment(startX, startY, endX, endY, layerMask, m_queryProxies);
+
+	m_queryResults.clear();
+	for (size_t i = 0; i < m_queryProxies.size(); i++)
+	{
+		Sprite *sprite = static_cast<Sprite*>( m_broadphase.GetUserData(m_queryProxies[i]) );
+
+		Vertex2D quad[VERTEX_NUM_VERTS];
+		const Vertex2D *vertices;
+		const int numVertices = sprite->GetCollisionPolygon(quad, vertices);
+
+		float fraction;
+		if (RaycastConvexPolygon2D(vertices, numVertices, startX, startY, endX, endY, fraction))
+		{
+			AddQueryResult(m_queryProxies[i], sprite, fraction * length);
+		}
+	}
+
+	return FinishQuery();
+}
+
+int Toolset2dManager::GetNumQueryResults() const
+{
+	return static_cast<int>(m_queryResults.size());
+}
+
+Sprite *Toolset2dManager::GetQueryResult(int index) const
+{
+	// Scripts may have removed sprites since the query
+	Sprite *sprite = NULL;
+	if (index >= 0 && index < static_cast<int>(m_queryResults.size()))
+	{
+		sprite = GetContactSprite(m_queryResults[index].proxy, m_queryResults[index].uniqueId);
+	}
+	return sprite;
+}
+
+float Toolset2dManager::GetQueryDistance(int index) const
+{
+	float distance = 0.f;
+	if (index >= 0 && index < static_cast<int>(m_queryResults.size()))
+	{
+		distance = m_queryResults[index].distance;
+	}
+	return distance;
+}
+
+void Toolset2dManager::AddQueryResult(int proxy, Sprite *sprite, float distance)
+{
+	QueryResult result;
+	result.uniqueId = sprite->GetUniqueID();
+	result.proxy = proxy;
+	result.distance = distance;
+	m_queryResults.push_back(result);
+}
+
+int Toolset2dManager::FinishQuery()
+{
+	std::sort(m_queryResults.begin(), m_queryResults.end(), IsQueryResultBefore);
+	return static_cast<int>(m_queryResults.size());
+}
+
+SpriteAnimations2D &Toolset2dManager::GetSpriteAnimations()
+{
+	return m_animations;
+}
+
+std::vector<unsigned long long> &Toolset2dManager::GetAlphaMaskScratch()
+{
+	return m_alphaMaskScratch;
+}
+
+int Toolset2dManager::GetNumRenderBatches() const
+{
+	return m_numRenderBatches;
+}
+
+int Toolset2dManager::GetNumRenderQuads() const
+{
+	return m_numRenderVertices / 6;
+}
+
+int Toolset2dManager::GetNumRenderVertices() const
+{
+	return m_numRenderVertices;
+}
+
+const FrameStats2D &Toolset2dManager::GetStats() const
+{
+	return m_stats;
+}
+
+void Toolset2dManager::SetStatsHistorySize(int historySize)
+{
+	m_stats.SetHistorySize(historySize);
+}
+
+int Toolset2dManager::GetStatsHistorySize() const
+{
+	return m_stats.GetHistorySize();
+}
+
+void Toolset2dManager::SetStatsOverlayEnabled(bool enabled)
+{
+	m_statsOverlayEnabled = enabled;
+}
+
+bool Toolset2dManager::IsStatsOverlayEnabled() const
+{
+	return m_statsOverlayEnabled;
+}
+
+bool Toolset2dManager::StartStatsCsv(const char *filename)
+{
+	StopStatsCsv();
+
+	m_statsCsv = Vision::File.Create(filename);
+	if (m_statsCsv == NULL)
+	{
+		Vision::Error.Warning("Toolset2D: Failed to create stats file '%s'", filename);
+		return false;
+	}
+
+	m_statsCsvLine.clear();
+	FrameStats2D::AppendCsvHeader(m_statsCsvLine);
+	m_statsCsv->Write(m_statsCsvLine.c_str(), m_statsCsvLine.size());
+
+	return true;
+}
+
+void Toolset2dManager::StopStatsCsv()
+{
+	if (m_statsCsv != NULL)
+	{
+		m_statsCsv->Close();
+		m_statsCsv = NULL;
+	}
+}
+
+bool Toolset2dManager::IsWritingStatsCsv() const
+{
+	return (m_statsCsv != NULL);
+}
+
+void Toolset2dManager::EndStatsFrame()
+{
+	if (m_stats.EndFrame() && m_statsCsv != NULL)
+	{
+		m_statsCsvLine.clear();
+		m_stats.AppendCsvLine(0, m_statsCsvLine);
+		m_statsCsv->Write(m_statsCsvLine.c_str(), m_statsCsvLine.size());
+	}
+}
+
+void Toolset2dManager::DrawStatsOverlay()
+{
+	int y = kStatsOverlayY;
+
+	Vision::Message.Print(1, kStatsOverlayX, y, "2D stats, average (max) over %d frames", m_stats.GetNumFrames());
+	y += kStatsOverlayLineHeight;
+
+	for (int timer = 0; timer < NUM_FRAME_TIMERS; timer++)
+	{
+		const FrameTimer2D frameTimer = static_cast<FrameTimer2D>(timer);
+		Vision::Message.Print(1, kStatsOverlayX, y, "%s: %.3f (%.3f)",
+			FrameStats2D::GetTimerName(frameTimer),
+			m_stats.GetAverageTime(frameTimer),
+			m_stats.GetMaxTime(frameTimer));
+		y += kStatsOverlayLineHeight;
+	}
+
+	for (int counter = 0; counter < NUM_FRAME_COUNTERS; counter++)
+	{
+		const FrameCounter2D frameCounter = static_cast<FrameCounter2D>(counter);
+		Vision::Message.Print(1, kStatsOverlayX, y, "%s: %.1f",
+			FrameStats2D::GetCounterName(frameCounter),
+			m_stats.GetAverageCount(frameCounter));
+		y += kStatsOverlayLineHeight;
+	}
+}
+
+#if USE_HAVOK_PHYSICS_2D
+hkpWorld *Toolset2dManager::GetPhysicsWorld()
+{
+	return m_world;
+}
+#endif // USE_HAVOK_PHYSICS_2D
+
+//----- functions
+
+bool Toolset2dManager::IsDrawnBefore(const SpriteEntry &entry, const SpriteEntry &otherEntry)
+{
+	if (entry.depth != otherEntry.depth)
+	{
+		return (entry.depth < otherEntry.depth);
+	}
+
+	// Keep sprites at the same depth in a fixed order. Compare instead of subtracting since
+	// the difference of two 64-bit IDs doesn't fit in an int.
+	return (entry.uniqueId > otherEntry.uniqueId);
+}
+
+bool Toolset2dManager::IsContactOrderedBefore(const SpriteContact &contact, const SpriteContact &otherContact)
+{
+	return (contact.uniqueId < otherContact.uniqueId);
+}
+
+bool Toolset2dManager::IsQueryResultBefore(const QueryResult &result, const QueryResult &otherResult)
+{
+	if (result.distance != otherResult.distance)
+	{
+		return (result.distance < otherResult.distance);
 	}
 
-	return result;
+	// Sprites at the same distance come back in the same order every time
+	return (result.uniqueId < otherResult.uniqueId);
 }
 
 #if defined(WIN32)
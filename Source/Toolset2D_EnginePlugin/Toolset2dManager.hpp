@@ -6,6 +6,19 @@
 #include <Common/Base/Ext/hkBaseExt.h>
 #endif // defined(WIN32)
 
+#include "Core/SpatialHash2d.hpp"
+#include "Core/AtlasPacker2d.hpp"
+#include "Core/SpriteQuads2d.hpp"
+#include "Core/ContactBuffer2d.hpp"
+#include "Core/SpriteSheetBinary2d.hpp"
+#include "Core/HashIndex2d.hpp"
+#include "Core/Animation2d.hpp"
+#include "Core/SpriteAnimations2d.hpp"
+#include "Core/FrameStats2d.hpp"
+#include "Core/CellName2d.hpp"
+#include "Core/Collision2d.hpp"
+#include "Core/AlphaMask2d.hpp"
+
 class Sprite;
 class Camera2D;
 class VScriptCreateStackProxyObject;
@@ -40,6 +53,19 @@ public:
 	float originalHeight;
 	int index;
 
+	// Seconds the cell is shown in an animation, zero to use the state's framerate. Read
+	// from the optional 'duration' attribute in the XML.
+	float duration;
+
+	// Convex hull the sprite collides with, in cell space with (0, 0) at the center. Baked
+	// into a precompiled sheet by hullbaker.py, otherwise generated from the sheet image the
+	// same way when the sheet is loaded. Empty for cells without any opaque pixels.
+	std::vector<Vertex2D> hullVertices;
+
+	// Opaque pixels of the cell for pixel perfect collision. Only precompiled sheets baked
+	// with 'spritesheetbin.py --masks' have one, empty otherwise.
+	AlphaMask2D alphaMask;
+
 #if USE_HAVOK_PHYSICS_2D
 	hkArray<int> verticesPerFace;
 	hkArray<int> vertexIndices;
@@ -53,9 +79,28 @@ public:
 class SpriteState
 {
 public:
+	SpriteState();
+
+	// Works out the frame times below from the framerate and the cells' own durations
+	void UpdateFrameTimes(const VArray<SpriteCell> &allCells);
+	AnimationTimeline2D GetTimeline() const;
+
 	VString name;
 	VArray<int> cells;
 	float framerate;
+
+	// Time within one loop at which each frame ends. The frame duration is only set if all
+	// frames are shown equally long.
+	VArray<float> frameEndTimes;
+	float frameDuration;
+	float loopDuration;
+};
+
+enum SpriteDataState
+{
+	SPRITE_DATA_LOADING,
+	SPRITE_DATA_LOADED,
+	SPRITE_DATA_FAILED
 };
 
 class SpriteData
@@ -66,7 +111,20 @@ public:
 
 	void Cleanup();
 
+	bool IsLoaded() const;
+
+	// Fill in the cells and states from a precompiled sheet or from the XML written by
+	// ShoeBox. Both return false if the file doesn't exist or can't be read. Neither of
+	// them touches the engine's texture or physics state, so they can run on any thread.
+	bool LoadBinary(const char *binaryFilename);
+	bool LoadXml(const char *xmlFilename);
+
+	// Prefers the precompiled sheet and falls back to the XML
+	bool LoadDescription();
+
+	// Fills in the hulls missing from the sheet where possible, then builds the Havok shapes
 	bool GenerateConvexHull();
+	void UpdateFrameTimes();
 
 	//-----
 
@@ -76,13 +134,33 @@ public:
 	VString spriteSheetFilename;
 	VString xmlDataFilename;
 
+	// Key of the manager's cache and the number of sprites using this data
+	unsigned int hash;
+	int refCount;
+
+	// While loading in the background the cells and states are being written on a worker
+	// thread, so nothing but the state may be read until the data is loaded
+	SpriteDataState loadState;
+
+	// Set by LoadBinary when the precompiled sheet is broken, reported on the main thread
+	bool invalidBinary;
+
 	VArray<SpriteCell> cells;
 	VArray<SpriteState> states;
 
 	VTextureObject *spriteSheetTexture;
 	VisTextureAnimInstance_cl *textureAnimation;
 
+	// Set when the texture has also been packed into one of the manager's atlas pages. The
+	// page is owned by the manager and coordinates map to 'offset + uv * scale' on it.
+	VTextureObject *atlasTexture;
+	hkvVec2 atlasUvOffset;
+	hkvVec2 atlasUvScale;
+
 	VDictionary<int> stateNameToIndex;
+
+private:
+	void GenerateHullsFromImage();
 };
 
 #if defined(WIN32)
@@ -90,6 +168,21 @@ public:
 TOOLSET_2D_IMPEXP bool convertToAssetPath(const char* absolutePath, hkStringBuf& out_relativePath);
 #endif // defined(WIN32)
 
+// Sent with Toolset2dManager::OnSpriteSheetLoaded, the data is still there if loading failed
+class SpriteSheetLoadedDataObject : public IVisCallbackDataObject_cl
+{
+public:
+	SpriteSheetLoadedDataObject(VisCallback_cl *pSender, const SpriteData *spriteData, bool success)
+		: IVisCallbackDataObject_cl(pSender)
+	{
+		m_spriteData = spriteData;
+		m_success = success;
+	}
+
+	const SpriteData *m_spriteData;
+	bool m_success;
+};
+
 class Toolset2dManager
 : public IVisCallbackHandler_cl
 #if USE_HAVOK_PHYSICS_2D
@@ -103,11 +196,27 @@ public:
 	TOOLSET_2D_IMPEXP void OneTimeInit();
 	TOOLSET_2D_IMPEXP void OneTimeDeInit();
 	
+	// Sprites remember their slot in the sprite list, so all of these take constant time
 	TOOLSET_2D_IMPEXP void AddSprite(Sprite *sprite);
 	TOOLSET_2D_IMPEXP int FindSprite(Sprite *sprite);
 	TOOLSET_2D_IMPEXP void RemoveSprite(Sprite *sprite);
 	
+	// Sprite data is shared by all sprites that use the same sheet and looked up by a hash
+	// of both filenames. Sprites hold a reference to their data. Data nobody references
+	// any more stays loaded until EvictUnusedSpriteData is called or the scene is unloaded.
 	TOOLSET_2D_IMPEXP const SpriteData *GetSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename);
+	TOOLSET_2D_IMPEXP void AddSpriteDataReference(const SpriteData *spriteData);
+	TOOLSET_2D_IMPEXP void ReleaseSpriteData(const SpriteData *spriteData);
+
+	// Returns right away with data that may still be loading on a worker thread. It is
+	// published at the start of a later update, the texture itself is loaded on the main
+	// thread at that point. GetSpriteData on data that is still loading waits for it, but
+	// the loaded events are still only sent from the update. Failed loads are dropped once
+	// nobody references them, and the next request tries again.
+	TOOLSET_2D_IMPEXP const SpriteData *RequestSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename);
+
+	// Triggered on the main thread for every sheet that was loaded in the background
+	TOOLSET_2D_IMPEXP static VisCallback_cl OnSpriteSheetLoaded;
 
 	TOOLSET_2D_IMPEXP void Render();
 	TOOLSET_2D_IMPEXP void Update(float deltaTime);
@@ -128,14 +237,138 @@ public:
 		return &spriteManager;
 	}
 
+	// Precompiled sheets live next to the XML with a .sheet extension
+	static VString GetSpriteSheetBinaryFilename(const VString &xmlDataFilename);
+
+	// The sheets used by a scene are listed in a manifest next to it, written by
+	// Source/BuildSystem/spritemanifest.py. Scenes/Shooter.pcdx9.vscene uses
+	// Scenes/Shooter.spritesheets.xml.
+	static VString GetSpriteSheetManifestFilename(const VString &sceneFilename);
+
 	//----- Script functions
 
 	TOOLSET_2D_IMPEXP static Sprite *CreateSprite(const hkvVec3 &position, const char *spriteSheetFilename, const char *xmlDataFilename = "");
 	TOOLSET_2D_IMPEXP int GetNumSprites();
 
+	// Released sprites wait in a pool per sprite sheet and XML until AcquireSprite hands
+	// them out again reset to their defaults, which is a lot cheaper than creating a new
+	// entity. Pooled sprites keep their components, but their scripts neither think nor
+	// get sprite events until the sprite is acquired again, and they lose their rigid
+	// bodies. Any sprite can be released, not only acquired ones. Pools are emptied with
+	// the scene.
+	TOOLSET_2D_IMPEXP Sprite *AcquireSprite(const hkvVec3 &position, const char *spriteSheetFilename, const char *xmlDataFilename = "");
+	TOOLSET_2D_IMPEXP void ReleaseSprite(Sprite *sprite);
+	TOOLSET_2D_IMPEXP void PrewarmSpritePool(const char *spriteSheetFilename, const char *xmlDataFilename, int count);
+	TOOLSET_2D_IMPEXP void RemoveFromSpritePool(Sprite *sprite);
+
+	// Acquires served from a pool and ones that had to create a sprite, the most pooled
+	// sprites in use at the same time and the number waiting right now
+	TOOLSET_2D_IMPEXP int GetSpritePoolHits() const;
+	TOOLSET_2D_IMPEXP int GetSpritePoolMisses() const;
+	TOOLSET_2D_IMPEXP int GetSpritePoolHighWater() const;
+	TOOLSET_2D_IMPEXP int GetNumPooledSprites() const;
+
+	// Frees the sprite sheets that no sprite uses and returns how many were freed. Space
+	// they took up in the texture atlas is only reclaimed with the scene.
+	TOOLSET_2D_IMPEXP int EvictUnusedSpriteData();
+	TOOLSET_2D_IMPEXP int GetNumSpriteSheets() const;
+
+	// With asynchronous loading sprites are created right away and only show up once their
+	// sprite sheet has been loaded in the background. PreloadSpriteSheet starts loading a
+	// sheet without a sprite. Every sheet loaded in the background calls
+	// OnSpriteSheetLoaded(spriteSheetFilename, xmlDataFilename, success) on the scene script.
+	TOOLSET_2D_IMPEXP void SetAsyncLoadingEnabled(bool enabled);
+	TOOLSET_2D_IMPEXP bool IsAsyncLoadingEnabled() const;
+	TOOLSET_2D_IMPEXP bool PreloadSpriteSheet(const char *spriteSheetFilename, const char *xmlDataFilename);
+	TOOLSET_2D_IMPEXP bool IsSpriteSheetLoaded(const char *spriteSheetFilename, const char *xmlDataFilename);
+	TOOLSET_2D_IMPEXP int GetNumPendingSpriteSheets() const;
+
+	// The scene's manifest is loaded in the background as soon as the scene starts loading.
+	// Scripts can add their own sheets with PreloadSpriteSheet or another manifest. Progress
+	// covers every sheet loaded in the background since the scene started loading, and the
+	// time to the first frame drawn once all of them are in is logged.
+	TOOLSET_2D_IMPEXP int LoadSpriteSheetManifest(const char *manifestFilename);
+	TOOLSET_2D_IMPEXP float GetSpriteSheetLoadProgress() const;
+	TOOLSET_2D_IMPEXP float GetTimeToFirstFrame() const;
+
 	TOOLSET_2D_IMPEXP void SetCamera(Camera2D *camera);
 	TOOLSET_2D_IMPEXP Camera2D *GetCamera();
 
+	// Size (in pixels) of the grid cells used by the collision broadphase
+	TOOLSET_2D_IMPEXP void SetCollisionCellSize(float cellSize);
+	TOOLSET_2D_IMPEXP float GetCollisionCellSize() const;
+
+	// Small standalone textures (no XML data and no animation) can be packed into shared
+	// atlas pages so that sprites using different images still end up in the same batch.
+	// Enabling it also packs the textures that are already loaded. Page size and padding
+	// changes apply once the current pages have been released with the scene.
+	TOOLSET_2D_IMPEXP void SetTextureAtlasEnabled(bool enabled);
+	TOOLSET_2D_IMPEXP bool IsTextureAtlasEnabled() const;
+	TOOLSET_2D_IMPEXP void SetTextureAtlasPageSize(int pageSize);
+	TOOLSET_2D_IMPEXP int GetTextureAtlasPageSize() const;
+	TOOLSET_2D_IMPEXP void SetTextureAtlasPadding(int padding);
+	TOOLSET_2D_IMPEXP int GetTextureAtlasPadding() const;
+
+	// Collision events are sent once all pairs have been tested. OnSpriteCollision is sent
+	// when two sprites start overlapping and OnSpriteCollisionEnd when they separate.
+	// OnSpriteCollisionStay is only sent every frame in between if enabled.
+	TOOLSET_2D_IMPEXP void SetCollisionStayEventEnabled(bool enabled);
+	TOOLSET_2D_IMPEXP bool IsCollisionStayEventEnabled() const;
+
+	// With batching every sprite gets a single OnSpriteCollisions(count) call per frame
+	// instead, and reads its contacts with GetCollisionContact during that call. The state
+	// is one of "begin", "stay" or "end", the time is the contact time passed along with
+	// OnSpriteCollision (see Sprite::IsOverlappingSwept).
+	TOOLSET_2D_IMPEXP void SetCollisionEventBatchingEnabled(bool enabled);
+	TOOLSET_2D_IMPEXP bool IsCollisionEventBatchingEnabled() const;
+	TOOLSET_2D_IMPEXP Sprite *GetCollisionContact(int index) const;
+	TOOLSET_2D_IMPEXP const char *GetCollisionContactState(int index) const;
+	TOOLSET_2D_IMPEXP float GetCollisionContactTime(int index) const;
+
+	// Spatial queries against the sprites in the collision broadphase whose collision layer
+	// shares a bit with 'layerMask'. They test the hulls or quads as placed by the last
+	// update, pixel masks aren't looked at. Each returns the number of sprites found, read
+	// back with GetQueryResult until the next query, nearest first: by the distance from
+	// the point or the center of the rectangle or circle to the sprite's outline (zero if
+	// it is inside), and for a raycast by the distance along the ray to the sprite. The
+	// buffers are reused, so a query only allocates if it finds more than any before it.
+	TOOLSET_2D_IMPEXP int QueryPoint(float x, float y, unsigned int layerMask);
+	TOOLSET_2D_IMPEXP int QueryRect(float minX, float minY, float maxX, float maxY, unsigned int layerMask);
+	TOOLSET_2D_IMPEXP int QueryRadius(float x, float y, float radius, unsigned int layerMask);
+	TOOLSET_2D_IMPEXP int Raycast(float startX, float startY, float endX, float endY, unsigned int layerMask);
+	TOOLSET_2D_IMPEXP int GetNumQueryResults() const;
+	TOOLSET_2D_IMPEXP Sprite *GetQueryResult(int index) const;
+	TOOLSET_2D_IMPEXP float GetQueryDistance(int index) const;
+
+	// Sprites are updated in chunks on the engine's worker threads. Zero uses all of them,
+	// one updates every sprite on the main thread in order.
+	TOOLSET_2D_IMPEXP void SetUpdateThreadCount(int threadCount);
+	TOOLSET_2D_IMPEXP int GetUpdateThreadCount() const;
+
+	// Frame, frame time and scroll offset of every sprite, advanced in one pass by Update
+	// while the game is running
+	TOOLSET_2D_IMPEXP SpriteAnimations2D &GetSpriteAnimations();
+
+	// Row buffer shared by the pixel collision tests, which all run on the main thread
+	TOOLSET_2D_IMPEXP std::vector<unsigned long long> &GetAlphaMaskScratch();
+
+	// Render statistics from the last frame
+	TOOLSET_2D_IMPEXP int GetNumRenderBatches() const;
+	TOOLSET_2D_IMPEXP int GetNumRenderQuads() const;
+	TOOLSET_2D_IMPEXP int GetNumRenderVertices() const;
+
+	// Time spent in each part of the update and render and what was done there, for the
+	// last frames. Scripts get the averages and maximums from GetStats(). The overlay
+	// prints the same on screen and the CSV file gets one line per frame until stopped.
+	TOOLSET_2D_IMPEXP const FrameStats2D &GetStats() const;
+	TOOLSET_2D_IMPEXP void SetStatsHistorySize(int numFrames);
+	TOOLSET_2D_IMPEXP int GetStatsHistorySize() const;
+	TOOLSET_2D_IMPEXP void SetStatsOverlayEnabled(bool enabled);
+	TOOLSET_2D_IMPEXP bool IsStatsOverlayEnabled() const;
+	TOOLSET_2D_IMPEXP bool StartStatsCsv(const char *filename);
+	TOOLSET_2D_IMPEXP void StopStatsCsv();
+	TOOLSET_2D_IMPEXP bool IsWritingStatsCsv() const;
+
 #if USE_HAVOK_PHYSICS_2D
 	TOOLSET_2D_IMPEXP hkpWorld *GetPhysicsWorld();
 #endif
@@ -147,11 +380,109 @@ protected:
 	void UnintializeHavokPhysics();
 
 	void RemoveSpriteData();
+	int FindSpriteData(const SpriteData *spriteData) const;
+	int FindSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename, unsigned int hash) const;
+	void RemoveSpriteDataAt(int spriteDataIndex);
+
+	SpriteData *CreateSpriteData(const VString &spriteSheetFilename, const VString &xmlDataFilename, unsigned int hash);
+	bool FinishSpriteData(SpriteData *spriteData, bool described);
+
+	void BeginSceneLoad(const char *sceneFilename);
+	void EndSceneLoad();
+
+	void PublishSpriteData(bool wait);
+	void PublishSpriteData(SpriteData *spriteData);
+	void SendSpriteSheetLoadedEvents();
+	void CancelSpriteDataLoads();
+
+	void CompactSprites();
+
+	int FindSpritePool(const char *spriteSheetFilename, const char *xmlDataFilename);
+	void RemoveSpritePools();
+
+	void UpdateAnimations(float deltaTime);
+	void UpdateSprites(const hkvAlignedBBox *viewportBoundingBox);
+	void UpdateSpriteRange(int begin, int end, const hkvAlignedBBox *viewportBoundingBox);
+
+	void UpdateCollisions();
+	void UpdateBroadphase(Sprite *sprite);
+	void RemoveFromBroadphase(Sprite *sprite);
+
+	void DispatchCollisionEvents();
+	void DispatchBatchedCollisionEvents();
+	Sprite *GetContactSprite(int proxy, __int64 uniqueId) const;
+
+	void AddQueryResult(int proxy, Sprite *sprite, float distance);
+	int FinishQuery();
+
+	bool AddToTextureAtlas(SpriteData *spriteData);
+	void RemoveTextureAtlas();
+
+	void FlushRenderBatch(IVRender2DInterface *pRender, VTextureObject *texture, VSimpleRenderState_t &state);
+
+	void SortSprites();
+
+	void EndStatsFrame();
+	void DrawStatsOverlay();
 
 private:
-	// Hold weak pointers so that if they get removed in some unexpected way we don't
-	// have a dead pointer hanging around
-	VArray< VWeakPtr<VisBaseEntity_cl>* > m_sprites;
+	class UpdateTask;
+	class LoadTask;
+
+	// One side of a contact as seen by the sprite that gets the batched event
+	struct SpriteContact
+	{
+		__int64 uniqueId;
+		int proxy;
+		__int64 otherUniqueId;
+		int otherProxy;
+		ContactState2D state;
+		float time;
+	};
+
+	static bool IsContactOrderedBefore(const SpriteContact &contact, const SpriteContact &otherContact);
+
+	struct QueryResult
+	{
+		__int64 uniqueId;
+		int proxy;
+		float distance;
+	};
+
+	static bool IsQueryResultBefore(const QueryResult &result, const QueryResult &otherResult);
+
+	struct SpriteEntry
+	{
+		// Sprites always unregister themselves when they are de-initialized. NULL once
+		// removed until the list is compacted.
+		Sprite *sprite;
+
+		// Cached sort key so sorting never has to touch the sprites themselves
+		float depth;
+		__int64 uniqueId;
+
+		// Where the sprite's quad was stored during the last update, -1 if it has none
+		int quadIndex;
+	};
+
+	static bool IsDrawnBefore(const SpriteEntry &entry, const SpriteEntry &otherEntry);
+
+	struct SpritePool
+	{
+		VString spriteSheetFilename;
+		VString xmlDataFilename;
+
+		// Released sprites ready to be handed out again
+		std::vector<Sprite*> sprites;
+		int numActive;
+	};
+
+	// Kept sorted by depth and only re-sorted when sprites are added or moved along Z.
+	// Removed sprites leave a hole that is closed at the start of the next update, which
+	// keeps the order without having to sort again.
+	std::vector<SpriteEntry> m_sprites;
+	int m_numRemovedSprites;
+	int m_numDepthChanges;
 
 	Camera2D *m_camera;
 
@@ -166,6 +497,79 @@ private:
 	// We store the sprite data in the manager since sprites will most likely share
 	// the same data and we don't want to re-parse the same information multiple times
 	VArray<SpriteData*> m_spriteData;
+	HashIndex2D m_spriteDataIndex;
+
+	// Sprite data being loaded on worker threads, in the order it was requested
+	bool m_asyncLoadingEnabled;
+	VArray<LoadTask*> m_loadTasks;
+
+	// Data published since the last update that OnSpriteSheetLoaded hasn't been sent for,
+	// each entry holds a reference
+	VArray<SpriteData*> m_publishedSpriteData;
+
+	// Loads started since the scene started loading and when that was, zero once the first
+	// frame has been drawn
+	VString m_sceneFilename;
+	int m_numBackgroundLoads;
+	uint64 m_sceneLoadStartTime;
+	float m_timeToFirstFrame;
+
+	std::vector<SpritePool> m_spritePools;
+	int m_numActivePooledSprites;
+	int m_numPooledSprites;
+	int m_spritePoolHits;
+	int m_spritePoolMisses;
+	int m_spritePoolHighWater;
+
+	bool m_textureAtlasEnabled;
+	int m_textureAtlasPageSize;
+	int m_textureAtlasPadding;
+	AtlasPacker2D m_atlasPacker;
+	VArray<VTextureObject*> m_atlasPages;
+
+	// Only sprites that share a cell in the broadphase are tested for overlaps
+	SpatialHash2D m_broadphase;
+	std::vector<SpatialHash2D::Pair> m_broadphasePairs;
+	std::vector<unsigned long long> m_alphaMaskScratch;
+
+	ContactBuffer2D m_contacts;
+	bool m_collisionStayEventEnabled;
+	bool m_collisionEventBatchingEnabled;
+
+	// Contacts of the sprite whose batched event is being sent right now
+	std::vector<SpriteContact> m_spriteContacts;
+	int m_eventContactsBegin;
+	int m_numEventContacts;
+
+	// Proxies handed back by the broadphase and the sprites that passed the exact test of
+	// the last spatial query, both only ever cleared
+	std::vector<int> m_queryProxies;
+	std::vector<QueryResult> m_queryResults;
+
+	// Quads of all sprites, filled in during the update so all corners are computed at once
+	SpriteQuads2D m_quads;
+
+	// Animations of all sprites, but only the ones of registered sprites are enabled
+	SpriteAnimations2D m_animations;
+	std::vector<AnimationEvent2D> m_animationEvents;
+
+	// Live sprites in the same order as m_sprites, gathered on the main thread once the
+	// list has been compacted so the update tasks only read a plain array
+	std::vector<Sprite*> m_updateSprites;
+
+	int m_updateThreadCount;
+	VArray<UpdateTask*> m_updateTasks;
+
+	// Quads of consecutive sprites that share a texture, submitted with a single draw call
+	std::vector<QuadVertex2D> m_batchVertices;
+
+	int m_numRenderBatches;
+	int m_numRenderVertices;
+
+	FrameStats2D m_stats;
+	bool m_statsOverlayEnabled;
+	IVFileOutStream *m_statsCsv;
+	std::string m_statsCsvLine;
 };
 
 #endif // SPRITE_MANAGER_HPP_INCLUDED
\ No newline at end of file
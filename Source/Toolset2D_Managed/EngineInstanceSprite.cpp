@@ -519,6 +519,78 @@ namespace Toolset2D_Managed
 		return colliding;
 	}
 
+	void EngineInstanceSprite::SetPixelCollision(bool enabled)
+	{
+		if (GetSpriteEntity() != NULL)
+		{
+			GetSpriteEntity()->SetPixelCollision(enabled);
+		}
+	}
+
+	bool EngineInstanceSprite::IsPixelCollision()
+	{
+		bool colliding = false;
+		if (GetSpriteEntity() != NULL)
+		{
+			colliding = GetSpriteEntity()->IsPixelCollision();
+		}
+		return colliding;
+	}
+
+	void EngineInstanceSprite::SetContinuousCollision(bool enabled)
+	{
+		if (GetSpriteEntity() != NULL)
+		{
+			GetSpriteEntity()->SetContinuousCollision(enabled);
+		}
+	}
+
+	bool EngineInstanceSprite::IsContinuousCollision()
+	{
+		bool colliding = false;
+		if (GetSpriteEntity() != NULL)
+		{
+			colliding = GetSpriteEntity()->IsContinuousCollision();
+		}
+		return colliding;
+	}
+
+	void EngineInstanceSprite::SetCollisionLayer(unsigned int layer)
+	{
+		if (GetSpriteEntity() != NULL)
+		{
+			GetSpriteEntity()->SetCollisionLayer(layer);
+		}
+	}
+
+	unsigned int EngineInstanceSprite::GetCollisionLayer()
+	{
+		unsigned int layer = 1;
+		if (GetSpriteEntity() != NULL)
+		{
+			layer = GetSpriteEntity()->GetCollisionLayer();
+		}
+		return layer;
+	}
+
+	void EngineInstanceSprite::SetCollisionMask(unsigned int mask)
+	{
+		if (GetSpriteEntity() != NULL)
+		{
+			GetSpriteEntity()->SetCollisionMask(mask);
+		}
+	}
+
+	unsigned int EngineInstanceSprite::GetCollisionMask()
+	{
+		unsigned int mask = 0xFFFFFFFF;
+		if (GetSpriteEntity() != NULL)
+		{
+			mask = GetSpriteEntity()->GetCollisionMask();
+		}
+		return mask;
+	}
+
 	void EngineInstanceSprite::SetSimulate(bool simulate, bool fixed)
 	{
 		if (GetSpriteEntity() != NULL)
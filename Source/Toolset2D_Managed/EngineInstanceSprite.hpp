@@ -85,6 +85,17 @@ namespace Toolset2D_Managed
 		void SetConvexHullCollision(bool enabled);
 		bool IsConvexHullCollision();
 
+		void SetPixelCollision(bool enabled);
+		bool IsPixelCollision();
+
+		void SetContinuousCollision(bool enabled);
+		bool IsContinuousCollision();
+
+		void SetCollisionLayer(unsigned int layer);
+		unsigned int GetCollisionLayer();
+		void SetCollisionMask(unsigned int mask);
+		unsigned int GetCollisionMask();
+
 		void SetSimulate(bool simulate, bool fixed);
 		bool IsSimulated();
 		bool IsFixed();